@@ -109,10 +109,17 @@ protected:
   //  @return the index of the found bucket
   unsigned int lookUpBucketFor(const key_type& pKey);
 
+  /// lookUpBucketFor - search the index of bucket whose key is pKey, and
+  //  pFullHash is the hash value of pKey computed by hash().
+  unsigned int lookUpBucketFor(const key_type& pKey, unsigned int pFullHash);
+
   /// findKey - finds an element with key pKey
   //  return the index of the element, or -1 when the element does not exist.
   int findKey(const key_type& pKey) const;
 
+  /// findKey - finds an element with key pKey, whose hash value is pFullHash
+  int findKey(const key_type& pKey, unsigned int pFullHash) const;
+
   /// mayRehash - check the load_factor, compute the new size, and then doRehash
   void mayRehash();
 
@@ -127,13 +127,23 @@ template<typename HashEntryTy,
 unsigned int
 HashTableImpl<HashEntryTy, HashFunctionTy>::lookUpBucketFor(
   const typename HashTableImpl<HashEntryTy, HashFunctionTy>::key_type& pKey)
+{
+  return lookUpBucketFor(pKey, m_Hasher(pKey));
+}
+
+template<typename HashEntryTy,
+         typename HashFunctionTy>
+unsigned int
+HashTableImpl<HashEntryTy, HashFunctionTy>::lookUpBucketFor(
+  const typename HashTableImpl<HashEntryTy, HashFunctionTy>::key_type& pKey,
+  unsigned int pFullHash)
 {
   if (0 == m_NumOfBuckets) {
     // NumOfBuckets is changed after init(pInitSize)
     init(NumOfInitBuckets);
   }
 
-  unsigned int full_hash = m_Hasher(pKey);
+  unsigned int full_hash = pFullHash;
   unsigned int index = full_hash % m_NumOfBuckets;
 
   const unsigned int probe = 1;
@@ -179,7 +189,20 @@ HashTableImpl<HashEntryTy, HashFunctionTy>::findKey(
   if (0 == m_NumOfBuckets)
     return -1;
 
-  unsigned int full_hash = m_Hasher(pKey);
+  return findKey(pKey, m_Hasher(pKey));
+}
+
+template<typename HashEntryTy,
+         typename HashFunctionTy>
+int
+HashTableImpl<HashEntryTy, HashFunctionTy>::findKey(
+  const typename HashTableImpl<HashEntryTy, HashFunctionTy>::key_type& pKey,
+  unsigned int pFullHash) const
+{
+  if (0 == m_NumOfBuckets)
+    return -1;
+
+  unsigned int full_hash = pFullHash;
   unsigned int index = full_hash % m_NumOfBuckets;
 
   const unsigned int probe = 1;
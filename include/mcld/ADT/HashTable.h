@@ -75,6 +75,12 @@ public:
   //  If the element already exists, return the element, and set pExist true.
   entry_type* insert(const key_type& pKey, bool& pExist);
 
+  /// insert - insert a new element whose key pKey has the hash value
+  //  pFullHash. pFullHash must be the value computed by hash(), so the
+  //  callers which already know the hash value do not compute it again.
+  entry_type* insert(const key_type& pKey, unsigned int pFullHash,
+                     bool& pExist);
+
   /// erase - remove the element with the same key
   size_type erase(const key_type& pKey);
 
@@ -87,6 +93,13 @@ public:
   //  If the element does not exist, return end()
   const_iterator find(const key_type& pKey) const;
 
+  /// find - finds an element with key pKey, whose hash value is pFullHash
+  iterator find(const key_type& pKey, unsigned int pFullHash);
+
+  /// find - finds an element with key pKey, whose hash value is pFullHash,
+  //  constant version
+  const_iterator find(const key_type& pKey, unsigned int pFullHash) const;
+
   size_type count(const key_type& pKey) const;
 
   // -----  hash policy  ----- //
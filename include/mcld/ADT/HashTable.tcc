@@ -65,7 +65,20 @@ HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::insert(
   const typename HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::key_type& pKey,
   bool& pExist)
 {
-  unsigned int index = BaseTy::lookUpBucketFor(pKey);
+  return insert(pKey, BaseTy::hash()(pKey), pExist);
+}
+
+/// insert - insert a new element whose key has the hash value pFullHash.
+template<typename HashEntryTy,
+         typename HashFunctionTy,
+         typename EntryFactoryTy>
+typename HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::entry_type*
+HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::insert(
+  const typename HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::key_type& pKey,
+  unsigned int pFullHash,
+  bool& pExist)
+{
+  unsigned int index = BaseTy::lookUpBucketFor(pKey, pFullHash);
   bucket_type& bucket = BaseTy::m_Buckets[index];
   entry_type* entry = bucket.Entry;
   if (bucket_type::getEmptyBucket() != entry &&
@@ -135,6 +148,34 @@ HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::find(
   return const_iterator(this, index);
 }
 
+template<typename HashEntryTy,
+         typename HashFunctionTy,
+         typename EntryFactoryTy>
+typename HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::iterator
+HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::find(
+  const typename HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::key_type& pKey,
+  unsigned int pFullHash)
+{
+  int index;
+  if (-1 == (index = BaseTy::findKey(pKey, pFullHash)))
+    return end();
+  return iterator(this, index);
+}
+
+template<typename HashEntryTy,
+         typename HashFunctionTy,
+         typename EntryFactoryTy>
+typename HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::const_iterator
+HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::find(
+  const typename HashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::key_type& pKey,
+  unsigned int pFullHash) const
+{
+  int index;
+  if (-1 == (index = BaseTy::findKey(pKey, pFullHash)))
+    return end();
+  return const_iterator(this, index);
+}
+
 template<typename HashEntryTy,
          typename HashFunctionTy,
          typename EntryFactoryTy>
@@ -35,6 +35,7 @@ public:
     Region,
     Target,
     Stub,
+    Merged,
     Null
   };
 
@@ -0,0 +1,73 @@
+//===- MergedFragment.h ---------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_FRAGMENT_MERGEDFRAGMENT_H
+#define MCLD_FRAGMENT_MERGEDFRAGMENT_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+
+#include <mcld/Fragment/Fragment.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
+
+#include <vector>
+
+namespace mcld {
+
+/** \class MergedFragment
+ *  \brief MergedFragment is the content of merged SHF_MERGE sections. It is
+ *  made of the distinct pieces (strings or constants) of the input sections,
+ *  which still refer to the input memory regions.
+ */
+class MergedFragment : public Fragment
+{
+public:
+  struct Piece
+  {
+    llvm::StringRef data; ///< the content in the input
+    uint64_t offset;      ///< the offset in this fragment
+  };
+
+  typedef std::vector<Piece> PieceList;
+  typedef PieceList::const_iterator const_iterator;
+
+public:
+  MergedFragment(SectionData* pSD = NULL);
+
+  ~MergedFragment();
+
+  /// append - place pData at pOffset, which is not less than the end of the
+  /// last piece. The gaps are filled with zeros.
+  void append(llvm::StringRef pData, uint64_t pOffset);
+
+  const_iterator begin() const { return m_Pieces.begin(); }
+  const_iterator end  () const { return m_Pieces.end(); }
+
+  size_t numOfPieces() const { return m_Pieces.size(); }
+
+  /// emit - write out the content to pBuffer of size() bytes
+  void emit(uint8_t* pBuffer) const;
+
+  static bool classof(const Fragment *F)
+  { return F->getKind() == Fragment::Merged; }
+
+  static bool classof(const MergedFragment *)
+  { return true; }
+
+  size_t size() const;
+
+private:
+  PieceList m_Pieces;
+  size_t m_Size;
+};
+
+} // namespace of mcld
+
+#endif
+
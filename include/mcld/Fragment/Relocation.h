@@ -42,8 +42,7 @@ private:
 
   Relocation(Type pType,
              FragmentRef* pTargetRef,
-             Address pAddend,
-             DWord pTargetData);
+             Address pAddend);
 
   ~Relocation();
 
@@ -88,14 +87,12 @@ public:
   const ResolveInfo* symInfo() const { return m_pSymInfo; }
   ResolveInfo*       symInfo()       { return m_pSymInfo; }
 
-  /// target - the target data to relocate
-  const DWord& target() const { return m_TargetData; }
-  DWord&       target()       { return m_TargetData; }
-
   /// targetRef - the reference of the target data
   const FragmentRef& targetRef() const { return m_TargetAddress; }
   FragmentRef&       targetRef()       { return m_TargetAddress; }
 
+  /// apply - apply the relocation to its place in the output file, which is
+  /// set by Relocator::setOutput()
   void apply(Relocator& pRelocator);
 
   /// updateAddend - A relocation with a section symbol must update addend
@@ -113,9 +110,6 @@ private:
   /// m_Type - the type of the relocation entries
   Type m_Type;
 
-  /// m_TargetData - target data of the place being relocated
-  DWord m_TargetData;
-
   /// m_pSymInfo - resolved symbol info of relocation target symbol
   ResolveInfo* m_pSymInfo;
 
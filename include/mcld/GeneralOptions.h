@@ -42,6 +42,21 @@ public:
     Both    = 0x3
   };
 
+  enum BuildIDStyle {
+    NoBuildID,
+    FastBuildID,  // a 64-bit non-cryptographic hash of the output
+    MD5BuildID,
+    SHA1BuildID,
+    UUIDBuildID,  // a random UUID
+    HexBuildID    // the bytes given by --build-id=0xHEX
+  };
+
+  enum ICFMode {
+    ICFNone,
+    ICFAll,
+    ICFSafe       // fold only the sections whose addresses are not taken
+  };
+
   typedef std::vector<std::string> RpathList;
   typedef RpathList::iterator rpath_iterator;
   typedef RpathList::const_iterator const_rpath_iterator;
@@ -287,6 +302,20 @@ public:
   bool GCSections() const
   { return m_bGCSections; }
 
+  // --icf=[none|all|safe]
+  void setICFMode(ICFMode pMode)
+  { m_ICFMode = pMode; }
+
+  ICFMode getICFMode() const
+  { return m_ICFMode; }
+
+  // --tail-merge-strings
+  void setTailMergeStrings(bool pEnable = true)
+  { m_bTailMergeStrings = pEnable; }
+
+  bool tailMergeStrings() const
+  { return m_bTailMergeStrings; }
+
   // --ld-generated-unwind-info
   void setGenUnwindInfo(bool pEnable = true)
   { m_bGenUnwindInfo = pEnable; }
@@ -294,6 +323,13 @@ public:
   bool genUnwindInfo() const
   { return m_bGenUnwindInfo; }
 
+  // --unlink-old-output-in-background
+  void setUnlinkOldOutputInBackground(bool pEnable = true)
+  { m_bUnlinkOldOutputInBackground = pEnable; }
+
+  bool unlinkOldOutputInBackground() const
+  { return m_bUnlinkOldOutputInBackground; }
+
   // -G, max GP size option
   void setGPSize(int gpsize)
   { m_GPSize = gpsize; }
@@ -301,11 +337,32 @@ public:
   int getGPSize() const
   { return m_GPSize; }
 
+  // --threads=N
+  void setNumOfThreads(unsigned int pNum)
+  { m_NumOfThreads = pNum; }
+
+  unsigned int numOfThreads() const
+  { return m_NumOfThreads; }
+
   unsigned int getHashStyle() const { return m_HashStyle; }
 
   void setHashStyle(unsigned int pStyle)
   { m_HashStyle = pStyle; }
 
+  // --build-id[=style]
+  /// setBuildID - set up the build ID by the style given to --build-id,
+  /// which is one of "none", "fast", "md5", "sha1", "uuid" and "0xHEX".
+  /// An empty style means "sha1".
+  /// @return false if pStyle is invalid
+  bool setBuildID(const std::string& pStyle);
+
+  unsigned int getBuildIDStyle() const { return m_BuildIDStyle; }
+
+  bool hasBuildID() const { return (NoBuildID != m_BuildIDStyle); }
+
+  /// getBuildIDValue - the bytes of --build-id=0xHEX
+  const std::string& getBuildIDValue() const { return m_BuildIDValue; }
+
   // -----  link-in rpath  ----- //
   const RpathList& getRpathList() const { return m_RpathList; }
   RpathList&       getRpathList()       { return m_RpathList; }
@@ -393,12 +450,18 @@ private:
   bool m_bPrintMap: 1; // --print-map
   bool m_bWarnMismatch: 1; // --no-warn-mismatch
   bool m_bGCSections: 1; // --gc-sections
+  bool m_bTailMergeStrings: 1; // --tail-merge-strings
   bool m_bGenUnwindInfo: 1; // --ld-generated-unwind-info
+  bool m_bUnlinkOldOutputInBackground: 1; // --unlink-old-output-in-background
   uint32_t m_GPSize; // -G, --gpsize
+  unsigned int m_NumOfThreads; // --threads=N
   StripSymbolMode m_StripSymbols;
+  ICFMode m_ICFMode; // --icf
   RpathList m_RpathList;
   ScriptList m_ScriptList;
   unsigned int m_HashStyle;
+  unsigned int m_BuildIDStyle; // --build-id[=style]
+  std::string m_BuildIDValue;
   std::string m_Filter;
   AuxiliaryList m_AuxiliaryList;
 };
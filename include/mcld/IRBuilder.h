@@ -370,7 +370,8 @@ public:
   ///
   /// @param [in, out] pInput   The input file. Either a relocatable or dynamic
   ///                           object
-  /// @param [in]      pName    The name of the symbol
+  /// @param [in]      pName    The name of the symbol. It is copied into the
+  ///                           symbol, so it may refer to the input directly
   /// @param [in]      pType    What the symbol refers to. May be a object,
   ///                           function, no-type and so on. @see ResolveInfo
   /// @param [in]      pDesc    { Undefined, Define, Common, Indirect }
@@ -388,7 +389,7 @@ public:
   /// @return The added symbol. If the insertion fails due to the resoluction,
   /// return NULL.
   LDSymbol* AddSymbol(Input& pInput,
-                      const std::string& pName,
+                      const llvm::StringRef& pName,
                       ResolveInfo::Type pType,
                       ResolveInfo::Desc pDesc,
                       ResolveInfo::Binding pBind,
@@ -461,7 +462,7 @@ public:
   bool shouldForceLocal(const ResolveInfo& pInfo, const LinkerConfig& pConfig);
 
 private:
-  LDSymbol* addSymbolFromObject(const std::string& pName,
+  LDSymbol* addSymbolFromObject(const llvm::StringRef& pName,
                                 ResolveInfo::Type pType,
                                 ResolveInfo::Desc pDesc,
                                 ResolveInfo::Binding pBinding,
@@ -471,7 +472,7 @@ private:
                                 ResolveInfo::Visibility pVisibility);
 
   LDSymbol* addSymbolFromDynObj(Input& pInput,
-                                const std::string& pName,
+                                const llvm::StringRef& pName,
                                 ResolveInfo::Type pType,
                                 ResolveInfo::Desc pDesc,
                                 ResolveInfo::Binding pBinding,
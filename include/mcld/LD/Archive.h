@@ -112,7 +112,7 @@ public:
     Symbol(const char* pName,
            uint32_t pOffset,
            enum Status pStatus)
-     : name(pName), fileOffset(pOffset), status(pStatus)
+     : name(pName), fileOffset(pOffset), status(pStatus), next(0), hash(0)
     {}
 
     ~Symbol()
@@ -122,10 +122,22 @@ public:
     std::string name;
     uint32_t fileOffset;
     enum Status status;
+    size_t next; ///< next entry of the same name, or itself at the end
+    uint32_t hash; ///< DJB hash of the name, the same as ResolveInfo::hash()
   };
 
   typedef std::vector<Symbol*> SymTabType;
 
+private:
+  typedef HashEntry<const llvm::StringRef,
+                    size_t,
+                    hash::StringCompare<llvm::StringRef> > SymbolIndexEntryType;
+
+public:
+  typedef HashTable<SymbolIndexEntryType,
+                    hash::StringHash<hash::DJB>,
+                    EntryFactory<SymbolIndexEntryType> > SymbolIndexMapType;
+
 public:
   Archive(Input& pInputFile, InputBuilder& pBuilder);
 
@@ -206,9 +218,31 @@ public:
             uint32_t pFileOffset,
             enum Symbol::Status pStatus = Archive::Symbol::Unknown);
 
+  /// findSymbol - find the first symtab entry of the given name
+  /// @return the index of the entry, or numOfSymbols() if there is none
+  size_t findSymbol(const llvm::StringRef& pName) const;
+
+  /// findSymbol - find the first symtab entry of the given name, whose DJB
+  /// hash value is pHash
+  size_t findSymbol(const llvm::StringRef& pName, uint32_t pHash) const;
+
+  /// getNextSymbol - get the next symtab entry of the same name as pSymIdx
+  /// @return the index of the entry, or numOfSymbols() if there is none
+  size_t getNextSymbol(size_t pSymIdx) const;
+
+  /// getUndefCursor - the position in NamePool::undefs() up to which the
+  /// undefined symbols are looked up in this archive
+  size_t getUndefCursor() const;
+
+  /// setUndefCursor - set the position in NamePool::undefs()
+  void setUndefCursor(size_t pCursor);
+
   /// getSymbolName - get the symbol name with the given index
   const std::string& getSymbolName(size_t pSymIdx) const;
 
+  /// getSymbolHash - get the DJB hash value of the symbol name
+  uint32_t getSymbolHash(size_t pSymIdx) const;
+
   /// getObjFileOffset - get the file offset that represent a object file
   uint32_t getObjFileOffset(size_t pSymIdx) const;
 
@@ -249,7 +283,9 @@ private:
   ArchiveMemberMapType m_ArchiveMemberMap;
   SymbolFactory m_SymbolFactory;
   SymTabType m_SymTab;
+  SymbolIndexMapType m_SymbolIndexMap;
   size_t m_SymTabSize;
+  size_t m_UndefCursor;
   std::string m_StrTab;
   InputBuilder& m_Builder;
 };
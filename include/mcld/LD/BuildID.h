@@ -0,0 +1,92 @@
+//===- BuildID.h ----------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_BUILDID_H
+#define MCLD_LD_BUILDID_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+#include <llvm/Support/DataTypes.h>
+#include <string>
+
+namespace mcld {
+
+class LDSection;
+class FileOutputBuffer;
+class ThreadPool;
+
+/** \class BuildID
+ *  \brief BuildID represents .note.gnu.build-id section.
+ *
+ *  .note.gnu.build-id section format
+ *  uint32_t : namesz (4)
+ *  uint32_t : descsz (the size of the build ID)
+ *  uint32_t : type (NT_GNU_BUILD_ID)
+ *  char[4]  : name ("GNU")
+ *  uint8_t[descsz] : the build ID
+ *
+ *  The hashing styles compute a tree hash of the whole output file: the file
+ *  is split into chunks of ChunkSize bytes, the chunks are hashed in parallel,
+ *  and the build ID is the hash of the chunk digests in order. The result
+ *  does not depend on the number of threads. The build ID itself is zero
+ *  while the file is hashed.
+ */
+class BuildID
+{
+public:
+  enum {
+    ChunkSize = 1024 * 1024,
+    MaxDigestSize = 20
+  };
+
+public:
+  /// @param pStyle - GeneralOptions::BuildIDStyle
+  /// @param pValue - the bytes of GeneralOptions::HexBuildID
+  BuildID(LDSection& pSection, unsigned int pStyle, const std::string& pValue);
+
+  ~BuildID();
+
+  /// sizeOutput - size .note.gnu.build-id by the style
+  void sizeOutput();
+
+  /// emitOutput - write out .note.gnu.build-id. This must be called when the
+  /// rest of the output has been written.
+  void emitOutput(FileOutputBuffer& pOutput, ThreadPool& pThreadPool);
+
+  /// digestSize - the size of the build ID
+  size_t digestSize() const;
+
+  /// computeTreeHash - hash pSize bytes at pData into pDigest by a hashing
+  /// style. The chunks are hashed on pThreadPool.
+  static void computeTreeHash(unsigned int pStyle,
+                              const uint8_t* pData,
+                              size_t pSize,
+                              uint8_t* pDigest,
+                              ThreadPool& pThreadPool);
+
+  /// computeHash - hash pSize bytes at pData into pDigest by a hashing style
+  static void computeHash(unsigned int pStyle,
+                          const uint8_t* pData,
+                          size_t pSize,
+                          uint8_t* pDigest);
+
+  /// getHashSize - the digest size of a hashing style
+  static size_t getHashSize(unsigned int pStyle);
+
+private:
+  /// .note.gnu.build-id section
+  LDSection& m_Section;
+
+  unsigned int m_Style;
+  std::string m_Value;
+};
+
+} // namespace of mcld
+
+#endif
+
@@ -13,6 +13,7 @@
 #endif
 #include <string>
 #include <llvm/Support/DataTypes.h>
+#include <llvm/Support/Mutex.h>
 #include <mcld/LD/DiagnosticInfos.h>
 
 namespace mcld {
@@ -33,6 +34,10 @@ class DiagnosticLineInfo;
  *  DiagnosticEngine is a complex class, it is responsible for
  *  - remember the argument string for MsgHandler
  *  - choice the severity of a message by options
+ *
+ *  A message is built in the engine's state between report() and emit(), so
+ *  the engine is locked in the meantime. Threads which report at the same
+ *  time are serialized.
  */
 class DiagnosticEngine
 {
@@ -145,6 +150,7 @@ private:
   bool m_OwnPrinter;
 
   State m_State;
+  llvm::sys::Mutex m_Mutex;
 };
 
 } // namespace of mcld
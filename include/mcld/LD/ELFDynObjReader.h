@@ -25,6 +25,10 @@ class ELFReaderIF;
 /** \class ELFDynObjReader
  *  \brief ELFDynObjReader reads ELF dynamic shared objects.
  *
+ *  The definitions of a shared object which have not been referred to when
+ *  it is read are deferred until their names are inserted into the
+ *  NamePool, unless --export-dynamic is given or the shared object has no
+ *  .gnu.hash.
  */
 class ELFDynObjReader : public DynObjReader
 {
@@ -42,9 +46,17 @@ public:
 
   bool readSymbols(Input& pInput);
 
+private:
+  class LazySymbols;
+  friend class LazySymbols;
+
 private:
   ELFReaderIF *m_pELFReader;
   IRBuilder& m_Builder;
+
+  /// the index of the deferred definitions, or NULL if the symbols are
+  /// read eagerly
+  LazySymbols* m_pLazySymbols;
 };
 
 } // namespace of mcld
@@ -165,6 +165,9 @@ public:
   bool hasNoteABITag() const
   { return (NULL != f_pNoteABITag) && (0 != f_pNoteABITag->size()); }
 
+  bool hasNoteGNUBuildID() const
+  { return (NULL != f_pNoteGNUBuildID) && (0 != f_pNoteGNUBuildID->size()); }
+
   bool hasStab() const
   { return (NULL != f_pStab) && (0 != f_pStab->size()); }
 
@@ -587,6 +590,16 @@ public:
     return *f_pNoteABITag;
   }
 
+  LDSection& getNoteGNUBuildID() {
+    assert(NULL != f_pNoteGNUBuildID);
+    return *f_pNoteGNUBuildID;
+  }
+
+  const LDSection& getNoteGNUBuildID() const {
+    assert(NULL != f_pNoteGNUBuildID);
+    return *f_pNoteGNUBuildID;
+  }
+
   LDSection& getStab() {
     assert(NULL != f_pStab);
     return *f_pStab;
@@ -694,6 +707,7 @@ protected:
   LDSection* f_pGOTPLT;            // .got.plt
   LDSection* f_pJCR;               // .jcr
   LDSection* f_pNoteABITag;        // .note.ABI-tag
+  LDSection* f_pNoteGNUBuildID;    // .note.gnu.build-id
   LDSection* f_pStab;              // .stab
   LDSection* f_pStabStr;           // .stabstr
 
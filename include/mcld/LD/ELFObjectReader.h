@@ -51,6 +51,10 @@ public:
   // -----  readers  ----- //
   bool readHeader(Input& pFile);
 
+  bool readSectionData(Input& pFile);
+
+  bool readRawSymbols(Input& pFile);
+
   virtual bool readSections(Input& pFile);
 
   virtual bool readSymbols(Input& pFile);
@@ -60,6 +64,9 @@ public:
   /// This function should be called after symbol resolution.
   virtual bool readRelocations(Input& pFile);
 
+private:
+  struct RawSymbolMap;
+
 private:
   ELFReaderIF* m_pELFReader;
   EhFrameReader* m_pEhFrameReader;
@@ -67,6 +74,7 @@ private:
   ReadFlag m_ReadFlag;
   GNULDBackend& m_Backend;
   const LinkerConfig& m_Config;
+  RawSymbolMap* m_pRawSymbols;
 };
 
 } // namespace of mcld
@@ -14,9 +14,13 @@
 #include <mcld/LD/ObjectWriter.h>
 #include <cassert>
 
+#include <mcld/LD/SectionData.h>
 #include <mcld/Support/FileOutputBuffer.h>
+#include <mcld/Support/ThreadPool.h>
 #include <llvm/Support/system_error.h>
 
+#include <vector>
+
 namespace mcld {
 
 class EhFrame;
@@ -34,6 +38,11 @@ class Output;
  *  \brief ELFObjectWriter writes the target-independent parts of object files.
  *  ELFObjectWriter reads a MCLDFile and writes into raw_ostream
  *
+ *  Every section writes a disjoint range of the output, so the sections are
+ *  written by jobs on a thread pool. A large section is split into ranges of
+ *  fragments, and the symbol tables are written by their own jobs. The
+ *  relocation sections need the symbol indices, so they are written after
+ *  the symbol table which assigns the indices.
  */
 class ELFObjectWriter : public ObjectWriter
 {
@@ -42,13 +51,42 @@ public:
 
   ~ELFObjectWriter();
 
-  llvm::error_code writeObject(Module& pModule, FileOutputBuffer& pOutput);
+  llvm::error_code writeObject(Module& pModule,
+                               FileOutputBuffer& pOutput,
+                               ThreadPool& pThreadPool);
+
+  void writeSection(Module& pModule,
+                    FileOutputBuffer& pOutput, LDSection *section);
 
   size_t getOutputSize(const Module& pModule) const;
 
 private:
-  void writeSection(Module& pModule,
-                    FileOutputBuffer& pOutput, LDSection *section);
+  class SectionJob;
+  class FragmentJob;
+  class NamePoolJob;
+  friend class SectionJob;
+  friend class FragmentJob;
+  friend class NamePoolJob;
+
+  typedef std::vector<LDSection*> SectionList;
+
+  /// the minimal size of a range of fragments written by one job
+  enum { SplitSize = 4 * 1024 * 1024 };
+
+private:
+  /// writeSections - write out pSections on pThreadPool, together with the
+  /// extra jobs in pJobs
+  void writeSections(Module& pModule,
+                     FileOutputBuffer& pOutput,
+                     const SectionList& pSections,
+                     ThreadPool::JobList& pJobs,
+                     ThreadPool& pThreadPool);
+
+  /// splitSection - create the jobs writing the ranges of fragments of
+  /// pSection. Return false if pSection is not split.
+  bool splitSection(const LDSection& pSection,
+                    FileOutputBuffer& pOutput,
+                    ThreadPool::JobList& pJobs) const;
 
   GNULDBackend&       target()        { return m_Backend; }
 
@@ -119,6 +157,12 @@ private:
 
   void emitSectionData(const SectionData& pSD, MemoryRegion& pRegion) const;
 
+  /// emitFragments - emit the fragments [pBegin, pEnd) from the start of
+  /// pRegion
+  void emitFragments(SectionData::const_iterator pBegin,
+                     SectionData::const_iterator pEnd,
+                     MemoryRegion& pRegion) const;
+
 private:
   GNULDBackend& m_Backend;
 
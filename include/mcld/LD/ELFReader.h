@@ -21,6 +21,8 @@
 #include <mcld/LD/LDSymbol.h>
 #include <mcld/Target/GNULDBackend.h>
 
+#include <vector>
+
 namespace mcld {
 
 //class Module;
@@ -81,6 +83,29 @@ public:
                    llvm::StringRef pRegion,
                    const char* StrTab) const;
 
+  /// readSymbols - read the ELF symbols of a DynObj in pIndices
+  bool readSymbols(Input& pInput,
+                   IRBuilder& pBuilder,
+                   llvm::StringRef pRegion,
+                   const char* pStrTab,
+                   const std::vector<size_t>& pIndices) const;
+
+  /// readRawSymbols - decode ELF symbols without creating any symbol
+  void readRawSymbols(llvm::StringRef pRegion,
+                      const char* pStrTab,
+                      RawSymbolTable& pTable) const;
+
+  /// readSymbols - create LDSymbols from the decoded ELF symbols
+  bool readSymbols(Input& pInput,
+                   IRBuilder& pBuilder,
+                   const RawSymbolTable& pTable) const;
+
+  /// readAliasCandidates - collect the potential weak aliases of a DynObj
+  void readAliasCandidates(llvm::StringRef pRegion,
+                           size_t pBegin,
+                           size_t pEnd,
+                           AliasCandidateList& pList) const;
+
   /// readSignature - read a symbol from the given Input and index in symtab
   /// This is used to get the signature of a group section.
   ResolveInfo* readSignature(Input& pInput,
@@ -122,6 +147,22 @@ private:
     return p1.pt_alias->str() < p2.pt_alias->str();
   }
 
+  /// decodeSymbol - decode an ELF symbol to the host endian
+  static void decodeSymbol(const Symbol& pSym,
+                           const char* pStrTab,
+                           RawSymbol& pResult);
+
+  /// readSymbol - create LDSymbol from a decoded ELF symbol. A potential weak
+  /// alias of a DynObj is appended to pAliases.
+  void readSymbol(Input& pInput,
+                  IRBuilder& pBuilder,
+                  const RawSymbol& pSym,
+                  std::vector<AliasInfo>& pAliases) const;
+
+  /// analyzeAliases - link the weak symbols of a DynObj and their aliases
+  static void analyzeAliases(IRBuilder& pBuilder,
+                             std::vector<AliasInfo>& pAliases);
+
 };
 
 
@@ -171,6 +212,29 @@ public:
                    llvm::StringRef pRegion,
                    const char* StrTab) const;
 
+  /// readSymbols - read the ELF symbols of a DynObj in pIndices
+  bool readSymbols(Input& pInput,
+                   IRBuilder& pBuilder,
+                   llvm::StringRef pRegion,
+                   const char* pStrTab,
+                   const std::vector<size_t>& pIndices) const;
+
+  /// readRawSymbols - decode ELF symbols without creating any symbol
+  void readRawSymbols(llvm::StringRef pRegion,
+                      const char* pStrTab,
+                      RawSymbolTable& pTable) const;
+
+  /// readSymbols - create LDSymbols from the decoded ELF symbols
+  bool readSymbols(Input& pInput,
+                   IRBuilder& pBuilder,
+                   const RawSymbolTable& pTable) const;
+
+  /// readAliasCandidates - collect the potential weak aliases of a DynObj
+  void readAliasCandidates(llvm::StringRef pRegion,
+                           size_t pBegin,
+                           size_t pEnd,
+                           AliasCandidateList& pList) const;
+
   /// readSignature - read a symbol from the given Input and index in symtab
   /// This is used to get the signature of a group section.
   ResolveInfo* readSignature(Input& pInput,
@@ -212,6 +276,22 @@ private:
     return p1.pt_alias->str() < p2.pt_alias->str();
   }
 
+  /// decodeSymbol - decode an ELF symbol to the host endian
+  static void decodeSymbol(const Symbol& pSym,
+                           const char* pStrTab,
+                           RawSymbol& pResult);
+
+  /// readSymbol - create LDSymbol from a decoded ELF symbol. A potential weak
+  /// alias of a DynObj is appended to pAliases.
+  void readSymbol(Input& pInput,
+                  IRBuilder& pBuilder,
+                  const RawSymbol& pSym,
+                  std::vector<AliasInfo>& pAliases) const;
+
+  /// analyzeAliases - link the weak symbols of a DynObj and their aliases
+  static void analyzeAliases(IRBuilder& pBuilder,
+                             std::vector<AliasInfo>& pAliases);
+
 };
 
 } // namespace of mcld
@@ -22,6 +22,9 @@
 #include <mcld/Target/GNULDBackend.h>
 #include <mcld/Support/MsgHandling.h>
 
+#include <utility>
+#include <vector>
+
 namespace mcld {
 
 class Module;
@@ -35,6 +38,24 @@ class LDSection;
  */
 class ELFReaderIF
 {
+public:
+  /// AliasCandidateList - the <st_value, index> of the potential weak aliases
+  typedef std::vector<std::pair<uint64_t, size_t> > AliasCandidateList;
+
+  /// RawSymbol - an ELF symbol decoded to the host endian. The name refers
+  /// to the string table of the input.
+  struct RawSymbol {
+    llvm::StringRef name;
+    uint64_t value;
+    uint64_t size;
+    uint8_t info;
+    uint8_t other;
+    uint16_t shndx;
+  };
+
+  /// RawSymbolTable - the decoded symbols of a symbol table, in index order
+  typedef std::vector<RawSymbol> RawSymbolTable;
+
 public:
   ELFReaderIF(GNULDBackend& pBackend)
     : m_Backend(pBackend)
@@ -75,6 +96,34 @@ public:
                            llvm::StringRef pRegion,
                            const char* StrTab) const = 0;
 
+  /// readSymbols - read the ELF symbols of a DynObj in pIndices, which are
+  /// in increasing order, and analyze the weak aliases among them
+  virtual bool readSymbols(Input& pInput,
+                           IRBuilder& pBuilder,
+                           llvm::StringRef pRegion,
+                           const char* pStrTab,
+                           const std::vector<size_t>& pIndices) const = 0;
+
+  /// readRawSymbols - decode the ELF symbols in pRegion into pTable. No
+  /// symbol is created, so the tables of different inputs can be decoded
+  /// concurrently.
+  virtual void readRawSymbols(llvm::StringRef pRegion,
+                              const char* pStrTab,
+                              RawSymbolTable& pTable) const = 0;
+
+  /// readSymbols - create LDSymbols from the symbols decoded by readRawSymbols
+  virtual bool readSymbols(Input& pInput,
+                           IRBuilder& pBuilder,
+                           const RawSymbolTable& pTable) const = 0;
+
+  /// readAliasCandidates - collect the <value, index> of the defined data
+  /// objects in [pBegin, pEnd) of the .dynsym of a DynObj, in index order.
+  /// Only they can be weak aliases.
+  virtual void readAliasCandidates(llvm::StringRef pRegion,
+                                   size_t pBegin,
+                                   size_t pEnd,
+                                   AliasCandidateList& pList) const = 0;
+
   /// readSignature - read a symbol from the given Input and index in symtab
   /// This is used to get the signature of a group section.
   virtual ResolveInfo* readSignature(Input& pInput,
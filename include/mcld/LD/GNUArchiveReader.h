@@ -73,8 +73,17 @@ private:
 
   /// shouldIncludeSymbol - given a sym name from armap and check if we should
   /// include the corresponding archive member, and then return the decision
+  /// @param pSymHash - the DJB hash value of pSymName
   enum Archive::Symbol::Status
-  shouldIncludeSymbol(const llvm::StringRef& pSymName) const;
+  shouldIncludeSymbol(const llvm::StringRef& pSymName,
+                      uint32_t pSymHash) const;
+
+  /// probeSymbol - decide whether the armap entry pSymIdx should be included,
+  /// and include the corresponding member if so
+  /// @return true if the member is included by this call
+  bool probeSymbol(const LinkerConfig& pConfig,
+                   Archive& pArchive,
+                   size_t pSymIdx);
 
   /// includeMember - include the object member in the given file offset, and
   /// return the size of the object
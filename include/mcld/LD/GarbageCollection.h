@@ -12,80 +12,148 @@
 #include <gtest.h>
 #endif
 
-#include <map>
-#include <set>
+#include <mcld/ADT/HashEntry.h>
+#include <mcld/ADT/HashTable.h>
+
+#include <stdint.h>
+#include <utility>
 #include <vector>
 
 namespace mcld {
 
+class Input;
 class LDSection;
 class LinkerConfig;
 class Module;
 class TargetLDBackend;
+class ThreadPool;
 
 /** \class GarbageCollection
  *  \brief Implementation of garbage collection for --gc-section.
  *  @ref GNU gold, gc.
+ *
+ *  The sections of all inputs are numbered first, and the references between
+ *  sections are kept in a flat adjacency array indexed by the numbers. The
+ *  relocations of each input are scanned for references on the thread pool,
+ *  and the mark phase walks the adjacency array with a bit per section.
  */
 class GarbageCollection
 {
 public:
-  typedef std::set<const LDSection*> SectionListTy;
   typedef std::vector<const LDSection*> SectionVecTy;
 
   /** \class SectionReachedListMap
-   *  \brief Map the section to the list of sections which it can reach directly
+   *  \brief The references between sections which are set up by backends.
+   *
+   *  A section can reach every section it refers to directly. A reference may
+   *  be added more than once.
    */
   class SectionReachedListMap
   {
+  public:
+    typedef std::pair<const LDSection*, const LDSection*> Reference;
+    typedef std::vector<Reference> ReferenceList;
+
   public:
     SectionReachedListMap() {}
 
     /// addReference - add a reference from pFrom to pTo
-    void addReference(const LDSection& pFrom, const LDSection& pTo);
+    void addReference(const LDSection& pFrom, const LDSection& pTo)
+    { m_References.push_back(std::make_pair(&pFrom, &pTo)); }
 
-    /// getReachedList - get the list of sections which can be reached by
-    /// pSection, create one if the list has not existed
-    SectionListTy& getReachedList(const LDSection& pSection);
-
-    /// findReachedList - find the list of sections which can be reached by
-    /// pSection, return NULL if the list not exists
-    SectionListTy* findReachedList(const LDSection& pSection);
-
-  private:
-    typedef std::map<const LDSection*, SectionListTy> ReachedSectionsTy;
+    const ReferenceList& references() const { return m_References; }
 
   private:
-    /// m_ReachedSections - map a section to the reachable sections list
-    ReachedSectionsTy m_ReachedSections;
+    ReferenceList m_References;
   };
 
+  /// Edge - a reference from the section of the first number to the section
+  /// of the second number
+  typedef std::pair<uint32_t, uint32_t> Edge;
+  typedef std::vector<Edge> EdgeList;
+
+  typedef SectionReachedListMap::ReferenceList ReferenceList;
+
 public:
   GarbageCollection(const LinkerConfig& pConfig,
                     const TargetLDBackend& pBackend,
-                    Module& pModule);
+                    Module& pModule,
+                    ThreadPool& pThreadPool);
   ~GarbageCollection();
 
   /// run - do garbage collection
   bool run();
 
 private:
+  class ScanJob;
+  friend class ScanJob;
+
+  /// SectCompare - hash compare function for LDSection*
+  struct SectCompare
+  {
+    bool operator()(const LDSection* X, const LDSection* Y) const
+    { return (X==Y); }
+  };
+
+  /// SectPtrHash - hash function for LDSection*
+  struct SectPtrHash
+  {
+    size_t operator()(const LDSection* pKey) const
+    {
+      return (unsigned((uintptr_t)pKey) >> 4) ^
+             (unsigned((uintptr_t)pKey) >> 9);
+    }
+  };
+
+  typedef HashEntry<const LDSection*, uint32_t, SectCompare> SectIdEntryType;
+  typedef HashTable<SectIdEntryType,
+                    SectPtrHash,
+                    EntryFactory<SectIdEntryType> > SectIdTableType;
+
+private:
+  /// getSectionId - get the number of pSection, number it if it has none yet
+  uint32_t getSectionId(const LDSection& pSection);
+
+  /// findSectionId - find the number of pSection. Return false if pSection has
+  /// no number.
+  bool findSectionId(const LDSection& pSection, uint32_t& pId) const;
+
+  void numberSections();
   void setUpReachedSections();
+
+  /// scanRelocations - collect the references made by the relocations of
+  /// pInput. The references to the sections without numbers go to pOthers.
+  void scanRelocations(const Input& pInput,
+                       EdgeList& pEdges,
+                       ReferenceList& pOthers) const;
+
+  /// buildAdjacency - build the flat adjacency array from the edges
+  void buildAdjacency(const EdgeList& pEdges);
+
   void findReferencedSections(SectionVecTy& pEntry);
   void getEntrySections(SectionVecTy& pEntry);
   void stripSections();
 
 private:
-  /// m_SectionReachedListMap - map the section to the list of sections which it
-  /// can reach directly
-  SectionReachedListMap m_SectionReachedListMap;
+  /// m_Sections - the sections, indexed by their numbers
+  SectionVecTy m_Sections;
+
+  /// m_SectionIds - map a section to its number
+  SectIdTableType m_SectionIds;
+
+  /// m_ReachedBegin, m_Reached - the sections reached by the section i directly
+  /// are m_Reached[m_ReachedBegin[i]] to m_Reached[m_ReachedBegin[i + 1] - 1]
+  std::vector<uint32_t> m_ReachedBegin;
+  std::vector<uint32_t> m_Reached;
 
-  /// m_ReferencedSections - a list of sections which can be reached from entry
-  SectionListTy m_ReferencedSections;
+  /// m_Referenced - m_Referenced[i] is true if the section i can be reached
+  /// from entry
+  std::vector<bool> m_Referenced;
 
   const LinkerConfig& m_Config;
   const TargetLDBackend& m_Backend;
   Module& m_Module;
+  ThreadPool& m_ThreadPool;
 };
 
 } // namespace of mcld
@@ -0,0 +1,182 @@
+//===- IdenticalCodeFolding.h ---------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_IDENTICALCODEFOLDING_H
+#define MCLD_LD_IDENTICALCODEFOLDING_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+
+#include <mcld/ADT/HashEntry.h>
+#include <mcld/ADT/HashTable.h>
+
+#include <llvm/ADT/StringRef.h>
+
+#include <stdint.h>
+#include <vector>
+
+namespace mcld {
+
+class Input;
+class LDSection;
+class LinkerConfig;
+class Module;
+class TargetLDBackend;
+class ThreadPool;
+
+/** \class IdenticalCodeFolding
+ *  \brief Implementation of identical code folding for --icf.
+ *  @ref GNU gold, icf.
+ *
+ *  Two code sections can be folded if they have the same contents and their
+ *  relocations refer to the same places, or to the same offsets of sections
+ *  which can be folded themselves. The sections are first split into classes
+ *  by their contents and the relocations to the other sections. The classes
+ *  are then refined by the classes of the referred candidate sections until
+ *  nothing changes. The contents and the relocations are hashed, and the
+ *  classes are refined, on the thread pool.
+ *
+ *  The first section of a class in the input order is kept. The symbols
+ *  defined in the other sections are moved to it, and the other sections are
+ *  ignored. With --icf=safe, the sections whose addresses may be taken are not
+ *  folded.
+ */
+class IdenticalCodeFolding
+{
+public:
+  /** \class Reloc
+   *  \brief a relocation applied to a candidate section
+   */
+  struct Reloc
+  {
+    uint64_t offset;
+    uint32_t type;
+    uint64_t addend;
+
+    /// the index of the candidate section referred, or NotCandidate
+    size_t candidate;
+
+    /// the fragment or the symbol referred if it is not in a candidate
+    const void* target;
+    uint64_t targetOffset;
+  };
+
+  typedef std::vector<Reloc> RelocList;
+
+  /** \class Candidate
+   *  \brief a section which may be folded
+   */
+  struct Candidate
+  {
+    LDSection* section;
+    llvm::StringRef content;
+    RelocList relocs;
+    uint32_t hash;
+
+    /// the section can not be folded, e.g., its address is taken
+    bool keep;
+  };
+
+  static const size_t NotCandidate;
+
+public:
+  IdenticalCodeFolding(const LinkerConfig& pConfig,
+                       const TargetLDBackend& pBackend,
+                       Module& pModule,
+                       ThreadPool& pThreadPool);
+  ~IdenticalCodeFolding();
+
+  /// run - fold the identical sections
+  bool run();
+
+  /// findClasses - split pCandidates into classes of identical sections.
+  /// pClasses[i] is the smallest index of the candidates identical to the
+  /// candidate i.
+  static void findClasses(const std::vector<Candidate*>& pCandidates,
+                          std::vector<size_t>& pClasses,
+                          ThreadPool& pThreadPool);
+
+  /// isConstantEqual - compare the contents and the relocations of two
+  /// candidates, not counting the classes of the referred candidates
+  static bool isConstantEqual(const Candidate& pX, const Candidate& pY);
+
+  /// isVariableEqual - compare the classes of the candidates referred by two
+  /// candidates
+  static bool isVariableEqual(const Candidate& pX,
+                              const Candidate& pY,
+                              const std::vector<size_t>& pClasses);
+
+private:
+  class CollectJob;
+  class HashJob;
+  class RewriteJob;
+  friend class CollectJob;
+  friend class HashJob;
+  friend class RewriteJob;
+
+  /// SectCompare - hash compare function for LDSection*
+  struct SectCompare
+  {
+    bool operator()(const LDSection* X, const LDSection* Y) const
+    { return (X==Y); }
+  };
+
+  /// SectPtrHash - hash function for LDSection*
+  struct SectPtrHash
+  {
+    size_t operator()(const LDSection* pKey) const
+    {
+      return (unsigned((uintptr_t)pKey) >> 4) ^
+             (unsigned((uintptr_t)pKey) >> 9);
+    }
+  };
+
+  typedef HashEntry<const LDSection*, size_t, SectCompare> SectIdEntryType;
+  typedef HashTable<SectIdEntryType,
+                    SectPtrHash,
+                    EntryFactory<SectIdEntryType> > SectIdTableType;
+
+private:
+  /// findCandidates - collect the sections which may be folded
+  void findCandidates();
+
+  /// findCandidate - the index of the candidate pSection, or NotCandidate
+  size_t findCandidate(const LDSection& pSection) const;
+
+  /// collectRelocations - record the relocations applied to the candidates
+  /// of pInput. The candidates whose addresses are taken by the relocations go
+  /// to pTaken.
+  void collectRelocations(const Input& pInput,
+                          std::vector<size_t>& pTaken) const;
+
+  /// markExported - mark the candidates defining exported symbols
+  void markExported();
+
+  /// rewriteInput - move the symbols defined in the folded sections of pInput
+  void rewriteInput(Input& pInput) const;
+
+private:
+  std::vector<Candidate*> m_Candidates;
+
+  /// m_CandidateIds - map a section to its index in m_Candidates
+  SectIdTableType m_CandidateIds;
+
+  /// m_FoldTo - m_FoldTo[i] is the candidate which the candidate i is folded
+  /// into, or i itself
+  std::vector<size_t> m_FoldTo;
+
+  const LinkerConfig& m_Config;
+  const TargetLDBackend& m_Backend;
+  Module& m_Module;
+  ThreadPool& m_ThreadPool;
+};
+
+} // namespace of mcld
+
+#endif
+
@@ -112,6 +112,12 @@ public:
   uint32_t align() const
   { return m_Align; }
 
+  /// entSize - the size of each entry of a table of fixed-size entries,
+  /// such as the characters of SHF_STRINGS sections.
+  ///   In ELF, it is sh_entsize.
+  uint64_t entSize() const
+  { return m_EntSize; }
+
   size_t index() const
   { return m_Index; }
 
@@ -144,6 +150,9 @@ public:
   void setAlign(uint32_t align)
   { m_Align = align; }
 
+  void setEntSize(uint64_t pEntSize)
+  { m_EntSize = pEntSize; }
+
   void setFlag(uint32_t flag)
   { m_Flag = flag; }
 
@@ -204,6 +213,7 @@ private:
   uint64_t m_Offset;
   uint64_t m_Addr;
   uint32_t m_Align;
+  uint64_t m_EntSize;
 
   size_t m_Info;
   LDSection* m_pLink;
@@ -21,6 +21,7 @@
 #include <mcld/Support/GCFactory.h>
 
 #include <utility>
+#include <vector>
 
 #include <llvm/ADT/StringRef.h>
 
@@ -48,6 +49,26 @@ public:
 
   typedef size_t size_type;
 
+  typedef std::vector<ResolveInfo*> UndefList;
+
+  /** \class NamePool::Loader
+   *  \brief Loader inserts the symbols which are loaded on demand.
+   *
+   *  Readers may defer the symbols that nobody refers to yet, such as the
+   *  definitions in shared objects. Before a name is inserted or looked up
+   *  for the first time, the pool asks the loader to insert the deferred
+   *  symbols of that name, so the symbols are resolved in the same order as
+   *  if they had been inserted when their inputs were read.
+   */
+  class Loader
+  {
+  public:
+    virtual ~Loader() { }
+
+    /// load - insert the deferred symbols named pName, if any
+    virtual void load(const llvm::StringRef& pName) = 0;
+  };
+
 public:
   explicit NamePool(size_type pSize = 3);
 
@@ -85,10 +106,21 @@ public:
   const LDSymbol* findSymbol(const llvm::StringRef& pName) const;
   LDSymbol*       findSymbol(const llvm::StringRef& pName);
 
-  /// findInfo - find the resolved ResolveInfo
+  /// findInfo - find the resolved ResolveInfo. The const versions do not
+  /// load the deferred symbols.
   const ResolveInfo* findInfo(const llvm::StringRef& pName) const;
   ResolveInfo*       findInfo(const llvm::StringRef& pName);
 
+  /// findInfo - find the resolved ResolveInfo. pHash is the hash value of
+  /// pName, such as ResolveInfo::hash() or hash() of this pool.
+  const ResolveInfo* findInfo(const llvm::StringRef& pName,
+                              uint32_t pHash) const;
+  ResolveInfo*       findInfo(const llvm::StringRef& pName, uint32_t pHash);
+
+  /// hash - compute the hash value of a name
+  uint32_t hash(const llvm::StringRef& pName) const
+  { return m_Table.hash()(pName); }
+
   /// insertString - insert a string
   /// if the string has existed, modify pString to the existing string
   /// @return the StringRef points to the hash table
@@ -128,15 +160,35 @@ public:
   const_freeinfo_iterator freeinfo_end() const
   { return m_FreeInfoSet.end(); }
 
+  /// undefs - the symbols in the order they became strong undefined
+  /// references. A symbol is appended when it is first referred, or when its
+  /// weak references turn into a strong one. Readers which include objects on
+  /// demand (e.g., archive readers) can keep a position in the list and only
+  /// look up the symbols after it.
+  const UndefList& undefs() const { return m_Undefs; }
+
   // -----  capacity  ----- //
   void reserve(size_type pN);
 
   size_type capacity() const;
 
+  // -----  deferred symbols  ----- //
+  /// setLoader - set the loader of the deferred symbols, or NULL
+  void setLoader(Loader* pLoader) { m_pLoader = pLoader; }
+
+  Loader* getLoader() const { return m_pLoader; }
+
+private:
+  /// loadSymbols - ask the loader to insert the deferred symbols named pName
+  /// if the pool has no symbol of that name yet
+  void loadSymbols(const llvm::StringRef& pName, uint32_t pHash);
+
 private:
   Resolver* m_pResolver;
+  Loader* m_pLoader;
   Table m_Table;
   FreeInfoSet m_FreeInfoSet;
+  UndefList m_Undefs;
 };
 
 } // namespace of mcld
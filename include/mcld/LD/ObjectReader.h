@@ -38,8 +38,23 @@ protected:
 public:
   virtual ~ObjectReader() { f_GroupSignatureMap.clear(); }
 
+  /// readHeader - read the section headers and create LDSections. It only
+  /// touches the given input, so headers of different inputs can be read
+  /// concurrently. Reading the headers of an input again has no effect.
   virtual bool readHeader(Input& pFile) = 0;
 
+  /// readSectionData - read the contents of the sections whose handling does
+  /// not depend on other inputs. Like readHeader(), it only touches the given
+  /// input, so it can run concurrently after readHeader(). readSections()
+  /// skips the sections read here.
+  virtual bool readSectionData(Input& pFile) = 0;
+
+  /// readRawSymbols - decode the symbol table of the given input without
+  /// creating any symbol. It can run concurrently after readHeader().
+  /// readSymbols() then creates and resolves the symbols from the decoded
+  /// table, serially and in command-line order.
+  virtual bool readRawSymbols(Input& pFile) = 0;
+
   virtual bool readSymbols(Input& pFile) = 0;
 
   virtual bool readSections(Input& pFile) = 0;
@@ -17,6 +17,8 @@ namespace mcld {
 
 class Module;
 class FileOutputBuffer;
+class LDSection;
+class ThreadPool;
 
 /** \class ObjectWriter
  *  \brief ObjectWriter provides a common interface for object file writers.
@@ -29,8 +31,17 @@ protected:
 public:
   virtual ~ObjectWriter();
 
+  /// writeObject - write out pModule, except the sections which are filled
+  /// up by applying relocations. (@see TargetLDBackend::isFilledByRelocator)
+  /// The sections may be written concurrently on pThreadPool.
   virtual llvm::error_code writeObject(Module& pModule,
-                                       FileOutputBuffer& pOutput) = 0;
+                                       FileOutputBuffer& pOutput,
+                                       ThreadPool& pThreadPool) = 0;
+
+  /// writeSection - write out a section
+  virtual void writeSection(Module& pModule,
+                            FileOutputBuffer& pOutput,
+                            LDSection* pSection) = 0;
 
   virtual size_t getOutputSize(const Module& pModule) const = 0;
 };
@@ -21,7 +21,7 @@
 #include <llvm/ADT/ilist_node.h>
 #include <llvm/Support/DataTypes.h>
 
-#include <list>
+#include <vector>
 
 namespace mcld {
 
@@ -91,17 +91,9 @@ public:
   const_reverse_iterator rend  () const { return m_Relocations.rend();   }
   reverse_iterator       rend  ()       { return m_Relocations.rend();   }
 
-  template<class Comparator> void sort(Comparator pComparator) {
-    /* FIXME: use llvm::iplist::sort */
-    std::list<Relocation*> relocs;
-    for (iterator it = begin(), ie = end(); it != ie; ++it)
-      relocs.push_back(it);
-    relocs.sort(pComparator);
-    m_Relocations.clear();
-    for (std::list<Relocation*>::iterator it = relocs.begin(),
-      ie = relocs.end(); it != ie; ++it)
-      m_Relocations.push_back(*it);
-  }
+  /// reorder - relink the relocations in the order of pRelocs, which holds
+  /// all relocations of this RelocData
+  void reorder(const std::vector<Relocation*>& pRelocs);
 
 private:
   RelocationListType m_Relocations;
@@ -13,6 +13,7 @@
 #endif
 
 #include <mcld/Fragment/Relocation.h>
+#include <llvm/Support/Mutex.h>
 
 namespace mcld
 {
@@ -46,13 +47,15 @@ public:
 
 public:
   Relocator(const LinkerConfig& pConfig)
-    : m_Config(pConfig)
+    : m_Config(pConfig), m_pOutput(NULL)
   {}
 
   virtual ~Relocator() = 0;
 
   /// apply - general apply function
-  virtual Result applyRelocation(Relocation& pRelocation) = 0;
+  /// @param pTarget - the data at the place of pRelocation. The result of the
+  ///                  relocation is written back to it.
+  virtual Result applyRelocation(Relocation& pRelocation, DWord& pTarget) = 0;
 
   /// scanRelocation - When read in relocations, backend can do any modification
   /// to relocation and generate empty entries, such as GOT, dynamic relocation
@@ -97,6 +100,17 @@ public:
   virtual bool finalizeApply(Input& pInput)
   { return true; }
 
+  /// isApplyThreadSafe - return true if the relocations of different inputs
+  /// can be applied concurrently. That is, initializeApply(), applyRelocation()
+  /// and finalizeApply() keep no per-input state in the relocator. The GOT
+  /// entries shared by the relocations of different inputs must be filled up
+  /// under getEntryLock().
+  virtual bool isApplyThreadSafe() const
+  { return false; }
+
+  /// getEntryLock - the lock of the GOT entries which are shared by inputs
+  llvm::sys::Mutex& getEntryLock() { return m_EntryLock; }
+
   /// partialScanRelocation - When doing partial linking, backend can do any
   /// modification to relocation to fix the relocation offset after section
   /// merge
@@ -118,11 +132,27 @@ public:
   /// getSize - get the size of a relocation in bit
   virtual Size getSize(Type pType) const = 0;
 
+  // ------ target data -----//
+  /// setOutput - set the start of the output file, or NULL. Relocations are
+  /// applied to their places in the output file.
+  void setOutput(uint8_t* pOutput) { m_pOutput = pOutput; }
+
+  /// readTarget - read the data at the place of pReloc in the host endian.
+  /// Before the output is set, e.g., when scanning, the data is read from the
+  /// input section.
+  DWord readTarget(const Relocation& pReloc) const;
+
+  /// writeTarget - write pData to the place of pReloc in the output file.
+  /// Only the bytes covered by the relocation are written.
+  void writeTarget(const Relocation& pReloc, DWord pData) const;
+
 protected:
   const LinkerConfig& config() const { return m_Config; }
 
 private:
   const LinkerConfig& m_Config;
+  llvm::sys::Mutex m_EntryLock;
+  uint8_t* m_pOutput;
 };
 
 } // namespace of mcld
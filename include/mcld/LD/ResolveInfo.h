@@ -129,6 +129,10 @@ public:
   void setSize(SizeType pSize)
   { m_Size = pSize; }
 
+  /// setHash - set the DJB hash value of the name
+  void setHash(uint32_t pHash)
+  { m_Hash = pHash; }
+
   void override(const ResolveInfo& pForm);
 
   void overrideAttributes(const ResolveInfo& pFrom);
@@ -208,6 +212,12 @@ public:
   unsigned int nameSize() const
   { return (m_BitField >> NAME_LENGTH_OFFSET); }
 
+  /// hash - the DJB hash value of the name. It is computed once when the
+  /// name is inserted into NamePool, and is the same hash function used by
+  /// .gnu.hash.
+  uint32_t hash() const
+  { return m_Hash; }
+
   uint32_t info() const
   { return (m_BitField & INFO_MASK); }
 
@@ -293,6 +303,7 @@ private:
    * |length of m_Name|InDyn|reserved|Symbol|Type |ELF visibility|Local|Com|Def|Dyn|Weak|
    */
   uint32_t m_BitField;
+  uint32_t m_Hash;
   char m_Name[];
 };
 
@@ -20,6 +20,8 @@
 #include <mcld/Support/Allocators.h>
 #include <mcld/Fragment/Fragment.h>
 
+#include <vector>
+
 namespace mcld {
 
 class LDSection;
@@ -39,7 +41,30 @@ private:
   SectionData& operator=(const SectionData &); // DO NOT IMPLEMENT
 
 public:
-  typedef llvm::iplist<Fragment> FragmentListType;
+  /** \class FragmentListTraits
+   *  \brief FragmentListTraits invalidates the offset index of the owner when
+   *  fragments are inserted into, removed from or moved between the lists.
+   */
+  class FragmentListTraits : public llvm::ilist_default_traits<Fragment>
+  {
+  public:
+    FragmentListTraits() : m_pOwner(NULL) { }
+
+    void setOwner(SectionData* pOwner) { m_pOwner = pOwner; }
+
+    void addNodeToList(Fragment* pFrag);
+
+    void removeNodeFromList(Fragment* pFrag);
+
+    void transferNodesFromList(FragmentListTraits& pFrom,
+                               llvm::ilist_iterator<Fragment> pFirst,
+                               llvm::ilist_iterator<Fragment> pLast);
+
+  private:
+    SectionData* m_pOwner;
+  };
+
+  typedef llvm::iplist<Fragment, FragmentListTraits> FragmentListType;
 
   typedef FragmentListType::reference reference;
   typedef FragmentListType::const_reference const_reference;
@@ -81,10 +106,44 @@ public:
   const_reverse_iterator rend  () const { return m_Fragments.rend();   }
   reverse_iterator       rend  ()       { return m_Fragments.rend();   }
 
+  /// findFragment - find the first fragment which ends at or after the offset
+  /// pOffset of the section, and set pFragOffset to pOffset relative to the
+  /// start of the fragment. Return NULL if pOffset is beyond the section.
+  ///
+  /// The lookup is a binary search in an index of the fragment offsets. The
+  /// index is built at the first lookup after the fragment list changes.
+  /// Sections with alignment fragments, whose sizes depend on the layout, are
+  /// searched linearly.
+  Fragment* findFragment(uint64_t pOffset, uint64_t& pFragOffset);
+
+  /// invalidateIndex - drop the offset index. The fragment list does this by
+  /// itself, and the fragments whose sizes change call it.
+  void invalidateIndex() { m_IndexState = IndexStale; }
+
 private:
+  enum IndexState {
+    IndexStale,
+    IndexBuilt,
+    IndexNone     // the fragments can not be indexed
+  };
+
+  /// buildIndex - build the offset index. Return false if the fragments
+  /// can not be indexed.
+  bool buildIndex();
+
+private:
+  /// m_IndexState - declared before m_Fragments, which invalidates the index
+  /// until its fragments are destroyed
+  IndexState m_IndexState;
+
   FragmentListType m_Fragments;
   LDSection* m_pSection;
 
+  /// m_IndexFrags, m_IndexEnds - the fragments in order, and the end offsets
+  /// of them in the section
+  std::vector<Fragment*> m_IndexFrags;
+  std::vector<uint64_t> m_IndexEnds;
+
 };
 
 } // namespace of mcld
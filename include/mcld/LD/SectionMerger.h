@@ -0,0 +1,196 @@
+//===- SectionMerger.h ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_SECTIONMERGER_H
+#define MCLD_LD_SECTIONMERGER_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+
+#include <mcld/ADT/HashEntry.h>
+#include <mcld/ADT/HashTable.h>
+
+#include <llvm/ADT/StringRef.h>
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace mcld {
+
+class Input;
+class LDSection;
+class LinkerConfig;
+class MergedFragment;
+class Module;
+class ThreadPool;
+
+/** \class SectionMerger
+ *  \brief SectionMerger merges the SHF_MERGE input sections.
+ *
+ *  The mergeable input sections which go to the same output section and have
+ *  the same flags, entry size and alignment form a group. Each section is
+ *  split into pieces: the null-terminated strings of SHF_STRINGS sections, or
+ *  the constants of entry size. The identical pieces of a group are found
+ *  with a hash table per shard, and every shard of every group is an
+ *  independent job on the thread pool. The first occurrence of a piece in the
+ *  input order is kept, so the result does not depend on the threads.
+ *
+ *  The kept pieces of a group form a MergedFragment, which takes the place of
+ *  the first section of the group, and the other sections are ignored. The
+ *  symbols defined in the sections and the relocations against the section
+ *  symbols are then moved to the merged layout.
+ *
+ *  The sections whose contents are relocated, or which are referred by the
+ *  section symbols of REL relocations (the addend is in the section contents
+ *  and can not be moved), are not merged.
+ */
+class SectionMerger
+{
+public:
+  enum {
+    NumOfShardBits = 4,
+    NumOfShards = 1 << NumOfShardBits
+  };
+
+  /** \class Piece
+   *  \brief a string or a constant in an input section
+   */
+  struct Piece
+  {
+    llvm::StringRef data;
+    uint64_t inOffset;  ///< the offset in the input section
+    uint64_t outOffset; ///< the offset in the merged fragment
+    uint32_t hash;
+    Piece* leader;      ///< the first identical piece in the group
+  };
+
+  typedef std::vector<Piece> PieceList;
+
+public:
+  SectionMerger(const LinkerConfig& pConfig,
+                Module& pModule,
+                ThreadPool& pThreadPool);
+  ~SectionMerger();
+
+  /// run - merge the sections
+  bool run();
+
+  /// splitPieces - split pContent of entry size pEntSize into pieces. Return
+  /// false if pContent can not be split.
+  static bool splitPieces(llvm::StringRef pContent,
+                          uint64_t pEntSize,
+                          bool pIsString,
+                          PieceList& pPieces);
+
+  /// getShardOf - the shard of a piece of hash value pHash
+  static unsigned int getShardOf(uint32_t pHash)
+  { return (pHash * 0x9E3779B1u) >> (32 - NumOfShardBits); }
+
+  /// getOutputOffset - the offset in the merged fragment of the offset pOffset
+  /// in the input section of pPieces
+  static uint64_t getOutputOffset(const PieceList& pPieces, uint64_t pOffset);
+
+private:
+  class ScanJob;
+  class SplitJob;
+  class ShardJob;
+  class RewriteJob;
+  friend class ScanJob;
+  friend class SplitJob;
+  friend class ShardJob;
+  friend class RewriteJob;
+
+  /// Candidate - a mergeable input section
+  struct Candidate
+  {
+    Input* input;
+    LDSection* section;
+    size_t group;
+    bool valid;
+    PieceList pieces;
+  };
+
+  /// Group - the sections merged into one fragment
+  struct Group
+  {
+    std::string output;
+    uint32_t flag;
+    uint64_t entSize;
+    uint32_t align;
+    std::vector<size_t> members;
+    MergedFragment* frag;
+  };
+
+  /// SectCompare - hash compare function for LDSection*
+  struct SectCompare
+  {
+    bool operator()(const LDSection* X, const LDSection* Y) const
+    { return (X==Y); }
+  };
+
+  /// SectPtrHash - hash function for LDSection*
+  struct SectPtrHash
+  {
+    size_t operator()(const LDSection* pKey) const
+    {
+      return (unsigned((uintptr_t)pKey) >> 4) ^
+             (unsigned((uintptr_t)pKey) >> 9);
+    }
+  };
+
+  typedef HashEntry<const LDSection*, size_t, SectCompare> SectIdEntryType;
+  typedef HashTable<SectIdEntryType,
+                    SectPtrHash,
+                    EntryFactory<SectIdEntryType> > SectIdTableType;
+
+private:
+  /// findCandidates - collect the mergeable input sections
+  void findCandidates();
+
+  /// findCandidate - the candidate of pSection, or NULL if there is none
+  Candidate* findCandidate(const LDSection& pSection) const;
+
+  /// scanRelocations - invalidate the candidates of pInput which can not be
+  /// merged because of the relocations
+  void scanRelocations(const Input& pInput) const;
+
+  /// groupCandidates - group the valid candidates with pieces
+  void groupCandidates();
+
+  /// findLeaders - set the leader of each piece of pMembers, which are in the
+  /// input order, to its first occurrence
+  static void findLeaders(std::vector<Piece*>& pMembers);
+
+  /// layoutGroup - place the leaders of pGroup in its merged fragment
+  void layoutGroup(Group& pGroup);
+
+  /// rewriteInput - move the relocations and the symbols of pInput to the
+  /// merged layout
+  void rewriteInput(Input& pInput) const;
+
+  /// replaceSections - put the merged fragments into the first sections of
+  /// groups, and ignore the other sections
+  void replaceSections();
+
+private:
+  std::vector<Candidate*> m_Candidates;
+  std::vector<Group> m_Groups;
+
+  /// m_CandidateIds - map a section to its index in m_Candidates
+  SectIdTableType m_CandidateIds;
+
+  const LinkerConfig& m_Config;
+  Module& m_Module;
+  ThreadPool& m_ThreadPool;
+};
+
+} // namespace of mcld
+
+#endif
+
@@ -0,0 +1,105 @@
+//===- StringTableBuilder.h -----------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_STRINGTABLEBUILDER_H
+#define MCLD_LD_STRINGTABLEBUILDER_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+#include <mcld/ADT/HashEntry.h>
+#include <mcld/ADT/HashTable.h>
+#include <mcld/ADT/StringHash.h>
+
+#include <llvm/ADT/StringRef.h>
+
+#include <list>
+#include <string>
+#include <vector>
+
+namespace mcld {
+
+/** \class StringTableBuilder
+ *  \brief StringTableBuilder lays out an ELF string table, such as .strtab,
+ *  .dynstr and .shstrtab.
+ *
+ *  Identical strings are stored once, and a string which is a suffix of
+ *  another one points into the tail of that string. The table always starts
+ *  with a null byte, so the empty string is at offset 0.
+ *
+ *  Usage:
+ *  1. add() all strings,
+ *  2. finalize() to decide the offsets and the size,
+ *  3. getOffset() of each string and emit() the table.
+ */
+class StringTableBuilder
+{
+private:
+  typedef HashEntry<const llvm::StringRef,
+                    size_t,
+                    hash::StringCompare<llvm::StringRef> > EntryType;
+
+  typedef HashTable<EntryType,
+                    hash::StringHash<hash::DJB>,
+                    EntryFactory<EntryType> > StringMapType;
+
+public:
+  /// NotFound - returned by getOffset() for a string not in the table
+  static const size_t NotFound;
+
+public:
+  StringTableBuilder();
+
+  ~StringTableBuilder();
+
+  /// add - add a string to the table. pStr only refers to the string, so the
+  /// memory must be kept until the table is emitted.
+  void add(const llvm::StringRef& pStr);
+
+  /// addCopy - add a copy of the string to the table.
+  void addCopy(const llvm::StringRef& pStr);
+
+  /// finalize - decide the offsets of all strings and the size of the table.
+  /// Strings can not be added after finalize().
+  void finalize();
+
+  /// isFinalized - check if the offsets have been decided
+  bool isFinalized() const { return m_bFinalized; }
+
+  /// size - the size of the table in bytes, including the leading null byte
+  size_t size() const { return m_Size; }
+
+  /// getOffset - get the offset of a string in the table
+  /// @return the offset, or NotFound if the string was not added
+  size_t getOffset(const llvm::StringRef& pStr) const;
+
+  /// emit - write the table to pBuffer, which has at least size() bytes
+  void emit(char* pBuffer) const;
+
+  /// clear - remove all strings
+  void clear();
+
+private:
+  StringMapType m_StringMap;
+
+  /// the distinct strings
+  std::vector<llvm::StringRef> m_Strings;
+
+  /// the strings stored in the table, in the order of their offsets
+  std::vector<llvm::StringRef> m_Layout;
+
+  /// the copies made by addCopy()
+  std::list<std::string> m_Copies;
+
+  size_t m_Size;
+  bool m_bFinalized;
+};
+
+} // namespace of mcld
+
+#endif
+
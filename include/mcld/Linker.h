@@ -12,7 +12,10 @@
 #include <gtest.h>
 #endif
 
+#include <llvm/Support/DataTypes.h>
+
 #include <string>
+#include <vector>
 
 namespace mcld {
 
@@ -61,9 +64,28 @@ public:
   /// to the file.
   bool emit(const Module& pModule, const std::string& pPath);
 
-  /// emit - To emit output mcld::Module in the pFileDescriptor.
+  /// emit - To emit output mcld::Module in the pFileDescriptor. The file is
+  /// extended to the output size if it is smaller, e.g., an empty memfd.
   bool emit(const Module& pModule, int pFileDescriptor);
 
+  /// emit - To emit output mcld::Module into the caller's memory pBuffer of
+  /// pSize bytes. pSize must be at least getOutputSize(pModule).
+  bool emit(const Module& pModule, void* pBuffer, size_t pSize);
+
+  /// emit - To emit output mcld::Module into pImage, which is resized to the
+  /// output size. A vector reused for several links keeps its capacity.
+  bool emit(const Module& pModule, std::vector<uint8_t>& pImage);
+
+  /// emitToMemoryFile - To emit output mcld::Module into an anonymous memory
+  /// file, and return its descriptor in pFileDescriptor. The caller owns the
+  /// descriptor, and can load the output through /proc/self/fd without
+  /// touching the file system. Return false without exiting if memory files
+  /// are not supported.
+  bool emitToMemoryFile(const Module& pModule, int& pFileDescriptor);
+
+  /// getOutputSize - The size of the output file. Available after layout.
+  size_t getOutputSize(const Module& pModule) const;
+
   bool reset();
 
 private:
@@ -75,6 +97,12 @@ private:
 
   bool initEmulator(LinkerScript& pScript);
 
+  bool emitToFile(const Module& pModule, FileHandle& pFile);
+
+  bool emitInPlace(const Module& pModule, const std::string& pPath);
+
+  bool emitToMemory(uint8_t* pBuffer, size_t pSize);
+
 private:
   LinkerConfig* m_pConfig;
   IRBuilder* m_pIRBuilder;
@@ -11,6 +11,8 @@
 #ifdef ENABLE_UNITTEST
 #include <gtest.h>
 #endif
+#include <llvm/ADT/DenseMap.h>
+
 #include <cstddef>
 #include <vector>
 
@@ -21,6 +23,11 @@ class LDSymbol;
 class ResolveInfo;
 /** \class SymbolCategory
  *  \brief SymbolCategory groups output LDSymbol into different categories.
+ *
+ *  The position of each symbol is recorded when the symbol is moved, so
+ *  arrange() does not search for the symbol. Since the symbols can also be
+ *  reordered through the iterators (e.g., sorting .dynsym), a recorded
+ *  position is checked before it is used.
  */
 class SymbolCategory
 {
@@ -178,9 +185,22 @@ private:
                           Category::Type pSource,
                           Category::Type pTarget);
 
+  /// swap - swap the symbols at pPos1 and pPos2, and record their positions
+  void swap(size_t pPos1, size_t pPos2);
+
+  /// find - find the position of pSymbol in pCategory. Return pCategory.end
+  /// if pSymbol is not in pCategory.
+  size_t find(const LDSymbol& pSymbol, const Category& pCategory) const;
+
+private:
+  typedef llvm::DenseMap<const LDSymbol*, size_t> PositionMap;
+
 private:
   OutputSymbols m_OutputSymbols;
 
+  /// m_Positions - the recorded position of each symbol in m_OutputSymbols
+  PositionMap m_Positions;
+
   Category* m_pFile;
   Category* m_pLocal;
   Category* m_pLocalDyn;
@@ -17,6 +17,9 @@
 #endif
 
 #include <mcld/InputTree.h>
+#include <mcld/ADT/HashTable.h>
+#include <mcld/ADT/StringEntry.h>
+#include <mcld/ADT/StringHash.h>
 #include <mcld/LD/NamePool.h>
 #include <mcld/LD/SectionSymbolSet.h>
 #include <mcld/MC/SymbolCategory.h>
@@ -48,7 +51,61 @@ public:
   typedef InputTree::iterator input_iterator;
   typedef InputTree::const_iterator const_input_iterator;
 
-  typedef std::vector<LDSection*> SectionTable;
+  /** \class SectionTable
+   *  \brief SectionTable is the list of output sections with an index of
+   *  their names.
+   *
+   *  The index is kept in sync with push_back() and clear(). Sections must not
+   *  be replaced through the iterators.
+   */
+  class SectionTable
+  {
+  private:
+    typedef std::vector<LDSection*> SectionList;
+
+  public:
+    typedef SectionList::iterator iterator;
+    typedef SectionList::const_iterator const_iterator;
+
+  public:
+    SectionTable();
+
+    // -----  modifiers  ----- //
+    void push_back(LDSection* pSection);
+
+    void clear();
+
+    // -----  observers  ----- //
+    /// find - the first section named pName, or NULL if there is none
+    LDSection* find(const llvm::StringRef& pName) const;
+
+    iterator         begin()       { return m_Sections.begin(); }
+    const_iterator   begin() const { return m_Sections.begin(); }
+    iterator         end  ()       { return m_Sections.end();   }
+    const_iterator   end  () const { return m_Sections.end();   }
+    LDSection*       front()       { return m_Sections.front(); }
+    const LDSection* front() const { return m_Sections.front(); }
+    LDSection*       back ()       { return m_Sections.back();  }
+    const LDSection* back () const { return m_Sections.back();  }
+    size_t           size () const { return m_Sections.size();  }
+    bool             empty() const { return m_Sections.empty(); }
+
+    LDSection*       at(size_t pIdx)       { return m_Sections.at(pIdx); }
+    const LDSection* at(size_t pIdx) const { return m_Sections.at(pIdx); }
+
+    LDSection*       operator[](size_t pIdx)       { return m_Sections[pIdx]; }
+    const LDSection* operator[](size_t pIdx) const { return m_Sections[pIdx]; }
+
+  private:
+    typedef HashTable<StringEntry<LDSection*>,
+                      hash::StringHash<hash::DJB>,
+                      StringEntryFactory<LDSection*> > NameIndex;
+
+  private:
+    SectionList m_Sections;
+    NameIndex m_NameIndex;
+  };
+
   typedef SectionTable::iterator iterator;
   typedef SectionTable::const_iterator const_iterator;
 
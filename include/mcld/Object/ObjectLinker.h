@@ -32,6 +32,7 @@ class ExecWriter;
 class BinaryWriter;
 class Relocation;
 class ResolveInfo;
+class ThreadPool;
 
 /** \class ObjectLinker
  */
@@ -109,19 +110,17 @@ public:
   /// postlayout - help backend to do some modification after layout
   bool postlayout();
 
-  /// relocate - applying relocation entries and create relocation
-  /// section in the output files
-  /// Create relocation section, asking TargetLDBackend to
-  /// read the relocation information into RelocationEntry
-  /// and push_back into the relocation section
-  bool relocation();
-
   /// finalizeSymbolValue - finalize the symbol value
   bool finalizeSymbolValue();
 
   /// emitOutput - emit the output file.
   bool emitOutput(FileOutputBuffer& pOutput);
 
+  /// relocation - apply relocation entries to their places in the output
+  /// file. The sections which are filled up by applying relocations
+  /// (GOT and dynamic relocations) are written out afterwards.
+  bool relocation(FileOutputBuffer& pOutput);
+
   /// postProcessing - do modificatiion after all processes
   bool postProcessing(FileOutputBuffer& pOutput);
 
@@ -147,19 +146,21 @@ public:
   const ObjectWriter*  getWriter () const { return m_pWriter;  }
   ObjectWriter*        getWriter ()       { return m_pWriter;  }
 
+  // -----  threads  ----- //
+  /// getThreadPool - the threads for the parallel phases, --threads=N
+  const ThreadPool&    getThreadPool() const { return *m_pThreadPool; }
+  ThreadPool&          getThreadPool()       { return *m_pThreadPool; }
+
 private:
-  /// normalSyncRelocationResult - sync relocation result when producing shared
-  /// objects or executables
-  void normalSyncRelocationResult(FileOutputBuffer& pOutput);
+  /// readObjects - read the section headers, the independent sections and
+  /// the raw symbol tables of the relocatable objects in the input tree in
+  /// parallel
+  void readObjects();
 
-  /// partialSyncRelocationResult - sync relocation result when doing partial
-  /// link
+  /// partialSyncRelocationResult - add the section offsets to the places of
+  /// Rel entries when doing partial link
   void partialSyncRelocationResult(FileOutputBuffer& pOutput);
 
-  /// writeRelocationResult - helper function of syncRelocationResult, write
-  /// relocation target data to output
-  void writeRelocationResult(Relocation& pReloc, uint8_t* pOutput);
-
   /// addSymbolToOutput - add a symbol to output symbol table if it's not a
   /// section symbol and not defined in the discarded section
   void addSymbolToOutput(ResolveInfo& pInfo, Module& pModule);
@@ -179,6 +180,8 @@ private:
   BinaryReader*  m_pBinaryReader;
   ScriptReader*  m_pScriptReader;
   ObjectWriter*  m_pWriter;
+
+  ThreadPool*    m_pThreadPool;
 };
 
 } // end namespace mcld
@@ -157,8 +157,16 @@ public:
   typedef OutputDescList::reverse_iterator reverse_iterator;
 
 public:
+  SectionMap();
+
   ~SectionMap();
 
+  /// find - find the first input section description which the input
+  /// section pInputSection of the file pInputFile matches.
+  ///
+  /// The descriptions are compiled into a matcher on the first call, and the
+  /// result of each (pInputFile, pInputSection) pair is cached. Inserting a
+  /// new description drops the matcher.
   const_mapping find(const std::string& pInputFile,
                      const std::string& pInputSection) const;
   mapping       find(const std::string& pInputFile,
@@ -198,14 +206,22 @@ public:
   void fixupDotSymbols();
 
 private:
-  bool matched(const Input& pInput,
-               const std::string& pInputFile,
-               const std::string& pInputSection) const;
+  struct Matcher;
+
+  /// getMatcher - get the compiled matcher, and build it if necessary
+  Matcher& getMatcher() const;
+
+  /// invalidate - drop the compiled matcher after the descriptions change
+  void invalidate();
+
+  /// matchedFile - check the file name and the excluded files of pInput
+  bool matchedFile(const Input& pInput, const std::string& pInputFile) const;
 
   bool matched(const WildcardPattern& pPattern, const std::string& pName) const;
 
 private:
   OutputDescList m_OutputDescList;
+  mutable Matcher* m_pMatcher;
 };
 
 } // namespace of mcld
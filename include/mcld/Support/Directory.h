@@ -15,6 +15,7 @@
 #include <mcld/ADT/TypeTraits.h>
 #include <mcld/Support/FileSystem.h>
 #include <mcld/Support/Path.h>
+#include <llvm/ADT/StringRef.h>
 #include <llvm/Support/Allocator.h>
 #include <cstddef>
 
@@ -79,6 +80,12 @@ public:
   FileStatus status() const;
   FileStatus symlinkStatus() const;
 
+  /// find - find the entry named pFileName in the directory. All entries
+  /// are read into the cache at the first call, so the later calls only
+  /// probe the cache.
+  /// @return the path of the entry, or NULL if there is no such entry
+  Path* find(const llvm::StringRef& pFileName);
+
   // -----  iterators  ----- //
   // While the iterators move, the direcotry is modified.
   // Thus, we only provide non-constant iterator.
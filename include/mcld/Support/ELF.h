@@ -27,6 +27,12 @@ enum SHF {
   SHF_MIPS_GPREL = 0x10000000
 }; // enum SHF
 
+// Note types
+enum NT {
+  // The descriptor of the note is the build ID of the file.
+  NT_GNU_BUILD_ID = 3
+}; // enum NT
+
 } // namespace of ELF
 } // namespace of mcld
 
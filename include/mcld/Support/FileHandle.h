@@ -47,6 +47,7 @@ public:
     Append    = 0x04,
     Create    = 0x08,
     Truncate  = 0x10,
+    Exclusive = 0x20,
     Unknown   = 0xFF
   };
 
@@ -91,6 +92,10 @@ public:
   // truncate - truncate the file up to the pSize.
   bool truncate(size_t pSize);
 
+  // allocate - reserve the disk blocks of the file up to the pSize, and
+  // extend the file to the pSize.
+  bool allocate(size_t pSize);
+
   bool read(void* pMemBuffer, size_t pStartOffset, size_t pLength);
 
   bool write(const void* pMemBuffer, size_t pStartOffset, size_t pLength);
@@ -34,24 +34,32 @@ public:
                                  size_t pSize,
                                  llvm::OwningPtr<FileOutputBuffer>& pResult);
 
+  /// Factory method to create an OutputBuffer object which writes into the
+  /// caller's memory pBuffer of pSize bytes. The memory is not owned and must
+  /// outlive the OutputBuffer object.
+  static llvm::error_code create(uint8_t* pBuffer,
+                                 size_t pSize,
+                                 llvm::OwningPtr<FileOutputBuffer>& pResult);
+
   /// Returns a pointer to the start of the buffer.
   uint8_t* getBufferStart() {
-    return (uint8_t*)m_pRegion->data();
+    return m_pBuffer;
   }
 
   /// Returns a pointer to the end of the buffer.
   uint8_t* getBufferEnd() {
-    return (uint8_t*)m_pRegion->data() + m_pRegion->size();
+    return m_pBuffer + m_Size;
   }
 
   /// Returns size of the buffer.
   size_t getBufferSize() const {
-    return m_pRegion->size();
+    return m_Size;
   }
 
   MemoryRegion request(size_t pOffset, size_t pLength);
 
-  /// Returns path where file will show up if buffer is committed.
+  /// Returns path where file will show up if buffer is committed, or an empty
+  /// string if the buffer is in memory.
   llvm::StringRef getPath() const;
 
   ~FileOutputBuffer();
@@ -63,8 +71,12 @@ private:
   FileOutputBuffer(llvm::sys::fs::mapped_file_region* pRegion,
                    FileHandle& pFileHandle);
 
+  FileOutputBuffer(uint8_t* pBuffer, size_t pSize);
+
   llvm::OwningPtr<llvm::sys::fs::mapped_file_region> m_pRegion;
-  FileHandle& m_FileHandle;
+  FileHandle* m_pFileHandle; ///< NULL if the buffer is in memory
+  uint8_t* m_pBuffer;
+  size_t m_Size;
 };
 
 } // namespace mcld
@@ -102,7 +102,15 @@ int open(const Path& pPath, int pOFlag);
 int open(const Path& pPath, int pOFlag, int pPermission);
 ssize_t pread(int pFD, void* pBuf, size_t pCount, off_t pOffset);
 ssize_t pwrite(int pFD, const void* pBuf, size_t pCount, off_t pOffset);
+int close(int pFD);
 int ftruncate(int pFD, size_t pLength);
+int fallocate(int pFD, size_t pLength);
+int rename(const Path& pFrom, const Path& pTo);
+int link(const Path& pFrom, const Path& pTo);
+int unlink(const Path& pPath);
+void unlink_in_background(const Path& pPath);
+void advise_sequential(void* pAddr, size_t pLen);
+int create_memory_file(const std::string& pName);
 void* mmap(void *pAddr, size_t pLen,
            int pProt, int pFlags, int pFD, off_t pOffset);
 int munmap(void *pAddr, size_t pLen);
@@ -0,0 +1,54 @@
+//===- SHA1.h -------------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_SHA1_H
+#define MCLD_SUPPORT_SHA1_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+#include <llvm/Support/DataTypes.h>
+#include <cstddef>
+
+namespace mcld {
+
+/** \class SHA1
+ *  \brief SHA1 computes the SHA-1 message digest (FIPS 180-4) incrementally.
+ */
+class SHA1
+{
+public:
+  enum {
+    DigestSize = 20,
+    BlockSize = 64
+  };
+
+public:
+  SHA1();
+
+  /// update - append pSize bytes at pData to the message
+  void update(const uint8_t* pData, size_t pSize);
+
+  /// final - pad the message and write the digest into pDigest. The object
+  /// can not be updated afterwards.
+  void final(uint8_t pDigest[DigestSize]);
+
+private:
+  /// processBlock - compress one block of BlockSize bytes into m_State
+  void processBlock(const uint8_t* pBlock);
+
+private:
+  uint32_t m_State[5];
+  uint8_t m_Buffer[BlockSize];
+  size_t m_BufferSize;
+  uint64_t m_Length; // the length of the message in bytes
+};
+
+} // namespace of mcld
+
+#endif
+
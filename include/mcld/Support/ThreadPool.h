@@ -0,0 +1,85 @@
+//===- ThreadPool.h -------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_THREADPOOL_H
+#define MCLD_SUPPORT_THREADPOOL_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+#include <mcld/ADT/Uncopyable.h>
+#include <vector>
+
+namespace mcld {
+
+/** \class ThreadPool
+ *  \brief ThreadPool runs batches of independent jobs on a fixed set of
+ *  worker threads.
+ *
+ *  The jobs of a batch are not bound to a thread in advance. Every thread,
+ *  including the one calling run(), keeps taking the next job which is not
+ *  started yet, so threads that finish their jobs early take over the rest of
+ *  the batch instead of idling.
+ *
+ *  A pool of one thread runs the jobs in order on the calling thread.
+ */
+class ThreadPool : private Uncopyable
+{
+public:
+  /** \class Job
+   *  \brief Job is one unit of work in a batch.
+   */
+  class Job
+  {
+  public:
+    virtual ~Job() { }
+
+    virtual void run() = 0;
+  };
+
+  typedef std::vector<Job*> JobList;
+
+public:
+  /// ThreadPool - create a pool of pNumOfThreads threads (the calling thread
+  /// is counted). Zero means the number of online processors.
+  explicit ThreadPool(unsigned int pNumOfThreads);
+
+  ~ThreadPool();
+
+  /// size - the number of threads which run the jobs
+  unsigned int size() const { return m_NumOfThreads; }
+
+  /// isParallel - return true if the jobs may run concurrently
+  bool isParallel() const { return (m_NumOfThreads > 1); }
+
+  /// run - run all jobs in pJobs, and return when all of them are finished.
+  void run(JobList& pJobs);
+
+  /// GetNumOfProcessors - return the number of online processors
+  static unsigned int GetNumOfProcessors();
+
+private:
+  struct Impl;
+
+  /// startWorkers - create the m_NumOfThreads-1 worker threads
+  void startWorkers();
+
+  /// stopWorkers - terminate and join the worker threads
+  void stopWorkers();
+
+  /// runConcurrently - run pJobs on the workers and the calling thread
+  void runConcurrently(JobList& pJobs);
+
+private:
+  unsigned int m_NumOfThreads;
+  Impl* m_pImpl;
+};
+
+} // namespace of mcld
+
+#endif
+
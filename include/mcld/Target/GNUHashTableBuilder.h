@@ -0,0 +1,79 @@
+//===- GNUHashTableBuilder.h ----------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_TARGET_GNUHASHTABLEBUILDER_H
+#define MCLD_TARGET_GNUHASHTABLEBUILDER_H
+#ifdef ENABLE_UNITTEST
+#include <gtest.h>
+#endif
+
+#include <vector>
+#include <stdint.h>
+
+namespace mcld {
+
+/** \class GNUHashTableBuilder
+ *  \brief GNUHashTableBuilder computes the contents of .gnu.hash.
+ *
+ *  The symbols hashed in .gnu.hash must be grouped by bucket in .dynsym.
+ *  build() sorts them by bucket with a counting sort, which keeps the
+ *  .dynsym order inside each bucket, and fills the buckets, the chains and
+ *  the bloom filter in two linear passes over the hash values.
+ */
+class GNUHashTableBuilder
+{
+public:
+  /// @param pNumOfBuckets - number of buckets, nbucket
+  /// @param pMaskBitsLog2 - log2 of the number of bits in the bloom filter
+  /// @param pBitClass     - 32 or 64, the size of a bloom filter word
+  GNUHashTableBuilder(uint32_t pNumOfBuckets,
+                      uint32_t pMaskBitsLog2,
+                      unsigned int pBitClass);
+
+  /// build - compute the table
+  /// @param pHashes - the DJB hash of each hashed symbol, in .dynsym order
+  /// @param pSymIdx - the .dynsym index of the first hashed symbol, symndx
+  void build(const std::vector<uint32_t>& pHashes, uint32_t pSymIdx);
+
+  uint32_t numOfBuckets() const { return m_NumOfBuckets; }
+
+  /// numOfMaskWords - the number of words in the bloom filter, maskwords
+  uint32_t numOfMaskWords() const;
+
+  /// shift2 - the shift count of the second bloom filter bit
+  uint32_t shift2() const { return m_MaskBitsLog2; }
+
+  /// order - order()[i] is the index in pHashes of the symbol which should
+  /// be placed at .dynsym index pSymIdx + i
+  const std::vector<uint32_t>& order() const { return m_Order; }
+
+  /// buckets - the .dynsym index of the first symbol of each bucket, or 0
+  const std::vector<uint32_t>& buckets() const { return m_Buckets; }
+
+  /// chains - the hash values with the lowest bit marking the end of a chain
+  const std::vector<uint32_t>& chains() const { return m_Chains; }
+
+  /// bloom - the bloom filter words. Only the low 32 bits are used for
+  /// ELF32.
+  const std::vector<uint64_t>& bloom() const { return m_Bloom; }
+
+private:
+  uint32_t m_NumOfBuckets;
+  uint32_t m_MaskBitsLog2;
+  unsigned int m_BitClass;
+
+  std::vector<uint32_t> m_Order;
+  std::vector<uint32_t> m_Buckets;
+  std::vector<uint32_t> m_Chains;
+  std::vector<uint64_t> m_Bloom;
+};
+
+} // namespace of mcld
+
+#endif
+
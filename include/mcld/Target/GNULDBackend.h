@@ -29,10 +29,12 @@ class LinkerConfig;
 class IRBuilder;
 class Layout;
 class EhFrameHdr;
+class BuildID;
 class BranchIslandFactory;
 class StubFactory;
 class GNUInfo;
 class ELFFileFormat;
+class RelocData;
 class ELFSegmentFactory;
 class ELFAttribute;
 class ELFDynamic;
@@ -41,6 +43,7 @@ class ELFExecFileFormat;
 class ELFObjectFileFormat;
 class LinkerScript;
 class Relocation;
+class StringTableBuilder;
 
 /** \class GNULDBackend
  *  \brief GNULDBackend provides a common interface for all GNU Unix-OS
@@ -112,6 +115,9 @@ public:
   /// sizeShstrtab - compute the size of .shstrtab
   void sizeShstrtab(Module& pModule);
 
+  /// getShStrTabBuilder - the layout of .shstrtab decided by sizeShstrtab()
+  const StringTableBuilder& getShStrTabBuilder() const { return *m_pShStrTab; }
+
   /// sizeNamePools - compute the size of regular name pools
   /// In ELF executable files, regular name pools are .symtab, .strtab.,
   /// .dynsym, .dynstr, and .hash
@@ -323,10 +329,20 @@ public:
   /// process relocations more efficiently
   void sortRelocation(LDSection& pSection);
 
+  /// isFilledByRelocator - the relocator fills up the GOT entries and the
+  /// dynamic relocation entries
+  virtual bool isFilledByRelocator(const LDSection& pSection) const;
+
   /// createAndSizeEhFrameHdr - This is seperated since we may add eh_frame
   /// entry in the middle
   void createAndSizeEhFrameHdr(Module& pModule);
 
+  /// createAndSizeBuildID - size .note.gnu.build-id, --build-id
+  void createAndSizeBuildID(Module& pModule);
+
+  /// emitBuildID - hash the output and write out .note.gnu.build-id
+  void emitBuildID(FileOutputBuffer& pOutput, ThreadPool& pThreadPool);
+
   /// attribute - the attribute section data.
   ELFAttribute& attribute() { return *m_pAttribute; }
 
@@ -360,19 +376,28 @@ protected:
   unsigned getGNUHashMaskbitslog2(unsigned pNumOfSymbols) const;
 
   /// emitSymbol32 - emit an ELF32 symbol
+  /// @param pStrtabIdx - the offset of the symbol name in the string table
   void emitSymbol32(llvm::ELF::Elf32_Sym& pSym32,
                     LDSymbol& pSymbol,
-                    char* pStrtab,
-                    size_t pStrtabsize,
+                    size_t pStrtabIdx,
                     size_t pSymtabIdx);
 
   /// emitSymbol64 - emit an ELF64 symbol
+  /// @param pStrtabIdx - the offset of the symbol name in the string table
   void emitSymbol64(llvm::ELF::Elf64_Sym& pSym64,
                     LDSymbol& pSymbol,
-                    char* pStrtab,
-                    size_t pStrtabsize,
+                    size_t pStrtabIdx,
                     size_t pSymtabIdx);
 
+  /// getStrtabIdx - get the offset of the symbol name in a string table.
+  /// The names of symbols created after sizeNamePools(), such as stubs, are
+  /// not in pBuilder. They are appended to pStrtab at pStrtabsize, since
+  /// the size of the table is increased when they are created.
+  size_t getStrtabIdx(const StringTableBuilder& pBuilder,
+                      const LDSymbol& pSymbol,
+                      char* pStrtab,
+                      size_t& pStrtabsize) const;
+
 private:
   /// createProgramHdrs - base on output sections to create the program headers
   void createProgramHdrs(Module& pModule);
@@ -392,6 +417,10 @@ private:
   /// setupGNUStackInfo - setup the section flag of .note.GNU-stack in output
   void setupGNUStackInfo(Module& pModule);
 
+  /// sortDynRelocs - sort the dynamic relocations in pRelocData for
+  /// -z combreloc
+  void sortDynRelocs(RelocData& pRelocData) const;
+
   /// setOutputSectionOffset - helper function to set output sections' offset.
   void setOutputSectionOffset(Module& pModule);
 
@@ -472,14 +501,18 @@ protected:
   };
 
   // for -z combreloc
-  struct RelocCompare
+  /// RelocKey - the sort key of a dynamic relocation. The keys are computed
+  /// once per relocation, so sorting them does not look up the symbol
+  /// indices and the places again.
+  struct RelocKey
   {
-    RelocCompare(const GNULDBackend& pBackend)
-      : m_Backend(pBackend) {
-    }
-    bool operator()(const Relocation* X, const Relocation* Y) const;
-  private:
-    const GNULDBackend& m_Backend;
+    uint64_t symIdx; ///< 0 for the relative relocations, otherwise index + 1
+    uint64_t place;
+    uint64_t type;
+    uint64_t addend;
+    Relocation* reloc;
+
+    bool operator<(const RelocKey& pOther) const;
   };
 
   // for gnu style hash table
@@ -534,9 +567,17 @@ protected:
   // map the LDSymbol to its index in the output symbol table
   HashTableType* m_pSymIndexMap;
 
+  // layout of .strtab, .dynstr and .shstrtab
+  StringTableBuilder* m_pStrTab;
+  StringTableBuilder* m_pDynStrTab;
+  StringTableBuilder* m_pShStrTab;
+
   // section .eh_frame_hdr
   EhFrameHdr* m_pEhFrameHdr;
 
+  // section .note.gnu.build-id
+  BuildID* m_pBuildID;
+
   // attribute section
   ELFAttribute* m_pAttribute;
 
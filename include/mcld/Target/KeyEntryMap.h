@@ -12,6 +12,8 @@
 #include <gtest.h>
 #endif
 
+#include <llvm/Support/DataTypes.h>
+
 #include <vector>
 #include <list>
 
@@ -19,6 +21,11 @@ namespace mcld {
 
 /** \class KeyEntryMap
  *  \brief KeyEntryMap is a <const KeyType*, ENTRY*> map.
+ *
+ *  The mappings are kept in the order they are recorded. An open-addressing
+ *  hash table of the key addresses indexes the first mapping of each key, so
+ *  looking up is constant time. The keys of the mappings must not be changed
+ *  through the iterators.
  */
 template<typename KEY, typename ENTRY>
 class KeyEntryMap
@@ -57,6 +64,8 @@ public:
   typedef typename KeyEntryPool::const_iterator const_iterator;
 
 public:
+  KeyEntryMap() : m_NumOfKeys(0) {}
+
   /// lookUp - look up the entry mapping to pKey
   const EntryType* lookUp(const KeyType& pKey) const;
   EntryType*       lookUp(const KeyType& pKey);
@@ -82,97 +91,99 @@ public:
   const_iterator end  () const { return m_Pool.end();   }
   iterator       end  ()       { return m_Pool.end();   }
 
-  void reserve(size_t pSize) { m_Pool.reserve(pSize); }
+  void reserve(size_t pSize);
+
+private:
+  /// find - find the first mapping of pKey
+  const Mapping* find(const KeyType& pKey) const;
+
+  /// index - add the pIdx-th mapping into the hash table, unless its key
+  /// has been there
+  void index(size_t pIdx);
+
+  /// rehash - rebuild the hash table with pNumOfSlots slots
+  void rehash(size_t pNumOfSlots);
+
+  static size_t hash(const KeyType* pKey)
+  {
+    size_t result = reinterpret_cast<uintptr_t>(pKey) >> 3;
+    result ^= result >> 16;
+    return result * 0x9E3779B1u;
+  }
 
 private:
   KeyEntryPool m_Pool;
 
   /// m_Pairs - the EntryPairs
   PairListType m_Pairs;
+
+  /// m_Index - the hash table. A slot is zero if it is empty. Otherwise, it
+  /// is the position of a mapping in m_Pool plus one. The number of slots is
+  /// a power of two.
+  std::vector<size_t> m_Index;
+
+  /// m_NumOfKeys - the number of used slots in m_Index
+  size_t m_NumOfKeys;
 };
 
 template<typename KeyType, typename EntryType>
 const EntryType*
 KeyEntryMap<KeyType, EntryType>::lookUp(const KeyType& pKey) const
 {
-  const_iterator mapping, mEnd = m_Pool.end();
-  for (mapping = m_Pool.begin(); mapping != mEnd; ++mapping) {
-    if (mapping->key == &pKey) {
-      return mapping->entry.entry_ptr;
-    }
-  }
-
-  return NULL;
+  const Mapping* mapping = find(pKey);
+  if (NULL == mapping)
+    return NULL;
+  return mapping->entry.entry_ptr;
 }
 
 template<typename KeyType, typename EntryType>
 EntryType*
 KeyEntryMap<KeyType, EntryType>::lookUp(const KeyType& pKey)
 {
-  iterator mapping, mEnd = m_Pool.end();
-  for (mapping = m_Pool.begin(); mapping != mEnd; ++mapping) {
-    if (mapping->key == &pKey) {
-      return mapping->entry.entry_ptr;
-    }
-  }
-
-  return NULL;
+  const Mapping* mapping = find(pKey);
+  if (NULL == mapping)
+    return NULL;
+  return mapping->entry.entry_ptr;
 }
 
 template<typename KeyType, typename EntryType>
 const EntryType*
 KeyEntryMap<KeyType, EntryType>::lookUpFirstEntry(const KeyType& pKey) const
 {
-  const_iterator mapping, mEnd = m_Pool.end();
-  for (mapping = m_Pool.begin(); mapping != mEnd; ++mapping) {
-    if (mapping->key == &pKey) {
-      return mapping->entry.pair_ptr->entry1;
-    }
-  }
-
-  return NULL;
+  const Mapping* mapping = find(pKey);
+  if (NULL == mapping)
+    return NULL;
+  return mapping->entry.pair_ptr->entry1;
 }
 
 template<typename KeyType, typename EntryType>
 EntryType*
 KeyEntryMap<KeyType, EntryType>::lookUpFirstEntry(const KeyType& pKey)
 {
-  const_iterator mapping, mEnd = m_Pool.end();
-  for (mapping = m_Pool.begin(); mapping != mEnd; ++mapping) {
-    if (mapping->key == &pKey) {
-      return mapping->entry.pair_ptr->entry1;
-    }
-  }
-
-  return NULL;
+  const Mapping* mapping = find(pKey);
+  if (NULL == mapping)
+    return NULL;
+  return mapping->entry.pair_ptr->entry1;
 }
 
 template<typename KeyType, typename EntryType>
 const EntryType*
 KeyEntryMap<KeyType, EntryType>::lookUpSecondEntry(const KeyType& pKey) const
 {
-  const_iterator mapping, mEnd = m_Pool.end();
-  for (mapping = m_Pool.begin(); mapping != mEnd; ++mapping) {
-    if (mapping->key == &pKey) {
-      return mapping->entry.pair_ptr->entry2;
-    }
-  }
-
-  return NULL;
+  const Mapping* mapping = find(pKey);
+  if (NULL == mapping)
+    return NULL;
+  return mapping->entry.pair_ptr->entry2;
 }
 
 template<typename KeyType, typename EntryType>
 EntryType*
 KeyEntryMap<KeyType, EntryType>::lookUpSecondEntry(const KeyType& pKey)
 {
-  const_iterator mapping, mEnd = m_Pool.end();
-  for (mapping = m_Pool.begin(); mapping != mEnd; ++mapping) {
-    if (mapping->key == &pKey) {
-      return mapping->entry.pair_ptr->entry2;
-    }
-  }
-
-  return NULL;
+  const Mapping* mapping = find(pKey);
+  if (NULL == mapping)
+    return NULL;
+  return mapping->entry.pair_ptr->entry2;
 }
 
 template<typename KeyType, typename EntryType>
@@ -183,6 +194,7 @@ KeyEntryMap<KeyType, EntryType>::record(const KeyType& pKey, EntryType& pEntry)
   mapping.key = &pKey;
   mapping.entry.entry_ptr = &pEntry;
   m_Pool.push_back(mapping);
+  index(m_Pool.size() - 1);
 }
 
 template<typename KeyType, typename EntryType>
@@ -196,6 +208,74 @@ KeyEntryMap<KeyType, EntryType>::record(const KeyType& pKey,
   m_Pairs.push_back(EntryPair(&pEntry1, &pEntry2));
   mapping.entry.pair_ptr = &m_Pairs.back();
   m_Pool.push_back(mapping);
+  index(m_Pool.size() - 1);
+}
+
+template<typename KeyType, typename EntryType>
+void KeyEntryMap<KeyType, EntryType>::reserve(size_t pSize)
+{
+  m_Pool.reserve(pSize);
+  size_t num_slots = m_Index.empty() ? 16 : m_Index.size();
+  while (num_slots < 2 * pSize)
+    num_slots <<= 1;
+  if (num_slots != m_Index.size())
+    rehash(num_slots);
+}
+
+template<typename KeyType, typename EntryType>
+const typename KeyEntryMap<KeyType, EntryType>::Mapping*
+KeyEntryMap<KeyType, EntryType>::find(const KeyType& pKey) const
+{
+  if (m_Index.empty())
+    return NULL;
+
+  size_t mask = m_Index.size() - 1;
+  size_t slot = hash(&pKey) & mask;
+  while (0 != m_Index[slot]) {
+    const Mapping& mapping = m_Pool[m_Index[slot] - 1];
+    if (mapping.key == &pKey)
+      return &mapping;
+    slot = (slot + 1) & mask;
+  }
+  return NULL;
+}
+
+template<typename KeyType, typename EntryType>
+void KeyEntryMap<KeyType, EntryType>::index(size_t pIdx)
+{
+  // keep the load factor under one half
+  if (2 * (m_NumOfKeys + 1) > m_Index.size())
+    rehash(m_Index.empty() ? 16 : 2 * m_Index.size());
+
+  const KeyType* key = m_Pool[pIdx].key;
+  size_t mask = m_Index.size() - 1;
+  size_t slot = hash(key) & mask;
+  while (0 != m_Index[slot]) {
+    // the first mapping of a key is found by looking up
+    if (m_Pool[m_Index[slot] - 1].key == key)
+      return;
+    slot = (slot + 1) & mask;
+  }
+  m_Index[slot] = pIdx + 1;
+  ++m_NumOfKeys;
+}
+
+template<typename KeyType, typename EntryType>
+void KeyEntryMap<KeyType, EntryType>::rehash(size_t pNumOfSlots)
+{
+  std::vector<size_t> old_index(pNumOfSlots, 0);
+  m_Index.swap(old_index);
+
+  size_t mask = m_Index.size() - 1;
+  std::vector<size_t>::const_iterator it, itEnd = old_index.end();
+  for (it = old_index.begin(); it != itEnd; ++it) {
+    if (0 == *it)
+      continue;
+    size_t slot = hash(m_Pool[*it - 1].key) & mask;
+    while (0 != m_Index[slot])
+      slot = (slot + 1) & mask;
+    m_Index[slot] = *it;
+  }
 }
 
 } // namespace of mcld
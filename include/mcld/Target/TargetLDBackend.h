@@ -37,6 +37,7 @@ class ObjectWriter;
 class Relocator;
 class SectionData;
 class StubFactory;
+class ThreadPool;
 
 //===----------------------------------------------------------------------===//
 /// TargetLDBackend - Generic interface to target specific assembler backends.
@@ -121,6 +122,12 @@ public:
   virtual void setUpReachedSectionsForGC(const Module& pModule,
         GarbageCollection::SectionReachedListMap& pSectReachedListMap) const { }
 
+  /// isCallRelocation - return true if the relocations of type pType only
+  /// branch to their targets, without taking the addresses. --icf=safe folds
+  /// the sections which are only called.
+  virtual bool isCallRelocation(uint32_t pType) const
+  { return false; }
+
   /// updateSectionFlags - update pTo's flags when merging pFrom
   /// update the output section flags based on input section flags.
   /// FIXME: (Luba) I know ELF need to merge flags, but I'm not sure if
@@ -163,10 +170,23 @@ public:
   /// process relocations more efficiently
   virtual void sortRelocation(LDSection& pSection) = 0;
 
+  /// isFilledByRelocator - return true if the contents of pSection are
+  /// completed by applying relocations, so that pSection is written out after
+  /// the relocations are applied
+  virtual bool isFilledByRelocator(const LDSection& pSection) const = 0;
+
   /// createAndSizeEhFrameHdr - This is seperated since we may add eh_frame
   /// entry in the middle
   virtual void createAndSizeEhFrameHdr(Module& pModule) = 0;
 
+  /// createAndSizeBuildID - size the build ID note, --build-id
+  virtual void createAndSizeBuildID(Module& pModule) = 0;
+
+  /// emitBuildID - compute and write out the build ID note. This is done
+  /// after postProcessing(), since the build ID is a hash of the whole output.
+  virtual void emitBuildID(FileOutputBuffer& pOutput,
+                           ThreadPool& pThreadPool) = 0;
+
 protected:
   const LinkerConfig& config() const { return m_Config; }
 
@@ -55,10 +55,15 @@ GeneralOptions::GeneralOptions()
     m_bNoStdlib(false),
     m_bWarnMismatch(true),
     m_bGCSections(false),
+    m_bTailMergeStrings(false),
     m_bGenUnwindInfo(true),
+    m_bUnlinkOldOutputInBackground(false),
     m_GPSize(8),
+    m_NumOfThreads(1),
     m_StripSymbols(KeepAllSymbols),
-    m_HashStyle(SystemV) {
+    m_ICFMode(ICFNone),
+    m_HashStyle(SystemV),
+    m_BuildIDStyle(NoBuildID) {
 }
 
 GeneralOptions::~GeneralOptions()
@@ -74,6 +79,57 @@ void GeneralOptions::setSOName(const std::string& pName)
     m_SOName = pName.substr(pos + 1);
 }
 
+bool GeneralOptions::setBuildID(const std::string& pStyle)
+{
+  m_BuildIDValue.clear();
+  if (pStyle.empty() || "sha1" == pStyle) {
+    m_BuildIDStyle = SHA1BuildID;
+    return true;
+  }
+  if ("none" == pStyle) {
+    m_BuildIDStyle = NoBuildID;
+    return true;
+  }
+  if ("fast" == pStyle) {
+    m_BuildIDStyle = FastBuildID;
+    return true;
+  }
+  if ("md5" == pStyle) {
+    m_BuildIDStyle = MD5BuildID;
+    return true;
+  }
+  if ("uuid" == pStyle) {
+    m_BuildIDStyle = UUIDBuildID;
+    return true;
+  }
+
+  // 0xHEX, an even number of hexadecimal digits
+  if (pStyle.size() <= 2 || 0 != (pStyle.size() % 2) ||
+      '0' != pStyle[0] || ('x' != pStyle[1] && 'X' != pStyle[1]))
+    return false;
+
+  std::string value;
+  for (size_t i = 2; i < pStyle.size(); i += 2) {
+    unsigned int byte = 0;
+    for (size_t j = i; j < i + 2; ++j) {
+      char digit = pStyle[j];
+      byte <<= 4;
+      if (digit >= '0' && digit <= '9')
+        byte |= digit - '0';
+      else if (digit >= 'a' && digit <= 'f')
+        byte |= digit - 'a' + 10;
+      else if (digit >= 'A' && digit <= 'F')
+        byte |= digit - 'A' + 10;
+      else
+        return false;
+    }
+    value.push_back((char)byte);
+  }
+  m_BuildIDStyle = HexBuildID;
+  m_BuildIDValue = value;
+  return true;
+}
+
 void GeneralOptions::addZOption(const ZOption& pOption)
 {
   switch (pOption.kind()) {
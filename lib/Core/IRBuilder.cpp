@@ -401,7 +401,7 @@ uint64_t IRBuilder::AppendEhFrame(EhFrame::CIE& pCIE, EhFrame& pEhFrame)
 /// AddSymbol - To add a symbol in the input file and resolve the symbol
 /// immediately
 LDSymbol* IRBuilder::AddSymbol(Input& pInput,
-                               const std::string& pName,
+                               const llvm::StringRef& pName,
                                ResolveInfo::Type pType,
                                ResolveInfo::Desc pDesc,
                                ResolveInfo::Binding pBind,
@@ -411,7 +411,7 @@ LDSymbol* IRBuilder::AddSymbol(Input& pInput,
                                ResolveInfo::Visibility pVis)
 {
   // rename symbols
-  std::string name = pName;
+  llvm::StringRef name = pName;
   if (!m_Module.getScript().renameMap().empty() &&
       ResolveInfo::Undefined == pDesc) {
     // If the renameMap is not empty, some symbols should be renamed.
@@ -452,7 +452,7 @@ LDSymbol* IRBuilder::AddSymbol(Input& pInput,
   return NULL;
 }
 
-LDSymbol* IRBuilder::addSymbolFromObject(const std::string& pName,
+LDSymbol* IRBuilder::addSymbolFromObject(const llvm::StringRef& pName,
                                          ResolveInfo::Type pType,
                                          ResolveInfo::Desc pDesc,
                                          ResolveInfo::Binding pBinding,
@@ -528,7 +528,7 @@ LDSymbol* IRBuilder::addSymbolFromObject(const std::string& pName,
 }
 
 LDSymbol* IRBuilder::addSymbolFromDynObj(Input& pInput,
-                                         const std::string& pName,
+                                         const llvm::StringRef& pName,
                                          ResolveInfo::Type pType,
                                          ResolveInfo::Desc pDesc,
                                          ResolveInfo::Binding pBinding,
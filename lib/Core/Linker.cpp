@@ -15,6 +15,8 @@
 #include <mcld/Support/TargetRegistry.h>
 #include <mcld/Support/FileHandle.h>
 #include <mcld/Support/FileOutputBuffer.h>
+#include <mcld/Support/FileSystem.h>
+#include <mcld/Support/SystemUtils.h>
 #include <mcld/Support/raw_ostream.h>
 
 #include <mcld/Object/ObjectLinker.h>
@@ -29,8 +31,11 @@
 #include <mcld/Fragment/FragmentRef.h>
 
 #include <llvm/ADT/OwningPtr.h>
+#include <llvm/ADT/StringExtras.h>
 
 #include <cassert>
+#include <cerrno>
+#include <cstring>
 
 using namespace mcld;
 
@@ -234,9 +239,6 @@ bool Linker::layout()
   // 13. - finalize symbol value
   m_pObjLinker->finalizeSymbolValue();
 
-  // 14. - apply relocations
-  m_pObjLinker->relocation();
-
   if (!Diagnose())
     return false;
   return true;
@@ -244,9 +246,16 @@ bool Linker::layout()
 
 bool Linker::emit(FileOutputBuffer& pOutput)
 {
-  // 15. - write out output
+  // 14. - write out output
   m_pObjLinker->emitOutput(pOutput);
 
+  // 15. - apply relocations straight into the output
+  m_pObjLinker->relocation(pOutput);
+
+  // do not commit an output with broken relocations
+  if (!Diagnose())
+    return false;
+
   // 16. - post processing
   m_pObjLinker->postProcessing(pOutput);
 
@@ -256,6 +265,26 @@ bool Linker::emit(FileOutputBuffer& pOutput)
   return true;
 }
 
+/// OpenTempFile - create a new file named after pPath in the same directory.
+/// The file is not shared with any other link.
+static bool OpenTempFile(const std::string& pPath,
+                         FileHandle::Permission pPerm,
+                         FileHandle& pFile)
+{
+  for (unsigned int retry = 0; retry < 16; ++retry) {
+    std::string temp = pPath + ".tmp" + llvm::utohexstr(sys::GetRandomNum());
+    if (pFile.open(temp,
+                   FileHandle::ReadWrite | FileHandle::Create |
+                   FileHandle::Exclusive,
+                   pPerm))
+      return true;
+    if (EEXIST != pFile.error())
+      return false;
+    pFile.cleanState();
+  }
+  return false;
+}
+
 bool Linker::emit(const Module& pModule, const std::string& pPath)
 {
   FileHandle file;
@@ -273,38 +302,151 @@ bool Linker::emit(const Module& pModule, const std::string& pPath)
     default: assert(0 && "Unknown file type");
   }
 
-  if (!file.open(pPath,
-            FileHandle::ReadWrite | FileHandle::Truncate | FileHandle::Create,
-            perm)) {
+  // Only regular files are replaced. Other outputs, such as /dev/null, are
+  // written in place.
+  sys::fs::FileStatus status;
+  sys::fs::detail::status(pPath, status);
+  if (sys::fs::FileNotFound != status.type() &&
+      sys::fs::RegularFile != status.type())
+    return emitInPlace(pModule, pPath);
+
+  // Write into a temporary file and rename it to pPath at the end, so that
+  // pPath never holds a partial output, even if the link is interrupted.
+  if (!OpenTempFile(pPath, perm, file)) {
     error(diag::err_cannot_open_output_file) << "Linker::emit()" << pPath;
     return false;
   }
+  sys::fs::Path temp = file.path();
 
-  llvm::OwningPtr<FileOutputBuffer> output;
-  FileOutputBuffer::create(file,
-                           m_pObjLinker->getWriter()->getOutputSize(pModule),
-                           output);
-
-  bool result = emit(*output.get());
+  bool result = emitToFile(pModule, file);
   file.close();
-  return result;
+
+  if (!result) {
+    sys::fs::detail::unlink(temp);
+    return false;
+  }
+
+  // Replacing pPath drops the last link of the previous output, and the
+  // kernel then frees its blocks and page cache before rename returns. Keep
+  // it under another name, and unlink that in the background instead.
+  sys::fs::Path old(temp.native() + ".old");
+  bool has_old = m_pConfig->options().unlinkOldOutputInBackground() &&
+                 0 == sys::fs::detail::link(pPath, old);
+
+  if (-1 == sys::fs::detail::rename(temp, pPath)) {
+    int err = errno;
+    error(diag::err_cannot_rename_file) << temp.native() << pPath
+                                        << sys::strerror(err);
+    sys::fs::detail::unlink(temp);
+    if (has_old)
+      sys::fs::detail::unlink(old);
+    return false;
+  }
+
+  if (has_old)
+    sys::fs::detail::unlink_in_background(old);
+  return true;
 }
 
 bool Linker::emit(const Module& pModule, int pFileDescriptor)
 {
   FileHandle file;
-  file.delegate(pFileDescriptor);
+  file.delegate(pFileDescriptor, FileHandle::ReadWrite);
+  return emitToFile(pModule, file);
+}
+
+bool Linker::emit(const Module& pModule, void* pBuffer, size_t pSize)
+{
+  size_t size = getOutputSize(pModule);
+  if (pSize < size) {
+    error(diag::err_output_buffer_too_small) << pSize << size;
+    return false;
+  }
+
+  // Unlike a new file, the memory is not zero-filled. Clear the gaps between
+  // sections.
+  if (0 != size)
+    std::memset(pBuffer, 0x0, size);
+  return emitToMemory(static_cast<uint8_t*>(pBuffer), size);
+}
+
+bool Linker::emit(const Module& pModule, std::vector<uint8_t>& pImage)
+{
+  pImage.assign(getOutputSize(pModule), 0x0);
+  if (pImage.empty())
+    return emitToMemory(NULL, 0);
+  return emitToMemory(&pImage[0], pImage.size());
+}
+
+bool Linker::emitToMemoryFile(const Module& pModule, int& pFileDescriptor)
+{
+  pFileDescriptor = sys::fs::detail::create_memory_file(pModule.name());
+  if (-1 == pFileDescriptor) {
+    int err = errno;
+    error(diag::err_cannot_create_memory_file) << pModule.name()
+                                               << sys::strerror(err);
+    return false;
+  }
+
+  if (!emit(pModule, pFileDescriptor)) {
+    sys::fs::detail::close(pFileDescriptor);
+    pFileDescriptor = -1;
+    return false;
+  }
+  return true;
+}
+
+size_t Linker::getOutputSize(const Module& pModule) const
+{
+  return m_pObjLinker->getWriter()->getOutputSize(pModule);
+}
+
+bool Linker::emitToFile(const Module& pModule, FileHandle& pFile)
+{
+  // Reserve the blocks up front rather than extending a sparse file while
+  // writing through the mapping, and fail early if the disk is full.
+  size_t size = getOutputSize(pModule);
+  if (pFile.size() < size && !pFile.allocate(size)) {
+    error(diag::err_cannot_allocate_file) << pFile.path().native() << size
+                                          << sys::strerror(pFile.error());
+    return false;
+  }
 
   llvm::OwningPtr<FileOutputBuffer> output;
-  FileOutputBuffer::create(file,
-                           m_pObjLinker->getWriter()->getOutputSize(pModule),
-                           output);
+  if (FileOutputBuffer::create(pFile, size, output)) {
+    error(diag::err_cannot_mmap_file) << pFile.path().native() << 0 << size;
+    return false;
+  }
 
-  bool result = emit(*output.get());
+  return emit(*output.get());
+}
 
+bool Linker::emitInPlace(const Module& pModule, const std::string& pPath)
+{
+  FileHandle file;
+  if (!file.open(pPath, FileHandle::WriteOnly | FileHandle::Truncate)) {
+    error(diag::err_cannot_open_output_file) << "Linker::emit()" << pPath;
+    return false;
+  }
+
+  // Devices can not be mapped, so lay out the output in memory first.
+  std::vector<uint8_t> image;
+  bool result = emit(pModule, image);
+  if (result && !image.empty() && !file.write(&image[0], 0, image.size())) {
+    error(diag::err_cannot_write_file) << pPath << 0 << image.size();
+    result = false;
+  }
+  file.close();
   return result;
 }
 
+bool Linker::emitToMemory(uint8_t* pBuffer, size_t pSize)
+{
+  llvm::OwningPtr<FileOutputBuffer> output;
+  FileOutputBuffer::create(pBuffer, pSize, output);
+  return emit(*output.get());
+}
+
 bool Linker::reset()
 {
   m_pConfig = NULL;
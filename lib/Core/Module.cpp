@@ -20,6 +20,38 @@ using namespace mcld;
 
 static GCFactory<Module::AliasList, MCLD_SECTIONS_PER_INPUT> gc_aliaslist_factory;
 
+//===----------------------------------------------------------------------===//
+// Module::SectionTable
+//===----------------------------------------------------------------------===//
+Module::SectionTable::SectionTable()
+  : m_NameIndex(128) {
+}
+
+void Module::SectionTable::push_back(LDSection* pSection)
+{
+  m_Sections.push_back(pSection);
+
+  // the first section of a name is found, as scanning the list does
+  bool exist = false;
+  NameIndex::entry_type* entry = m_NameIndex.insert(pSection->name(), exist);
+  if (!exist)
+    entry->setValue(pSection);
+}
+
+void Module::SectionTable::clear()
+{
+  m_Sections.clear();
+  m_NameIndex.clear();
+}
+
+LDSection* Module::SectionTable::find(const llvm::StringRef& pName) const
+{
+  NameIndex::const_iterator entry = m_NameIndex.find(pName);
+  if (NULL == entry.getEntry())
+    return NULL;
+  return entry.getEntry()->value();
+}
+
 //===----------------------------------------------------------------------===//
 // Module
 //===----------------------------------------------------------------------===//
@@ -35,25 +67,14 @@ Module::~Module()
 {
 }
 
-// Following two functions will be obsolette when we have new section merger.
 LDSection* Module::getSection(const std::string& pName)
 {
-  iterator sect, sectEnd = end();
-  for (sect = begin(); sect != sectEnd; ++sect) {
-    if ((*sect)->name() == pName)
-      return *sect;
-  }
-  return NULL;
+  return m_SectionTable.find(pName);
 }
 
 const LDSection* Module::getSection(const std::string& pName) const
 {
-  const_iterator sect, sectEnd = end();
-  for (sect = begin(); sect != sectEnd; ++sect) {
-    if ((*sect)->name() == pName)
-      return *sect;
-  }
-  return NULL;
+  return m_SectionTable.find(pName);
 }
 
 void Module::CreateAliasList(const ResolveInfo& pSym)
@@ -96,7 +96,13 @@ FragmentRef* FragmentRef::Create(LDSection& pSection, uint64_t pOffset)
     return Null();
   }
 
-  return Create(data->front(), pOffset);
+  // start from the fragment containing pOffset instead of the front
+  uint64_t offset = 0;
+  Fragment* frag = data->findFragment(pOffset, offset);
+  if (NULL == frag)
+    return Null();
+
+  return Create(*frag, offset);
 }
 
 void FragmentRef::Clear()
@@ -0,0 +1,59 @@
+//===- MergedFragment.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/Fragment/MergedFragment.h>
+#include <mcld/LD/SectionData.h>
+
+#include <cassert>
+#include <cstring>
+
+using namespace mcld;
+
+//===----------------------------------------------------------------------===//
+// MergedFragment
+//===----------------------------------------------------------------------===//
+MergedFragment::MergedFragment(SectionData* pSD)
+  : Fragment(Fragment::Merged, pSD), m_Size(0) {
+}
+
+MergedFragment::~MergedFragment()
+{
+}
+
+void MergedFragment::append(llvm::StringRef pData, uint64_t pOffset)
+{
+  assert(pOffset >= m_Size && "pieces overlap");
+  Piece piece;
+  piece.data = pData;
+  piece.offset = pOffset;
+  m_Pieces.push_back(piece);
+  m_Size = pOffset + pData.size();
+
+  // the offsets of the following fragments change
+  if (NULL != getParent())
+    getParent()->invalidateIndex();
+}
+
+void MergedFragment::emit(uint8_t* pBuffer) const
+{
+  uint64_t cur = 0;
+  PieceList::const_iterator piece, pEnd = m_Pieces.end();
+  for (piece = m_Pieces.begin(); piece != pEnd; ++piece) {
+    if (piece->offset > cur)
+      std::memset(pBuffer + cur, 0x0, piece->offset - cur);
+    std::memcpy(pBuffer + piece->offset, piece->data.data(),
+                piece->data.size());
+    cur = piece->offset + piece->data.size();
+  }
+}
+
+size_t MergedFragment::size() const
+{
+  return m_Size;
+}
+
@@ -62,15 +62,13 @@ void Relocation::Destroy(Relocation*& pRelocation)
 // Relocation
 //===----------------------------------------------------------------------===//
 Relocation::Relocation()
-  : m_Type(0x0), m_TargetData(0x0), m_pSymInfo(NULL), m_Addend(0x0) {
+  : m_Type(0x0), m_pSymInfo(NULL), m_Addend(0x0) {
 }
 
 Relocation::Relocation(Relocation::Type pType,
                        FragmentRef* pTargetRef,
-                       Relocation::Address pAddend,
-                       Relocation::DWord pTargetData)
+                       Relocation::Address pAddend)
   : m_Type(pType),
-    m_TargetData(pTargetData),
     m_pSymInfo(NULL),
     m_Addend(pAddend)
 {
@@ -101,7 +99,14 @@ Relocation::Address Relocation::symValue() const
 
 void Relocation::apply(Relocator& pRelocator)
 {
-  Relocator::Result result = pRelocator.applyRelocation(*this);
+  // read the place, apply and write the result back in one go
+  DWord target = pRelocator.readTarget(*this);
+  Relocator::Result result = pRelocator.applyRelocation(*this, target);
+
+  // a NONE relocation, such as the R_ARM_NONE sharing its place with an
+  // R_ARM_PREL31 in .exidx, leaves the place as it is
+  if (0x0 != type())
+    pRelocator.writeTarget(*this, target);
 
   switch (result) {
     case Relocator::OK: {
@@ -29,6 +29,8 @@ Archive::Archive(Input& pInputFile, InputBuilder& pBuilder)
  : m_ArchiveFile(pInputFile),
    m_pInputTree(NULL),
    m_SymbolFactory(32),
+   m_SymbolIndexMap(32),
+   m_UndefCursor(0),
    m_Builder(pBuilder)
 {
   // FIXME: move creation of input tree out of Archive.
@@ -192,6 +194,67 @@ void Archive::addSymbol(const char* pName,
   Symbol* entry = m_SymbolFactory.allocate();
   new (entry) Symbol(pName, pFileOffset, pStatus);
   m_SymTab.push_back(entry);
+
+  // chain the entries of the same name in armap order. The key refers to the
+  // name stored in the symbol, which lives as long as the archive.
+  size_t idx = numOfSymbols() - 1;
+  llvm::StringRef name(entry->name);
+  entry->hash = m_SymbolIndexMap.hash()(name);
+  bool exist;
+  SymbolIndexEntryType* index =
+    m_SymbolIndexMap.insert(name, entry->hash, exist);
+  if (!exist) {
+    index->setValue(idx);
+    entry->next = idx;
+    return;
+  }
+
+  size_t last = index->value();
+  while (m_SymTab[last]->next != last)
+    last = m_SymTab[last]->next;
+  m_SymTab[last]->next = idx;
+  entry->next = idx;
+}
+
+/// findSymbol - find the first symtab entry of the given name
+size_t Archive::findSymbol(const llvm::StringRef& pName) const
+{
+  SymbolIndexMapType::const_iterator it = m_SymbolIndexMap.find(pName);
+  if (it == m_SymbolIndexMap.end())
+    return numOfSymbols();
+  return it.getEntry()->value();
+}
+
+/// findSymbol - find the first symtab entry of the given name and hash value
+size_t Archive::findSymbol(const llvm::StringRef& pName, uint32_t pHash) const
+{
+  SymbolIndexMapType::const_iterator it = m_SymbolIndexMap.find(pName, pHash);
+  if (it == m_SymbolIndexMap.end())
+    return numOfSymbols();
+  return it.getEntry()->value();
+}
+
+/// getNextSymbol - get the next symtab entry of the same name as pSymIdx
+size_t Archive::getNextSymbol(size_t pSymIdx) const
+{
+  assert(pSymIdx < numOfSymbols());
+  size_t next = m_SymTab[pSymIdx]->next;
+  if (next == pSymIdx)
+    return numOfSymbols();
+  return next;
+}
+
+/// getUndefCursor - the position in NamePool::undefs() up to which the
+/// undefined symbols are looked up in this archive
+size_t Archive::getUndefCursor() const
+{
+  return m_UndefCursor;
+}
+
+/// setUndefCursor - set the position in NamePool::undefs()
+void Archive::setUndefCursor(size_t pCursor)
+{
+  m_UndefCursor = pCursor;
 }
 
 /// getSymbolName - get the symbol name with the given index
@@ -201,6 +264,13 @@ const std::string& Archive::getSymbolName(size_t pSymIdx) const
   return m_SymTab[pSymIdx]->name;
 }
 
+/// getSymbolHash - get the DJB hash value of the symbol name
+uint32_t Archive::getSymbolHash(size_t pSymIdx) const
+{
+  assert(pSymIdx < numOfSymbols());
+  return m_SymTab[pSymIdx]->hash;
+}
+
 /// getObjFileOffset - get the file offset that represent a object file
 uint32_t Archive::getObjFileOffset(size_t pSymIdx) const
 {
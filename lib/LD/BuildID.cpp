@@ -0,0 +1,252 @@
+//===- BuildID.cpp --------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/LD/BuildID.h>
+
+#include <mcld/GeneralOptions.h>
+#include <mcld/LD/LDSection.h>
+#include <mcld/Support/ELF.h>
+#include <mcld/Support/FileOutputBuffer.h>
+#include <mcld/Support/SHA1.h>
+#include <mcld/Support/ThreadPool.h>
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/Process.h>
+
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+using namespace mcld;
+
+//===----------------------------------------------------------------------===//
+// Helper Functions
+//===----------------------------------------------------------------------===//
+namespace {
+
+/// the size of namesz, descsz, type and name of the note
+const size_t NoteHeaderSize = 16;
+
+inline uint64_t Mix64(uint64_t pValue)
+{
+  pValue ^= pValue >> 33;
+  pValue *= 0xFF51AFD7ED558CCDULL;
+  pValue ^= pValue >> 33;
+  pValue *= 0xC4CEB9FE1A85EC53ULL;
+  pValue ^= pValue >> 33;
+  return pValue;
+}
+
+/// FastHash - a 64-bit hash which reads the data a word at a time
+void FastHash(const uint8_t* pData, size_t pSize, uint8_t* pDigest)
+{
+  const uint64_t multiplier = 0x9E3779B97F4A7C15ULL;
+  uint64_t hash = 0xCBF29CE484222325ULL ^ (pSize * multiplier);
+
+  size_t idx = 0;
+  for (; idx + 8 <= pSize; idx += 8) {
+    uint64_t word = 0;
+    for (unsigned int byte = 0; byte < 8; ++byte)
+      word |= (uint64_t)pData[idx + byte] << (byte * 8);
+    hash = (hash ^ Mix64(word)) * multiplier;
+  }
+
+  uint64_t tail = 0;
+  for (unsigned int shift = 0; idx < pSize; ++idx, shift += 8)
+    tail |= (uint64_t)pData[idx] << shift;
+  hash = Mix64(hash ^ tail);
+
+  for (unsigned int byte = 0; byte < 8; ++byte)
+    pDigest[byte] = (uint8_t)(hash >> (byte * 8));
+}
+
+/** \class HashJob
+ *  \brief HashJob hashes a range of chunks of the output.
+ */
+class HashJob : public ThreadPool::Job
+{
+public:
+  HashJob(unsigned int pStyle,
+          const uint8_t* pData,
+          size_t pSize,
+          size_t pBegin,
+          size_t pEnd,
+          uint8_t* pDigests)
+    : m_Style(pStyle), m_pData(pData), m_Size(pSize),
+      m_Begin(pBegin), m_End(pEnd), m_pDigests(pDigests) {
+  }
+
+  void run() {
+    size_t digest_size = BuildID::getHashSize(m_Style);
+    for (size_t chunk = m_Begin; chunk < m_End; ++chunk) {
+      size_t offset = chunk * BuildID::ChunkSize;
+      size_t size = m_Size - offset;
+      if (size > BuildID::ChunkSize)
+        size = BuildID::ChunkSize;
+      BuildID::computeHash(m_Style, m_pData + offset, size,
+                           m_pDigests + chunk * digest_size);
+    }
+  }
+
+private:
+  unsigned int m_Style;
+  const uint8_t* m_pData;
+  size_t m_Size;
+  size_t m_Begin;
+  size_t m_End;
+  uint8_t* m_pDigests;
+};
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// BuildID
+//===----------------------------------------------------------------------===//
+BuildID::BuildID(LDSection& pSection,
+                 unsigned int pStyle,
+                 const std::string& pValue)
+  : m_Section(pSection), m_Style(pStyle), m_Value(pValue) {
+}
+
+BuildID::~BuildID()
+{
+}
+
+void BuildID::sizeOutput()
+{
+  m_Section.setSize(NoteHeaderSize + ((digestSize() + 3) & ~(size_t)3));
+}
+
+size_t BuildID::digestSize() const
+{
+  switch (m_Style) {
+    case GeneralOptions::UUIDBuildID:
+      return 16;
+    case GeneralOptions::HexBuildID:
+      return m_Value.size();
+    default:
+      return getHashSize(m_Style);
+  }
+}
+
+void BuildID::emitOutput(FileOutputBuffer& pOutput, ThreadPool& pThreadPool)
+{
+  MemoryRegion region = pOutput.request(m_Section.offset(), m_Section.size());
+  uint8_t* data = region.begin();
+  uint8_t* desc = data + NoteHeaderSize;
+  size_t desc_size = digestSize();
+
+  uint32_t* header = (uint32_t*)data;
+  header[0] = 4;
+  header[1] = desc_size;
+  header[2] = ELF::NT_GNU_BUILD_ID;
+  memcpy(data + 12, "GNU", 4);
+  memset(desc, 0, region.size() - NoteHeaderSize);
+
+  switch (m_Style) {
+    case GeneralOptions::HexBuildID:
+      memcpy(desc, m_Value.data(), desc_size);
+      break;
+    case GeneralOptions::UUIDBuildID: {
+      for (size_t idx = 0; idx < desc_size; ++idx)
+        desc[idx] = (uint8_t)llvm::sys::Process::GetRandomNumber();
+      // version 4 (random), variant 1 (RFC 4122)
+      desc[6] = (desc[6] & 0x0F) | 0x40;
+      desc[8] = (desc[8] & 0x3F) | 0x80;
+      break;
+    }
+    default: {
+      // the note is hashed with a zero build ID
+      uint8_t digest[MaxDigestSize];
+      computeTreeHash(m_Style, pOutput.getBufferStart(),
+                      pOutput.getBufferSize(), digest, pThreadPool);
+      memcpy(desc, digest, desc_size);
+      break;
+    }
+  }
+}
+
+void BuildID::computeTreeHash(unsigned int pStyle,
+                              const uint8_t* pData,
+                              size_t pSize,
+                              uint8_t* pDigest,
+                              ThreadPool& pThreadPool)
+{
+  size_t digest_size = getHashSize(pStyle);
+  size_t num_chunks = (pSize + ChunkSize - 1) / ChunkSize;
+  std::vector<uint8_t> digests(num_chunks * digest_size);
+
+  // a few chunks per job, so that early finishers can take over the rest
+  size_t num_jobs = pThreadPool.size() * 4;
+  size_t chunks_per_job = (num_chunks + num_jobs - 1) / num_jobs;
+  if (0 == chunks_per_job)
+    chunks_per_job = 1;
+
+  std::vector<HashJob*> jobs;
+  ThreadPool::JobList job_list;
+  for (size_t begin = 0; begin < num_chunks; begin += chunks_per_job) {
+    size_t end = begin + chunks_per_job;
+    if (end > num_chunks)
+      end = num_chunks;
+    jobs.push_back(new HashJob(pStyle, pData, pSize, begin, end,
+                               &digests[0]));
+    job_list.push_back(jobs.back());
+  }
+  pThreadPool.run(job_list);
+  for (size_t i = 0; i < jobs.size(); ++i)
+    delete jobs[i];
+
+  // the root: the hash of the chunk digests in order
+  computeHash(pStyle, digests.empty() ? NULL : &digests[0], digests.size(),
+              pDigest);
+}
+
+void BuildID::computeHash(unsigned int pStyle,
+                          const uint8_t* pData,
+                          size_t pSize,
+                          uint8_t* pDigest)
+{
+  switch (pStyle) {
+    case GeneralOptions::FastBuildID:
+      FastHash(pData, pSize, pDigest);
+      break;
+    case GeneralOptions::MD5BuildID: {
+      llvm::MD5 hasher;
+      hasher.update(llvm::ArrayRef<uint8_t>(pData, pSize));
+      llvm::MD5::MD5Result result;
+      hasher.final(result);
+      memcpy(pDigest, &result, 16);
+      break;
+    }
+    case GeneralOptions::SHA1BuildID: {
+      SHA1 hasher;
+      hasher.update(pData, pSize);
+      hasher.final(pDigest);
+      break;
+    }
+    default:
+      assert(false && "not a hashing style of build ID");
+      break;
+  }
+}
+
+size_t BuildID::getHashSize(unsigned int pStyle)
+{
+  switch (pStyle) {
+    case GeneralOptions::FastBuildID:
+      return 8;
+    case GeneralOptions::MD5BuildID:
+      return 16;
+    case GeneralOptions::SHA1BuildID:
+      return SHA1::DigestSize;
+    default:
+      return 0;
+  }
+}
+
@@ -63,12 +63,15 @@ bool DiagnosticEngine::emit()
   assert(NULL != m_pInfoMap);
   bool emitted = m_pInfoMap->process(*this);
   m_State.reset();
+  m_Mutex.release();
   return emitted;
 }
 
 MsgHandler
 DiagnosticEngine::report(uint16_t pID, DiagnosticEngine::Severity pSeverity)
 {
+  // unlocked by emit()
+  m_Mutex.acquire();
   m_State.ID = pID;
   m_State.severity = pSeverity;
 
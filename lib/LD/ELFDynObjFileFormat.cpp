@@ -82,6 +82,11 @@ void ELFDynObjFileFormat::initObjectFormat(ObjectBuilder& pBuilder,
                                            llvm::ELF::SHT_PROGBITS,
                                            llvm::ELF::SHF_ALLOC,
                                            0x4);
+  f_pNoteGNUBuildID = pBuilder.CreateSection(".note.gnu.build-id",
+                                             LDFileFormat::Note,
+                                             llvm::ELF::SHT_NOTE,
+                                             llvm::ELF::SHF_ALLOC,
+                                             0x4);
   f_pGNUHashTab   = pBuilder.CreateSection(".gnu.hash",
                                            LDFileFormat::NamePool,
                                            llvm::ELF::SHT_GNU_HASH,
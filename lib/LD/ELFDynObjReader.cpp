@@ -10,7 +10,10 @@
 
 #include <mcld/LinkerConfig.h>
 #include <mcld/IRBuilder.h>
+#include <mcld/Module.h>
+#include <mcld/ADT/SizeTraits.h>
 #include <mcld/LD/ELFReader.h>
+#include <mcld/LD/NamePool.h>
 #include <mcld/MC/Input.h>
 #include <mcld/Target/GNULDBackend.h>
 #include <mcld/Support/MemoryArea.h>
@@ -19,11 +22,409 @@
 #include <llvm/ADT/Twine.h>
 #include <llvm/ADT/OwningPtr.h>
 #include <llvm/Support/ErrorHandling.h>
+#include <llvm/Support/Host.h>
 
+#include <algorithm>
+#include <cstring>
 #include <string>
+#include <vector>
 
 using namespace mcld;
 
+namespace {
+
+/// GNUHash - the hash function of .gnu.hash
+uint32_t GNUHash(const llvm::StringRef& pName)
+{
+  uint32_t hash = 5381;
+  for (size_t i = 0; i < pName.size(); ++i)
+    hash = (hash << 5) + hash + static_cast<unsigned char>(pName[i]);
+  return hash;
+}
+
+uint32_t Read32(const char* pAddr)
+{
+  uint32_t result;
+  memcpy(&result, pAddr, sizeof(result));
+  if (!llvm::sys::IsLittleEndianHost)
+    result = mcld::bswap32(result);
+  return result;
+}
+
+uint64_t Read64(const char* pAddr)
+{
+  uint64_t result;
+  memcpy(&result, pAddr, sizeof(result));
+  if (!llvm::sys::IsLittleEndianHost)
+    result = mcld::bswap64(result);
+  return result;
+}
+
+/// IndexLess - order the alias candidates by their .dynsym index
+struct IndexLess
+{
+  bool operator()(const std::pair<uint64_t, size_t>& pX, size_t pIdx) const
+  { return pX.second < pIdx; }
+};
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// ELFDynObjReader::LazySymbols
+//===----------------------------------------------------------------------===//
+/** \class ELFDynObjReader::LazySymbols
+ *  \brief LazySymbols defers the definitions of shared objects.
+ *
+ *  A shared object usually defines thousands of symbols, and only a few of
+ *  them are referred to by a link. LazySymbols keeps the .dynsym and the
+ *  .gnu.hash of every shared object as an index, and only reads the
+ *  definitions which the NamePool already has when the shared object is
+ *  read. The other definitions are read by load() when their names are
+ *  inserted into or looked up in the NamePool for the first time, before the
+ *  name itself, so every name sees the same sequence of resolutions as if
+ *  all symbols had been read eagerly.
+ *
+ *  Copy relocations copy a data object together with its weak aliases, so a
+ *  data object is always read together with the other data objects which
+ *  have the same value in its shared object.
+ */
+class ELFDynObjReader::LazySymbols : public NamePool::Loader
+{
+public:
+  LazySymbols(const ELFReaderIF& pReader,
+              IRBuilder& pBuilder,
+              unsigned int pBitClass);
+
+  ~LazySymbols();
+
+  /// add - index a shared object and read its symbols that are referred to
+  /// @return false if the shared object can not be read lazily, e.g., it has
+  /// no .gnu.hash. Nothing is read in that case.
+  bool add(Input& pInput,
+           llvm::StringRef pSymTab,
+           llvm::StringRef pStrTab);
+
+  /// load - read the deferred definitions named pName
+  void load(const llvm::StringRef& pName);
+
+private:
+  struct DynObj
+  {
+    Input* input;
+    llvm::StringRef symtab;
+    llvm::StringRef strtab;
+    size_t entsize;
+    size_t numOfSyms;
+
+    // .gnu.hash
+    uint32_t numOfBuckets;
+    uint32_t symOffset;
+    uint32_t numOfMaskWords;
+    uint32_t shift2;
+    const char* bloom;
+    const char* buckets;
+    const char* chains;
+
+    /// loaded[i] is true if the symbol symOffset + i has been read
+    std::vector<bool> loaded;
+
+    /// the potential weak aliases by index and by value, built on demand
+    bool hasCandidates;
+    ELFReaderIF::AliasCandidateList byIndex;
+    ELFReaderIF::AliasCandidateList byValue;
+  };
+
+  typedef std::vector<DynObj*> DynObjList;
+  typedef std::vector<llvm::StringRef> NameList;
+  typedef std::vector<std::vector<size_t> > IndexLists;
+
+private:
+  /// getName - the name of the symbol pIdx of pObj
+  llvm::StringRef getName(const DynObj& pObj, size_t pIdx) const;
+
+  /// lookUp - find the symbols of pObj named pName in the .gnu.hash
+  void lookUp(const DynObj& pObj,
+              const llvm::StringRef& pName,
+              uint32_t pHash,
+              std::vector<size_t>& pResult) const;
+
+  bool isLoaded(const DynObj& pObj, size_t pIdx) const
+  { return (pIdx < pObj.symOffset) || pObj.loaded[pIdx - pObj.symOffset]; }
+
+  /// isPending - does any shared object have a deferred symbol of pName?
+  bool isPending(const llvm::StringRef& pName) const;
+
+  /// take - mark the symbol pIdx of the pObjIdx-th shared object to be read,
+  /// and its weak aliases as well
+  void take(size_t pObjIdx, size_t pIdx, NameList& pNames,
+            IndexLists& pIndices);
+
+  /// takeAliases - mark the weak aliases of the symbol pIdx to be read. The
+  /// names of the aliases are appended to pNames.
+  void takeAliases(size_t pObjIdx, size_t pIdx, NameList& pNames,
+                   IndexLists& pIndices);
+
+  /// collect - take the deferred symbols of pNames from all shared objects.
+  /// pNames grows with the names of the aliases.
+  void collect(NameList& pNames, IndexLists& pIndices);
+
+  /// read - read the taken symbols in the order of the shared objects
+  void read(IndexLists& pIndices);
+
+private:
+  const ELFReaderIF& m_Reader;
+  IRBuilder& m_Builder;
+  Module& m_Module;
+  unsigned int m_BitClass;
+  DynObjList m_DynObjs;
+};
+
+ELFDynObjReader::LazySymbols::LazySymbols(const ELFReaderIF& pReader,
+                                          IRBuilder& pBuilder,
+                                          unsigned int pBitClass)
+  : m_Reader(pReader), m_Builder(pBuilder), m_Module(pBuilder.getModule()),
+    m_BitClass(pBitClass) {
+}
+
+ELFDynObjReader::LazySymbols::~LazySymbols()
+{
+  if (this == m_Module.getNamePool().getLoader())
+    m_Module.getNamePool().setLoader(NULL);
+
+  DynObjList::iterator obj, objEnd = m_DynObjs.end();
+  for (obj = m_DynObjs.begin(); obj != objEnd; ++obj)
+    delete *obj;
+}
+
+bool ELFDynObjReader::LazySymbols::add(Input& pInput,
+                                       llvm::StringRef pSymTab,
+                                       llvm::StringRef pStrTab)
+{
+  LDSection* hash_shdr = pInput.context()->getSection(".gnu.hash");
+  if (NULL == hash_shdr || hash_shdr->size() < 16)
+    return false;
+
+  llvm::StringRef hash_region = pInput.memArea()->request(
+      pInput.fileOffset() + hash_shdr->offset(), hash_shdr->size());
+
+  DynObj* obj = new DynObj();
+  obj->input = &pInput;
+  obj->symtab = pSymTab;
+  obj->strtab = pStrTab;
+  obj->entsize = (64 == m_BitClass) ? sizeof(llvm::ELF::Elf64_Sym) :
+                                      sizeof(llvm::ELF::Elf32_Sym);
+  obj->numOfSyms = pSymTab.size() / obj->entsize;
+  obj->numOfBuckets = Read32(hash_region.begin());
+  obj->symOffset = Read32(hash_region.begin() + 4);
+  obj->numOfMaskWords = Read32(hash_region.begin() + 8);
+  obj->shift2 = Read32(hash_region.begin() + 12);
+  obj->hasCandidates = false;
+
+  // the chains must cover the hashed symbols of .dynsym
+  uint64_t bloom_size = uint64_t(obj->numOfMaskWords) * (m_BitClass / 8);
+  uint64_t table_size = 16 + bloom_size + uint64_t(obj->numOfBuckets) * 4;
+  if (0 == obj->numOfBuckets || 0 == obj->numOfMaskWords ||
+      0 == obj->symOffset || obj->symOffset > obj->numOfSyms ||
+      table_size + (obj->numOfSyms - obj->symOffset) * 4 > hash_region.size()) {
+    delete obj;
+    return false;
+  }
+  obj->bloom = hash_region.begin() + 16;
+  obj->buckets = obj->bloom + bloom_size;
+  obj->chains = obj->buckets + uint64_t(obj->numOfBuckets) * 4;
+  obj->loaded.resize(obj->numOfSyms - obj->symOffset, false);
+
+  size_t obj_idx = m_DynObjs.size();
+  m_DynObjs.push_back(obj);
+  m_Module.getNamePool().setLoader(this);
+
+  // skip the first NULL symbol
+  pInput.context()->addSymbol(LDSymbol::Null());
+
+  // the symbols out of .gnu.hash, such as undefined references, are read
+  // eagerly
+  NameList names;
+  IndexLists indices(m_DynObjs.size());
+  for (size_t idx = 1; idx < obj->symOffset; ++idx)
+    indices[obj_idx].push_back(idx);
+
+  ELFReaderIF::AliasCandidateList unhashed;
+  m_Reader.readAliasCandidates(pSymTab, 1, obj->symOffset, unhashed);
+  for (size_t i = 0; i < unhashed.size(); ++i)
+    takeAliases(obj_idx, unhashed[i].second, names, indices);
+
+  // the definitions whose names are already referred to. Visit the smaller
+  // one of the NamePool and the .dynsym.
+  const NamePool& pool = m_Module.getNamePool();
+  if (pool.size() < obj->loaded.size()) {
+    std::vector<size_t> found;
+    NamePool::const_syminfo_iterator info, infoEnd = pool.syminfo_end();
+    for (info = pool.syminfo_begin(); info != infoEnd; ++info) {
+      const ResolveInfo* entry = info.getEntry();
+      if (!entry->isSymbol())
+        continue;
+      llvm::StringRef name(entry->name(), entry->nameSize());
+      found.clear();
+      lookUp(*obj, name, GNUHash(name), found);
+      for (size_t i = 0; i < found.size(); ++i)
+        take(obj_idx, found[i], names, indices);
+    }
+  }
+  else {
+    for (size_t idx = obj->symOffset; idx < obj->numOfSyms; ++idx) {
+      const ResolveInfo* entry = pool.findInfo(getName(*obj, idx));
+      if (NULL != entry && entry->isSymbol())
+        take(obj_idx, idx, names, indices);
+    }
+  }
+
+  collect(names, indices);
+  read(indices);
+  return true;
+}
+
+void ELFDynObjReader::LazySymbols::load(const llvm::StringRef& pName)
+{
+  // most names are not defined in any shared object
+  if (!isPending(pName))
+    return;
+
+  NameList names(1, pName);
+  IndexLists indices(m_DynObjs.size());
+  collect(names, indices);
+  read(indices);
+}
+
+llvm::StringRef
+ELFDynObjReader::LazySymbols::getName(const DynObj& pObj, size_t pIdx) const
+{
+  // st_name is the first member of both Elf32_Sym and Elf64_Sym
+  uint32_t st_name = Read32(pObj.symtab.begin() + pIdx * pObj.entsize);
+  if (st_name >= pObj.strtab.size())
+    return llvm::StringRef();
+  return llvm::StringRef(pObj.strtab.begin() + st_name);
+}
+
+void ELFDynObjReader::LazySymbols::lookUp(const DynObj& pObj,
+                                          const llvm::StringRef& pName,
+                                          uint32_t pHash,
+                                          std::vector<size_t>& pResult) const
+{
+  // the bloom filter rejects most of the names not defined in pObj
+  uint32_t word_idx = (pHash / m_BitClass) % pObj.numOfMaskWords;
+  uint64_t mask = (uint64_t(1) << (pHash % m_BitClass)) |
+                  (uint64_t(1) << ((pHash >> pObj.shift2) % m_BitClass));
+  uint64_t word = (64 == m_BitClass) ? Read64(pObj.bloom + word_idx * 8) :
+                                       Read32(pObj.bloom + word_idx * 4);
+  if ((word & mask) != mask)
+    return;
+
+  uint32_t idx = Read32(pObj.buckets + (pHash % pObj.numOfBuckets) * 4);
+  if (idx < pObj.symOffset)
+    return;
+
+  // the symbols of a bucket are consecutive, and the lowest bit of the
+  // chain value marks the last one
+  for (; idx < pObj.numOfSyms; ++idx) {
+    uint32_t chain = Read32(pObj.chains + (idx - pObj.symOffset) * 4);
+    if ((chain | 1) == (pHash | 1) && getName(pObj, idx) == pName)
+      pResult.push_back(idx);
+    if (chain & 1)
+      break;
+  }
+}
+
+bool ELFDynObjReader::LazySymbols::isPending(const llvm::StringRef& pName) const
+{
+  uint32_t hash = GNUHash(pName);
+  std::vector<size_t> found;
+  DynObjList::const_iterator obj, objEnd = m_DynObjs.end();
+  for (obj = m_DynObjs.begin(); obj != objEnd; ++obj) {
+    found.clear();
+    lookUp(**obj, pName, hash, found);
+    for (size_t i = 0; i < found.size(); ++i) {
+      if (!isLoaded(**obj, found[i]))
+        return true;
+    }
+  }
+  return false;
+}
+
+void ELFDynObjReader::LazySymbols::take(size_t pObjIdx,
+                                        size_t pIdx,
+                                        NameList& pNames,
+                                        IndexLists& pIndices)
+{
+  DynObj& obj = *m_DynObjs[pObjIdx];
+  if (isLoaded(obj, pIdx))
+    return;
+  obj.loaded[pIdx - obj.symOffset] = true;
+  pIndices[pObjIdx].push_back(pIdx);
+  takeAliases(pObjIdx, pIdx, pNames, pIndices);
+}
+
+void ELFDynObjReader::LazySymbols::takeAliases(size_t pObjIdx,
+                                               size_t pIdx,
+                                               NameList& pNames,
+                                               IndexLists& pIndices)
+{
+  DynObj& obj = *m_DynObjs[pObjIdx];
+  if (!obj.hasCandidates) {
+    m_Reader.readAliasCandidates(obj.symtab, 1, obj.numOfSyms, obj.byIndex);
+    obj.byValue = obj.byIndex;
+    std::sort(obj.byValue.begin(), obj.byValue.end());
+    obj.hasCandidates = true;
+  }
+
+  ELFReaderIF::AliasCandidateList::iterator cand =
+      std::lower_bound(obj.byIndex.begin(), obj.byIndex.end(), pIdx,
+                       IndexLess());
+  if (cand == obj.byIndex.end() || cand->second != pIdx)
+    return;
+
+  // the candidates which have the same value
+  ELFReaderIF::AliasCandidateList::iterator alias =
+      std::lower_bound(obj.byValue.begin(), obj.byValue.end(),
+                       std::make_pair(cand->first, size_t(0)));
+  for (; alias != obj.byValue.end() && alias->first == cand->first; ++alias) {
+    if (isLoaded(obj, alias->second))
+      continue;
+    obj.loaded[alias->second - obj.symOffset] = true;
+    pIndices[pObjIdx].push_back(alias->second);
+    pNames.push_back(getName(obj, alias->second));
+  }
+}
+
+void ELFDynObjReader::LazySymbols::collect(NameList& pNames,
+                                           IndexLists& pIndices)
+{
+  std::vector<size_t> found;
+  // pNames grows in the loop
+  for (size_t i = 0; i < pNames.size(); ++i) {
+    llvm::StringRef name = pNames[i];
+    uint32_t hash = GNUHash(name);
+    for (size_t obj_idx = 0; obj_idx < m_DynObjs.size(); ++obj_idx) {
+      found.clear();
+      lookUp(*m_DynObjs[obj_idx], name, hash, found);
+      for (size_t j = 0; j < found.size(); ++j)
+        take(obj_idx, found[j], pNames, pIndices);
+    }
+  }
+}
+
+void ELFDynObjReader::LazySymbols::read(IndexLists& pIndices)
+{
+  for (size_t obj_idx = 0; obj_idx < pIndices.size(); ++obj_idx) {
+    std::vector<size_t>& indices = pIndices[obj_idx];
+    if (indices.empty())
+      continue;
+    std::sort(indices.begin(), indices.end());
+    DynObj& obj = *m_DynObjs[obj_idx];
+    m_Reader.readSymbols(*obj.input, m_Builder, obj.symtab,
+                         obj.strtab.begin(), indices);
+  }
+}
+
 //===----------------------------------------------------------------------===//
 // ELFDynObjReader
 //===----------------------------------------------------------------------===//
@@ -32,15 +433,22 @@ ELFDynObjReader::ELFDynObjReader(GNULDBackend& pBackend,
                                  const LinkerConfig& pConfig)
   : DynObjReader(),
     m_pELFReader(0),
-    m_Builder(pBuilder) {
+    m_Builder(pBuilder),
+    m_pLazySymbols(NULL) {
   if (pConfig.targets().is32Bits() && pConfig.targets().isLittleEndian())
     m_pELFReader = new ELFReader<32, true>(pBackend);
   else if (pConfig.targets().is64Bits() && pConfig.targets().isLittleEndian())
     m_pELFReader = new ELFReader<64, true>(pBackend);
+
+  // --export-dynamic keeps reading all symbols of shared objects
+  if (NULL != m_pELFReader && !pConfig.options().exportDynamic())
+    m_pLazySymbols = new LazySymbols(*m_pELFReader, m_Builder,
+                                     pConfig.targets().bitclass());
 }
 
 ELFDynObjReader::~ELFDynObjReader()
 {
+  delete m_pLazySymbols;
   delete m_pELFReader;
 }
 
@@ -120,6 +528,11 @@ bool ELFDynObjReader::readSymbols(Input& pInput)
 
   llvm::StringRef strtab_region = pInput.memArea()->request(
       pInput.fileOffset() + strtab_shdr->offset(), strtab_shdr->size());
+  // read the definitions on demand if the shared object has .gnu.hash
+  if (NULL != m_pLazySymbols &&
+      m_pLazySymbols->add(pInput, symtab_region, strtab_region))
+    return true;
+
   const char* strtab = strtab_region.begin();
   bool result = m_pELFReader->readSymbols(pInput, m_Builder,
                                           symtab_region, strtab);
@@ -55,6 +55,7 @@ ELFFileFormat::ELFFileFormat()
     f_pGOTPLT(NULL),
     f_pJCR(NULL),
     f_pNoteABITag(NULL),
+    f_pNoteGNUBuildID(NULL),
     f_pStab(NULL),
     f_pStabStr(NULL),
     f_pStack(NULL),
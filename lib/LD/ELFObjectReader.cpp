@@ -21,12 +21,28 @@
 #include <llvm/Support/ELF.h>
 #include <llvm/ADT/Twine.h>
 #include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Mutex.h>
 
+#include <map>
 #include <string>
+#include <vector>
 #include <cassert>
 
 using namespace mcld;
 
+//===----------------------------------------------------------------------===//
+// ELFObjectReader::RawSymbolMap
+//===----------------------------------------------------------------------===//
+/// RawSymbolMap - the symbol tables decoded by readRawSymbols(), kept until
+/// readSymbols() consumes them
+struct ELFObjectReader::RawSymbolMap
+{
+  typedef std::map<const Input*, ELFReaderIF::RawSymbolTable*> TableMap;
+
+  TableMap tables;
+  llvm::sys::Mutex lock;
+};
+
 //===----------------------------------------------------------------------===//
 // ELFObjectReader
 //===----------------------------------------------------------------------===//
@@ -40,7 +56,8 @@ ELFObjectReader::ELFObjectReader(GNULDBackend& pBackend,
     m_Builder(pBuilder),
     m_ReadFlag(ParseEhFrame),
     m_Backend(pBackend),
-    m_Config(pConfig) {
+    m_Config(pConfig),
+    m_pRawSymbols(new RawSymbolMap()) {
   if (pConfig.targets().is32Bits() && pConfig.targets().isLittleEndian()) {
     m_pELFReader = new ELFReader<32, true>(pBackend);
   }
@@ -56,6 +73,11 @@ ELFObjectReader::~ELFObjectReader()
 {
   delete m_pELFReader;
   delete m_pEhFrameReader;
+
+  RawSymbolMap::TableMap::iterator table, tEnd = m_pRawSymbols->tables.end();
+  for (table = m_pRawSymbols->tables.begin(); table != tEnd; ++table)
+    delete table->second;
+  delete m_pRawSymbols;
 }
 
 /// isMyFormat
@@ -95,6 +117,11 @@ bool ELFObjectReader::readHeader(Input& pInput)
 {
   assert(pInput.hasMemArea());
 
+  // the headers have already been read, e.g., by the parallel pre-pass of
+  // ObjectLinker::normalize()
+  if (0 != pInput.context()->numOfSections())
+    return true;
+
   size_t hdr_size = m_pELFReader->getELFHeaderSize();
   if (pInput.memArea()->size() < hdr_size)
     return false;
@@ -106,6 +133,64 @@ bool ELFObjectReader::readHeader(Input& pInput)
   return result;
 }
 
+/// readSectionData - read the regular, debug and BSS sections that are not
+/// members of any group. Whether a group member is kept depends on the groups
+/// of the other inputs, so readSections() handles them in the link order.
+bool ELFObjectReader::readSectionData(Input& pInput)
+{
+  assert(pInput.hasMemArea());
+
+  // mark the members of all groups
+  LDContext* context = pInput.context();
+  std::vector<bool> in_group(context->numOfSections(), false);
+  for (size_t idx = 0; idx < context->numOfSections(); ++idx) {
+    LDSection* section = context->getSection(idx);
+    if (NULL == section || LDFileFormat::Group != section->kind())
+      continue;
+
+    llvm::StringRef region = pInput.memArea()->request(
+        pInput.fileOffset() + section->offset(), section->size());
+    const llvm::ELF::Elf32_Word* value =
+        reinterpret_cast<const llvm::ELF::Elf32_Word*>(region.begin());
+
+    size_t size = region.size() / sizeof(llvm::ELF::Elf32_Word);
+    for (size_t index = 1; index < size; ++index) {
+      if (value[index] < in_group.size())
+        in_group[value[index]] = true;
+    }
+  }
+
+  for (size_t idx = 0; idx < context->numOfSections(); ++idx) {
+    LDSection* section = context->getSection(idx);
+    if (NULL == section || in_group[idx])
+      continue;
+
+    switch (section->kind()) {
+      case LDFileFormat::Debug:
+        // readSections() ignores the stripped debug sections in order
+        if (m_Config.options().stripDebug())
+          break;
+      /** Fall through **/
+      case LDFileFormat::Version:
+      case LDFileFormat::GCCExceptTable:
+      case LDFileFormat::Regular:
+      case LDFileFormat::Note:
+      case LDFileFormat::MetaData: {
+        SectionData* sd = IRBuilder::CreateSectionData(*section);
+        if (!m_pELFReader->readRegularSection(pInput, *sd))
+          fatal(diag::err_cannot_read_section) << section->name();
+        break;
+      }
+      case LDFileFormat::BSS:
+        IRBuilder::CreateBSS(*section);
+        break;
+      default:
+        break;
+    }
+  }
+  return true;
+}
+
 /// readSections - read all regular sections.
 bool ELFObjectReader::readSections(Input& pInput)
 {
@@ -202,12 +287,17 @@ bool ELFObjectReader::readSections(Input& pInput)
       case LDFileFormat::Regular:
       case LDFileFormat::Note:
       case LDFileFormat::MetaData: {
+        // already read by readSectionData()
+        if ((*section)->hasSectionData())
+          break;
         SectionData* sd = IRBuilder::CreateSectionData(**section);
         if (!m_pELFReader->readRegularSection(pInput, *sd))
           fatal(diag::err_cannot_read_section) << (*section)->name();
         break;
       }
       case LDFileFormat::Debug: {
+        if ((*section)->hasSectionData())
+          break;
         if (m_Config.options().stripDebug()) {
           (*section)->setKind(LDFileFormat::Ignore);
         }
@@ -249,7 +339,8 @@ bool ELFObjectReader::readSections(Input& pInput)
       }
       /** BSS sections **/
       case LDFileFormat::BSS: {
-        IRBuilder::CreateBSS(**section);
+        if (!(*section)->hasSectionData())
+          IRBuilder::CreateBSS(**section);
         break;
       }
       // ignore
@@ -293,6 +384,23 @@ bool ELFObjectReader::readSymbols(Input& pInput)
     return false;
   }
 
+  // use the table decoded by readRawSymbols() if there is one
+  ELFReaderIF::RawSymbolTable* table = NULL;
+  {
+    llvm::sys::ScopedLock lock(m_pRawSymbols->lock);
+    RawSymbolMap::TableMap::iterator it = m_pRawSymbols->tables.find(&pInput);
+    if (m_pRawSymbols->tables.end() != it) {
+      table = it->second;
+      m_pRawSymbols->tables.erase(it);
+    }
+  }
+
+  if (NULL != table) {
+    bool result = m_pELFReader->readSymbols(pInput, m_Builder, *table);
+    delete table;
+    return result;
+  }
+
   llvm::StringRef symtab_region = pInput.memArea()->request(
       pInput.fileOffset() + symtab_shdr->offset(), symtab_shdr->size());
   llvm::StringRef strtab_region = pInput.memArea()->request(
@@ -305,6 +413,32 @@ bool ELFObjectReader::readSymbols(Input& pInput)
   return result;
 }
 
+/// readRawSymbols - decode the symbol table of the input relocatable object.
+/// The missing tables are diagnosed by readSymbols().
+bool ELFObjectReader::readRawSymbols(Input& pInput)
+{
+  assert(pInput.hasMemArea());
+
+  LDSection* symtab_shdr = pInput.context()->getSection(".symtab");
+  if (NULL == symtab_shdr || NULL == symtab_shdr->getLink())
+    return true;
+
+  LDSection* strtab_shdr = symtab_shdr->getLink();
+  llvm::StringRef symtab_region = pInput.memArea()->request(
+      pInput.fileOffset() + symtab_shdr->offset(), symtab_shdr->size());
+  llvm::StringRef strtab_region = pInput.memArea()->request(
+      pInput.fileOffset() + strtab_shdr->offset(), strtab_shdr->size());
+
+  ELFReaderIF::RawSymbolTable* table = new ELFReaderIF::RawSymbolTable();
+  m_pELFReader->readRawSymbols(symtab_region, strtab_region.begin(), *table);
+
+  llvm::sys::ScopedLock lock(m_pRawSymbols->lock);
+  ELFReaderIF::RawSymbolTable*& entry = m_pRawSymbols->tables[&pInput];
+  delete entry;
+  entry = table;
+  return true;
+}
+
 bool ELFObjectReader::readRelocations(Input& pInput)
 {
   assert(pInput.hasMemArea());
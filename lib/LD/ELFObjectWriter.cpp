@@ -13,15 +13,18 @@
 #include <mcld/LinkerScript.h>
 #include <mcld/Target/GNULDBackend.h>
 #include <mcld/Support/MsgHandling.h>
+#include <mcld/Support/ThreadPool.h>
 #include <mcld/ADT/SizeTraits.h>
 #include <mcld/Fragment/AlignFragment.h>
 #include <mcld/Fragment/FillFragment.h>
 #include <mcld/Fragment/RegionFragment.h>
 #include <mcld/Fragment/Stub.h>
 #include <mcld/Fragment/NullFragment.h>
+#include <mcld/Fragment/MergedFragment.h>
 #include <mcld/LD/LDSymbol.h>
 #include <mcld/LD/LDSection.h>
 #include <mcld/LD/SectionData.h>
+#include <mcld/LD/StringTableBuilder.h>
 #include <mcld/LD/ELFSegment.h>
 #include <mcld/LD/ELFSegmentFactory.h>
 #include <mcld/LD/RelocData.h>
@@ -38,6 +41,94 @@ using namespace llvm;
 using namespace llvm::ELF;
 using namespace mcld;
 
+//===----------------------------------------------------------------------===//
+// ELFObjectWriter::SectionJob
+//===----------------------------------------------------------------------===//
+/// SectionJob - write out a list of sections in order
+class ELFObjectWriter::SectionJob : public ThreadPool::Job
+{
+public:
+  SectionJob(ELFObjectWriter& pWriter,
+             Module& pModule,
+             FileOutputBuffer& pOutput,
+             const SectionList& pSections)
+    : m_Writer(pWriter), m_Module(pModule), m_Output(pOutput),
+      m_Sections(pSections) {
+  }
+
+  void run() {
+    SectionList::iterator sect, sectEnd = m_Sections.end();
+    for (sect = m_Sections.begin(); sect != sectEnd; ++sect)
+      m_Writer.writeSection(m_Module, m_Output, *sect);
+  }
+
+private:
+  ELFObjectWriter& m_Writer;
+  Module& m_Module;
+  FileOutputBuffer& m_Output;
+  SectionList m_Sections;
+};
+
+//===----------------------------------------------------------------------===//
+// ELFObjectWriter::FragmentJob
+//===----------------------------------------------------------------------===//
+/// FragmentJob - write out a range of fragments of a large section
+class ELFObjectWriter::FragmentJob : public ThreadPool::Job
+{
+public:
+  FragmentJob(const ELFObjectWriter& pWriter,
+              SectionData::const_iterator pBegin,
+              SectionData::const_iterator pEnd,
+              MemoryRegion pRegion)
+    : m_Writer(pWriter), m_Begin(pBegin), m_End(pEnd), m_Region(pRegion) {
+  }
+
+  void run()
+  { m_Writer.emitFragments(m_Begin, m_End, m_Region); }
+
+private:
+  const ELFObjectWriter& m_Writer;
+  SectionData::const_iterator m_Begin;
+  SectionData::const_iterator m_End;
+  MemoryRegion m_Region;
+};
+
+//===----------------------------------------------------------------------===//
+// ELFObjectWriter::NamePoolJob
+//===----------------------------------------------------------------------===//
+/// NamePoolJob - write out .symtab and .strtab, or .dynsym, .dynstr, .hash,
+/// .gnu.hash and .dynamic
+class ELFObjectWriter::NamePoolJob : public ThreadPool::Job
+{
+public:
+  enum Kind {
+    Regular,
+    Dynamic
+  };
+
+public:
+  NamePoolJob(ELFObjectWriter& pWriter,
+              Module& pModule,
+              FileOutputBuffer& pOutput,
+              Kind pKind)
+    : m_Writer(pWriter), m_Module(pModule), m_Output(pOutput),
+      m_Kind(pKind) {
+  }
+
+  void run() {
+    if (Dynamic == m_Kind)
+      m_Writer.target().emitDynNamePools(m_Module, m_Output);
+    else
+      m_Writer.target().emitRegNamePools(m_Module, m_Output);
+  }
+
+private:
+  ELFObjectWriter& m_Writer;
+  Module& m_Module;
+  FileOutputBuffer& m_Output;
+  Kind m_Kind;
+};
+
 //===----------------------------------------------------------------------===//
 // ELFObjectWriter
 //===----------------------------------------------------------------------===//
@@ -117,7 +208,8 @@ void ELFObjectWriter::writeSection(Module& pModule,
 }
 
 llvm::error_code ELFObjectWriter::writeObject(Module& pModule,
-                                              FileOutputBuffer& pOutput)
+                                              FileOutputBuffer& pOutput,
+                                              ThreadPool& pThreadPool)
 {
   bool is_dynobj = m_Config.codeGenType() == LinkerConfig::DynObj;
   bool is_exec = m_Config.codeGenType() == LinkerConfig::Exec;
@@ -126,6 +218,11 @@ llvm::error_code ELFObjectWriter::writeObject(Module& pModule,
 
   assert(is_dynobj || is_exec || is_binary || is_object);
 
+  // The name pool which assigns the symbol indices is written together with
+  // the sections, and the relocation sections are written after it. .symtab
+  // of an executable is written after .dynsym, since .gnu.hash reorders the
+  // dynamic symbols.
+  ThreadPool::JobList section_jobs, reloc_jobs;
   if (is_dynobj || is_exec) {
     // Allow backend to sort symbols before emitting
     target().orderSymbolTable(pModule);
@@ -134,14 +231,19 @@ llvm::error_code ELFObjectWriter::writeObject(Module& pModule,
     target().emitInterp(pOutput);
 
     // Write out name pool sections: .dynsym, .dynstr, .hash
-    target().emitDynNamePools(pModule, pOutput);
+    section_jobs.push_back(new NamePoolJob(*this, pModule, pOutput,
+                                           NamePoolJob::Dynamic));
+    // Write out name pool sections: .symtab, .strtab
+    reloc_jobs.push_back(new NamePoolJob(*this, pModule, pOutput,
+                                         NamePoolJob::Regular));
   }
-
-  if (is_object || is_dynobj || is_exec) {
+  else if (is_object) {
     // Write out name pool sections: .symtab, .strtab
-    target().emitRegNamePools(pModule, pOutput);
+    section_jobs.push_back(new NamePoolJob(*this, pModule, pOutput,
+                                           NamePoolJob::Regular));
   }
 
+  SectionList sections;
   if (is_binary) {
     // Iterate over the loadable segments and write the corresponding sections
     ELFSegmentFactory::iterator seg, segEnd = target().elfSegmentTable().end();
@@ -149,16 +251,41 @@ llvm::error_code ELFObjectWriter::writeObject(Module& pModule,
     for (seg = target().elfSegmentTable().begin(); seg != segEnd; ++seg) {
       if (llvm::ELF::PT_LOAD == (*seg)->type()) {
         ELFSegment::iterator sect, sectEnd = (*seg)->end();
-        for (sect = (*seg)->begin(); sect != sectEnd; ++sect)
-          writeSection(pModule, pOutput, *sect);
+        for (sect = (*seg)->begin(); sect != sectEnd; ++sect) {
+          if (!target().isFilledByRelocator(**sect))
+            sections.push_back(*sect);
+        }
       }
     }
   } else {
     // Write out regular ELF sections
     Module::iterator sect, sectEnd = pModule.end();
-    for (sect = pModule.begin(); sect != sectEnd; ++sect)
-      writeSection(pModule, pOutput, *sect);
+    for (sect = pModule.begin(); sect != sectEnd; ++sect) {
+      if (!target().isFilledByRelocator(**sect))
+        sections.push_back(*sect);
+    }
+  }
+
+  // The target sections are written by the backend in one job after the
+  // dynamic symbols are settled, as they were written before.
+  SectionList data_sects, reloc_sects, target_sects;
+  SectionList::iterator sect, sectEnd = sections.end();
+  for (sect = sections.begin(); sect != sectEnd; ++sect) {
+    if (LDFileFormat::Relocation == (*sect)->kind())
+      reloc_sects.push_back(*sect);
+    else if (LDFileFormat::Target == (*sect)->kind())
+      target_sects.push_back(*sect);
+    else
+      data_sects.push_back(*sect);
+  }
+  if (!target_sects.empty())
+    reloc_jobs.push_back(new SectionJob(*this, pModule, pOutput,
+                                        target_sects));
 
+  writeSections(pModule, pOutput, data_sects, section_jobs, pThreadPool);
+  writeSections(pModule, pOutput, reloc_sects, reloc_jobs, pThreadPool);
+
+  if (!is_binary) {
     emitShStrTab(target().getOutputFormat()->getShStrTab(), pModule, pOutput);
 
     if (m_Config.targets().is32Bits()) {
@@ -186,6 +313,73 @@ llvm::error_code ELFObjectWriter::writeObject(Module& pModule,
   return llvm::make_error_code(llvm::errc::success);
 }
 
+/// writeSections - write out pSections and run the jobs in pJobs. All jobs
+/// are deleted after they are done.
+void ELFObjectWriter::writeSections(Module& pModule,
+                                    FileOutputBuffer& pOutput,
+                                    const SectionList& pSections,
+                                    ThreadPool::JobList& pJobs,
+                                    ThreadPool& pThreadPool)
+{
+  SectionList::const_iterator sect, sectEnd = pSections.end();
+  for (sect = pSections.begin(); sect != sectEnd; ++sect) {
+    if (pThreadPool.isParallel() && splitSection(**sect, pOutput, pJobs))
+      continue;
+    pJobs.push_back(new SectionJob(*this, pModule, pOutput,
+                                   SectionList(1, *sect)));
+  }
+
+  pThreadPool.run(pJobs);
+
+  ThreadPool::JobList::iterator job, jobEnd = pJobs.end();
+  for (job = pJobs.begin(); job != jobEnd; ++job)
+    delete *job;
+  pJobs.clear();
+}
+
+/// splitSection - split a large section into ranges of fragments of at least
+/// SplitSize bytes
+bool ELFObjectWriter::splitSection(const LDSection& pSection,
+                                   FileOutputBuffer& pOutput,
+                                   ThreadPool::JobList& pJobs) const
+{
+  switch (pSection.kind()) {
+  case LDFileFormat::GCCExceptTable:
+  case LDFileFormat::Regular:
+  case LDFileFormat::Debug:
+  case LDFileFormat::Note:
+    break;
+  default:
+    return false;
+  }
+
+  if (pSection.size() < 2 * SplitSize || !pSection.hasSectionData())
+    return false;
+
+  MemoryRegion region = pOutput.request(pSection.offset(), pSection.size());
+  if (region.size() == 0)
+    return false;
+
+  const SectionData& sd = *pSection.getSectionData();
+  SectionData::const_iterator begin = sd.begin();
+  SectionData::const_iterator frag, fragEnd = sd.end();
+  size_t begin_offset = 0, cur_offset = 0;
+  for (frag = sd.begin(); frag != fragEnd; ++frag) {
+    if (cur_offset - begin_offset >= SplitSize) {
+      pJobs.push_back(new FragmentJob(*this, begin, frag,
+                          MemoryRegion(region.begin() + begin_offset,
+                                       cur_offset - begin_offset)));
+      begin = frag;
+      begin_offset = cur_offset;
+    }
+    cur_offset += frag->size();
+  }
+  pJobs.push_back(new FragmentJob(*this, begin, fragEnd,
+                      MemoryRegion(region.begin() + begin_offset,
+                                   cur_offset - begin_offset)));
+  return true;
+}
+
 // getOutputSize - count the final output size
 size_t ELFObjectWriter::getOutputSize(const Module& pModule) const
 {
@@ -314,11 +508,11 @@ void ELFObjectWriter::emitSectionHeader(const Module& pModule,
   ElfXX_Shdr* shdr = (ElfXX_Shdr*)region.begin();
 
   // Iterate the SectionTable in LDContext
+  const StringTableBuilder& shstrtab = target().getShStrTabBuilder();
   unsigned int sectIdx = 0;
-  unsigned int shstridx = 0; // NULL section has empty name
   for (; sectIdx < sectNum; ++sectIdx) {
     const LDSection *ld_sect   = pModule.getSectionTable().at(sectIdx);
-    shdr[sectIdx].sh_name      = shstridx;
+    shdr[sectIdx].sh_name      = shstrtab.getOffset(ld_sect->name());
     shdr[sectIdx].sh_type      = ld_sect->type();
     shdr[sectIdx].sh_flags     = ld_sect->flag();
     shdr[sectIdx].sh_addr      = ld_sect->addr();
@@ -328,9 +522,6 @@ void ELFObjectWriter::emitSectionHeader(const Module& pModule,
     shdr[sectIdx].sh_entsize   = getSectEntrySize<SIZE>(*ld_sect);
     shdr[sectIdx].sh_link      = getSectLink(*ld_sect, pConfig);
     shdr[sectIdx].sh_info      = getSectInfo(*ld_sect);
-
-    // adjust strshidx
-    shstridx += ld_sect->name().size() + 1;
   }
 }
 
@@ -373,15 +564,9 @@ ELFObjectWriter::emitShStrTab(const LDSection& pShStrTab,
                               const Module& pModule,
                               FileOutputBuffer& pOutput)
 {
-  // write out data
+  // write out data, the layout is decided by GNULDBackend::sizeShstrtab()
   MemoryRegion region = pOutput.request(pShStrTab.offset(), pShStrTab.size());
-  char* data = (char*)region.begin();
-  size_t shstrsize = 0;
-  Module::const_iterator section, sectEnd = pModule.end();
-  for (section = pModule.begin(); section != sectEnd; ++section) {
-    strcpy((char*)(data + shstrsize), (*section)->name().data());
-    shstrsize += (*section)->name().size() + 1;
-  }
+  target().getShStrTabBuilder().emit((char*)region.begin());
 }
 
 /// emitSectionData
@@ -591,10 +776,12 @@ uint64_t ELFObjectWriter::getSectEntrySize(const LDSection& pSection) const
     return sizeof(ElfXX_Word);
   if (llvm::ELF::SHT_DYNAMIC == pSection.type())
     return sizeof(ElfXX_Dyn);
-  // FIXME: We should get the entsize from input since the size of each
-  // character is specified in the section header's sh_entsize field.
-  // For example, traditional string is 0x1, UCS-2 is 0x2, ... and so on.
+  // The size of each character or constant of SHF_MERGE sections is taken
+  // from the inputs. For example, traditional string is 0x1, UCS-2 is 0x2,
+  // ... and so on.
   // Ref: http://www.sco.com/developers/gabi/2003-12-17/ch4.sheader.html
+  if ((pSection.flag() & llvm::ELF::SHF_MERGE) && 0x0 != pSection.entSize())
+    return pSection.entSize();
   if (pSection.flag() & llvm::ELF::SHF_STRINGS)
     return 0x1;
   return 0x0;
@@ -665,9 +852,17 @@ uint64_t ELFObjectWriter::getLastStartOffset<64>(const Module& pModule) const
 void ELFObjectWriter::emitSectionData(const SectionData& pSD,
                                       MemoryRegion& pRegion) const
 {
-  SectionData::const_iterator fragIter, fragEnd = pSD.end();
+  emitFragments(pSD.begin(), pSD.end(), pRegion);
+}
+
+/// emitFragments
+void ELFObjectWriter::emitFragments(SectionData::const_iterator pBegin,
+                                    SectionData::const_iterator pEnd,
+                                    MemoryRegion& pRegion) const
+{
+  SectionData::const_iterator fragIter, fragEnd = pEnd;
   size_t cur_offset = 0;
-  for (fragIter = pSD.begin(); fragIter != fragEnd; ++fragIter) {
+  for (fragIter = pBegin; fragIter != fragEnd; ++fragIter) {
     size_t size = fragIter->size();
     switch(fragIter->getKind()) {
       case Fragment::Region: {
@@ -714,6 +909,12 @@ void ELFObjectWriter::emitSectionData(const SectionData& pSD,
         memcpy(pRegion.begin() + cur_offset, stub_frag.getContent(), size);
         break;
       }
+      case Fragment::Merged: {
+        const MergedFragment& merged_frag =
+                                      llvm::cast<MergedFragment>(*fragIter);
+        merged_frag.emit(pRegion.begin() + cur_offset);
+        break;
+      }
       case Fragment::Null: {
         assert(0x0 == size);
         break;
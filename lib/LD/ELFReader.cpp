@@ -71,139 +71,250 @@ bool ELFReader<32, true>::readSymbols(Input& pInput,
                                       const char* pStrTab) const
 {
   // get number of symbols
-  size_t entsize = pRegion.size()/sizeof(llvm::ELF::Elf32_Sym);
+  size_t entsize = pRegion.size() / sizeof(llvm::ELF::Elf32_Sym);
   const llvm::ELF::Elf32_Sym* symtab =
       reinterpret_cast<const llvm::ELF::Elf32_Sym*>(pRegion.begin());
 
-  uint32_t st_name  = 0x0;
-  uint32_t st_value = 0x0;
-  uint32_t st_size  = 0x0;
-  uint8_t  st_info  = 0x0;
-  uint8_t  st_other = 0x0;
-  uint16_t st_shndx = 0x0;
-
   // skip the first NULL symbol
   pInput.context()->addSymbol(LDSymbol::Null());
 
   /// recording symbols added from DynObj to analyze weak alias
   std::vector<AliasInfo> potential_aliases;
-  bool is_dyn_obj = (pInput.type()==Input::DynObj);
+  RawSymbol sym;
   for (size_t idx = 1; idx < entsize; ++idx) {
-    st_info  = symtab[idx].st_info;
-    st_other = symtab[idx].st_other;
+    decodeSymbol(symtab[idx], pStrTab, sym);
+    readSymbol(pInput, pBuilder, sym, potential_aliases);
+  }
 
-    if (llvm::sys::IsLittleEndianHost) {
-      st_name  = symtab[idx].st_name;
-      st_value = symtab[idx].st_value;
-      st_size  = symtab[idx].st_size;
-      st_shndx = symtab[idx].st_shndx;
-    }
-    else {
-      st_name  = mcld::bswap32(symtab[idx].st_name);
-      st_value = mcld::bswap32(symtab[idx].st_value);
-      st_size  = mcld::bswap32(symtab[idx].st_size);
-      st_shndx = mcld::bswap16(symtab[idx].st_shndx);
-    }
+  if (pInput.type() == Input::DynObj)
+    analyzeAliases(pBuilder, potential_aliases);
+  return true;
+}
 
-    // If the section should not be included, set the st_shndx SHN_UNDEF
-    // - A section in interrelated groups are not included.
-    if (pInput.type() == Input::Object &&
-        st_shndx < llvm::ELF::SHN_LORESERVE &&
-        st_shndx != llvm::ELF::SHN_UNDEF) {
-      if (NULL == pInput.context()->getSection(st_shndx))
-        st_shndx = llvm::ELF::SHN_UNDEF;
-    }
+/// readSymbols - read the ELF symbols of a DynObj in pIndices
+bool ELFReader<32, true>::readSymbols(Input& pInput,
+                                      IRBuilder& pBuilder,
+                                      llvm::StringRef pRegion,
+                                      const char* pStrTab,
+                                      const std::vector<size_t>& pIndices) const
+{
+  assert(pInput.type() == Input::DynObj);
+  size_t entsize = pRegion.size() / sizeof(llvm::ELF::Elf32_Sym);
+  const llvm::ELF::Elf32_Sym* symtab =
+      reinterpret_cast<const llvm::ELF::Elf32_Sym*>(pRegion.begin());
 
-    // get ld_type
-    ResolveInfo::Type ld_type = getSymType(st_info, st_shndx);
+  std::vector<AliasInfo> potential_aliases;
+  RawSymbol sym;
+  std::vector<size_t>::const_iterator idx, idxEnd = pIndices.end();
+  for (idx = pIndices.begin(); idx != idxEnd; ++idx) {
+    if (0 == *idx || *idx >= entsize)
+      return false;
+    decodeSymbol(symtab[*idx], pStrTab, sym);
+    readSymbol(pInput, pBuilder, sym, potential_aliases);
+  }
 
-    // get ld_desc
-    ResolveInfo::Desc ld_desc = getSymDesc(st_shndx, pInput);
+  analyzeAliases(pBuilder, potential_aliases);
+  return true;
+}
 
-    // get ld_binding
-    ResolveInfo::Binding ld_binding = getSymBinding((st_info >> 4), st_shndx, st_other);
+/// readRawSymbols - decode the ELF symbols in pRegion without creating any
+/// symbol
+void ELFReader<32, true>::readRawSymbols(llvm::StringRef pRegion,
+                                         const char* pStrTab,
+                                         RawSymbolTable& pTable) const
+{
+  size_t entsize = pRegion.size() / sizeof(llvm::ELF::Elf32_Sym);
+  const llvm::ELF::Elf32_Sym* symtab =
+      reinterpret_cast<const llvm::ELF::Elf32_Sym*>(pRegion.begin());
 
-    // get ld_value - ld_value must be section relative.
-    uint64_t ld_value = getSymValue(st_value, st_shndx, pInput);
+  pTable.resize(entsize);
+  for (size_t idx = 1; idx < entsize; ++idx)
+    decodeSymbol(symtab[idx], pStrTab, pTable[idx]);
+}
 
-    // get ld_vis
-    ResolveInfo::Visibility ld_vis = getSymVisibility(st_other);
+/// readSymbols - create LDSymbols from the symbols decoded by readRawSymbols
+bool ELFReader<32, true>::readSymbols(Input& pInput,
+                                      IRBuilder& pBuilder,
+                                      const RawSymbolTable& pTable) const
+{
+  // skip the first NULL symbol
+  pInput.context()->addSymbol(LDSymbol::Null());
 
-    // get section
-    LDSection* section = NULL;
-    if (st_shndx < llvm::ELF::SHN_LORESERVE) // including ABS and COMMON
-      section = pInput.context()->getSection(st_shndx);
+  /// recording symbols added from DynObj to analyze weak alias
+  std::vector<AliasInfo> potential_aliases;
+  for (size_t idx = 1; idx < pTable.size(); ++idx)
+    readSymbol(pInput, pBuilder, pTable[idx], potential_aliases);
 
-    // get ld_name
-    std::string ld_name;
-    if (ResolveInfo::Section == ld_type) {
-      // Section symbol's st_name is the section index.
-      assert(NULL != section && "get a invalid section");
-      ld_name = section->name();
-    }
-    else {
-      ld_name = std::string(pStrTab + st_name);
-    }
+  if (pInput.type() == Input::DynObj)
+    analyzeAliases(pBuilder, potential_aliases);
+  return true;
+}
+
+/// readAliasCandidates - collect the potential weak aliases of a DynObj
+void ELFReader<32, true>::readAliasCandidates(llvm::StringRef pRegion,
+                                              size_t pBegin,
+                                              size_t pEnd,
+                                              AliasCandidateList& pList) const
+{
+  size_t entsize = pRegion.size() / sizeof(llvm::ELF::Elf32_Sym);
+  const llvm::ELF::Elf32_Sym* symtab =
+      reinterpret_cast<const llvm::ELF::Elf32_Sym*>(pRegion.begin());
 
-    LDSymbol* psym = pBuilder.AddSymbol(pInput,
-                                        ld_name,
-                                        ld_type,
-                                        ld_desc,
-                                        ld_binding,
-                                        st_size,
-                                        ld_value,
-                                        section,
-                                        ld_vis);
-
-    if (is_dyn_obj
-        && NULL != psym
-        && ResolveInfo::Undefined != ld_desc
-        && (ResolveInfo::Global == ld_binding ||
-            ResolveInfo::Weak == ld_binding)
-        && ResolveInfo::Object == ld_type) {
-      AliasInfo p;
-      p.pt_alias = psym;
-      p.ld_binding = ld_binding;
-      p.ld_value = ld_value;
-      potential_aliases.push_back(p);
+  if (pEnd > entsize)
+    pEnd = entsize;
+  for (size_t idx = pBegin; idx < pEnd; ++idx) {
+    uint8_t st_info = symtab[idx].st_info;
+    uint8_t st_bind = (st_info >> 4);
+    if (llvm::ELF::STT_OBJECT != (st_info & 0xf) ||
+        (llvm::ELF::STB_GLOBAL != st_bind && llvm::ELF::STB_WEAK != st_bind))
+      continue;
+
+    uint16_t st_shndx = symtab[idx].st_shndx;
+    uint32_t st_value = symtab[idx].st_value;
+    if (!llvm::sys::IsLittleEndianHost) {
+      st_shndx = mcld::bswap16(st_shndx);
+      st_value = mcld::bswap32(st_value);
     }
+    if (llvm::ELF::SHN_UNDEF == st_shndx)
+      continue;
+    pList.push_back(std::make_pair(uint64_t(st_value), idx));
+  }
+}
+
+/// decodeSymbol - decode an ELF symbol to the host endian
+void ELFReader<32, true>::decodeSymbol(const Symbol& pSym,
+                                       const char* pStrTab,
+                                       RawSymbol& pResult)
+{
+  uint32_t st_name = 0x0;
+  if (llvm::sys::IsLittleEndianHost) {
+    st_name          = pSym.st_name;
+    pResult.value    = pSym.st_value;
+    pResult.size     = pSym.st_size;
+    pResult.shndx    = pSym.st_shndx;
+  }
+  else {
+    st_name          = mcld::bswap32(pSym.st_name);
+    pResult.value    = mcld::bswap32(pSym.st_value);
+    pResult.size     = mcld::bswap32(pSym.st_size);
+    pResult.shndx    = mcld::bswap16(pSym.st_shndx);
+  }
+  pResult.info  = pSym.st_info;
+  pResult.other = pSym.st_other;
+  pResult.name  = llvm::StringRef(pStrTab + st_name);
+}
+
+/// readSymbol - create LDSymbol from a decoded ELF symbol
+void ELFReader<32, true>::readSymbol(Input& pInput,
+                                     IRBuilder& pBuilder,
+                                     const RawSymbol& pSym,
+                                     std::vector<AliasInfo>& pAliases) const
+{
+  uint64_t st_value = pSym.value;
+  uint64_t st_size  = pSym.size;
+  uint8_t  st_info  = pSym.info;
+  uint8_t  st_other = pSym.other;
+  uint16_t st_shndx = pSym.shndx;
+
+  // If the section should not be included, set the st_shndx SHN_UNDEF
+  // - A section in interrelated groups are not included.
+  if (pInput.type() == Input::Object &&
+      st_shndx < llvm::ELF::SHN_LORESERVE &&
+      st_shndx != llvm::ELF::SHN_UNDEF) {
+    if (NULL == pInput.context()->getSection(st_shndx))
+      st_shndx = llvm::ELF::SHN_UNDEF;
+  }
+
+  // get ld_type
+  ResolveInfo::Type ld_type = getSymType(st_info, st_shndx);
 
-  } // end of for loop
+  // get ld_desc
+  ResolveInfo::Desc ld_desc = getSymDesc(st_shndx, pInput);
 
-  // analyze weak alias
+  // get ld_binding
+  ResolveInfo::Binding ld_binding = getSymBinding((st_info >> 4), st_shndx, st_other);
+
+  // get ld_value - ld_value must be section relative.
+  uint64_t ld_value = getSymValue(st_value, st_shndx, pInput);
+
+  // get ld_vis
+  ResolveInfo::Visibility ld_vis = getSymVisibility(st_other);
+
+  // get section
+  LDSection* section = NULL;
+  if (st_shndx < llvm::ELF::SHN_LORESERVE) // including ABS and COMMON
+    section = pInput.context()->getSection(st_shndx);
+
+  // get ld_name, which refers to the string table or the section name
+  // directly. The name is copied only once, into the ResolveInfo.
+  llvm::StringRef ld_name;
+  if (ResolveInfo::Section == ld_type) {
+    // Section symbol's st_name is the section index.
+    assert(NULL != section && "get a invalid section");
+    ld_name = section->name();
+  }
+  else {
+    ld_name = pSym.name;
+  }
+
+  LDSymbol* psym = pBuilder.AddSymbol(pInput,
+                                      ld_name,
+                                      ld_type,
+                                      ld_desc,
+                                      ld_binding,
+                                      st_size,
+                                      ld_value,
+                                      section,
+                                      ld_vis);
+
+  // recording symbols added from DynObj to analyze weak alias
+  if (pInput.type() == Input::DynObj
+      && NULL != psym
+      && ResolveInfo::Undefined != ld_desc
+      && (ResolveInfo::Global == ld_binding ||
+          ResolveInfo::Weak == ld_binding)
+      && ResolveInfo::Object == ld_type) {
+    AliasInfo p;
+    p.pt_alias = psym;
+    p.ld_binding = ld_binding;
+    p.ld_value = ld_value;
+    pAliases.push_back(p);
+  }
+}
+
+/// analyzeAliases - analyze the weak aliases of a DynObj
+void ELFReader<32, true>::analyzeAliases(IRBuilder& pBuilder,
+                                         std::vector<AliasInfo>& pAliases)
+{
   // FIXME: it is better to let IRBuilder handle alias anlysis.
   //        1. eliminate code duplication
   //        2. easy to know if a symbol is from .so
   //           (so that it may be a potential alias)
-  if (is_dyn_obj) {
-    // sort symbols by symbol value and then weak before strong
-    std::sort(potential_aliases.begin(), potential_aliases.end(), less);
-
-    // for each weak symbol, find out all its aliases, and
-    // then link them as a circular list in Module
-    std::vector<AliasInfo>::iterator sym_it, sym_e;
-    sym_e = potential_aliases.end();
-    for (sym_it = potential_aliases.begin(); sym_it!=sym_e; ++sym_it) {
-      if (ResolveInfo::Weak!=sym_it->ld_binding)
-        continue;
-
-      Module& pModule = pBuilder.getModule();
-      std::vector<AliasInfo>::iterator alias_it = sym_it+1;
-      while(alias_it!=sym_e) {
-        if (sym_it->ld_value != alias_it->ld_value)
-          break;
-
-        if (sym_it + 1 == alias_it)
-          pModule.CreateAliasList(*sym_it->pt_alias->resolveInfo());
-        pModule.addAlias(*alias_it->pt_alias->resolveInfo());
-        ++alias_it;
-      }
-
-      sym_it = alias_it - 1;
-    }// end of for loop
-  }
+  // sort symbols by symbol value and then weak before strong
+  std::sort(pAliases.begin(), pAliases.end(), less);
+
+  // for each weak symbol, find out all its aliases, and
+  // then link them as a circular list in Module
+  std::vector<AliasInfo>::iterator sym_it, sym_e;
+  sym_e = pAliases.end();
+  for (sym_it = pAliases.begin(); sym_it!=sym_e; ++sym_it) {
+    if (ResolveInfo::Weak!=sym_it->ld_binding)
+      continue;
+
+    Module& pModule = pBuilder.getModule();
+    std::vector<AliasInfo>::iterator alias_it = sym_it+1;
+    while(alias_it!=sym_e) {
+      if (sym_it->ld_value != alias_it->ld_value)
+        break;
 
-  return true;
+      if (sym_it + 1 == alias_it)
+        pModule.CreateAliasList(*sym_it->pt_alias->resolveInfo());
+      pModule.addAlias(*alias_it->pt_alias->resolveInfo());
+      ++alias_it;
+    }
+
+    sym_it = alias_it - 1;
+  }// end of for loop
 }
 
 //===----------------------------------------------------------------------===//
@@ -350,6 +461,7 @@ bool ELFReader<32, true>::readSectionHeaders(Input& pInput,
   uint32_t sh_link      = 0x0;
   uint32_t sh_info      = 0x0;
   uint32_t sh_addralign = 0x0;
+  uint32_t sh_entsize   = 0x0;
 
   // if shnum and shstrtab overflow, the actual values are in the 1st shdr
   if (shnum == llvm::ELF::SHN_UNDEF || shstrtab == llvm::ELF::SHN_XINDEX) {
@@ -407,6 +519,7 @@ bool ELFReader<32, true>::readSectionHeaders(Input& pInput,
       sh_link      = shdrTab[idx].sh_link;
       sh_info      = shdrTab[idx].sh_info;
       sh_addralign = shdrTab[idx].sh_addralign;
+      sh_entsize   = shdrTab[idx].sh_entsize;
     }
     else {
       sh_name      = mcld::bswap32(shdrTab[idx].sh_name);
@@ -417,6 +530,7 @@ bool ELFReader<32, true>::readSectionHeaders(Input& pInput,
       sh_link      = mcld::bswap32(shdrTab[idx].sh_link);
       sh_info      = mcld::bswap32(shdrTab[idx].sh_info);
       sh_addralign = mcld::bswap32(shdrTab[idx].sh_addralign);
+      sh_entsize   = mcld::bswap32(shdrTab[idx].sh_entsize);
     }
 
     LDSection* section = IRBuilder::CreateELFHeader(pInput,
@@ -427,6 +541,7 @@ bool ELFReader<32, true>::readSectionHeaders(Input& pInput,
     section->setSize(sh_size);
     section->setOffset(sh_offset);
     section->setInfo(sh_info);
+    section->setEntSize(sh_entsize);
 
     if (sh_link != 0x0 || sh_info != 0x0) {
       LinkInfo link_info = { section, sh_link, sh_info };
@@ -600,130 +715,242 @@ bool ELFReader<64, true>::readSymbols(Input& pInput,
   const llvm::ELF::Elf64_Sym* symtab =
       reinterpret_cast<const llvm::ELF::Elf64_Sym*>(pRegion.begin());
 
-  uint32_t st_name  = 0x0;
-  uint64_t st_value = 0x0;
-  uint64_t st_size  = 0x0;
-  uint8_t  st_info  = 0x0;
-  uint8_t  st_other = 0x0;
-  uint16_t st_shndx = 0x0;
-
   // skip the first NULL symbol
   pInput.context()->addSymbol(LDSymbol::Null());
 
   /// recording symbols added from DynObj to analyze weak alias
   std::vector<AliasInfo> potential_aliases;
-  bool is_dyn_obj = (pInput.type()==Input::DynObj);
+  RawSymbol sym;
   for (size_t idx = 1; idx < entsize; ++idx) {
-    st_info  = symtab[idx].st_info;
-    st_other = symtab[idx].st_other;
+    decodeSymbol(symtab[idx], pStrTab, sym);
+    readSymbol(pInput, pBuilder, sym, potential_aliases);
+  }
 
-    if (llvm::sys::IsLittleEndianHost) {
-      st_name  = symtab[idx].st_name;
-      st_value = symtab[idx].st_value;
-      st_size  = symtab[idx].st_size;
-      st_shndx = symtab[idx].st_shndx;
-    }
-    else {
-      st_name  = mcld::bswap32(symtab[idx].st_name);
-      st_value = mcld::bswap64(symtab[idx].st_value);
-      st_size  = mcld::bswap64(symtab[idx].st_size);
-      st_shndx = mcld::bswap16(symtab[idx].st_shndx);
-    }
+  if (pInput.type() == Input::DynObj)
+    analyzeAliases(pBuilder, potential_aliases);
+  return true;
+}
 
-    // If the section should not be included, set the st_shndx SHN_UNDEF
-    // - A section in interrelated groups are not included.
-    if (pInput.type() == Input::Object &&
-        st_shndx < llvm::ELF::SHN_LORESERVE &&
-        st_shndx != llvm::ELF::SHN_UNDEF) {
-      if (NULL == pInput.context()->getSection(st_shndx))
-        st_shndx = llvm::ELF::SHN_UNDEF;
-    }
+/// readSymbols - read the ELF symbols of a DynObj in pIndices
+bool ELFReader<64, true>::readSymbols(Input& pInput,
+                                      IRBuilder& pBuilder,
+                                      llvm::StringRef pRegion,
+                                      const char* pStrTab,
+                                      const std::vector<size_t>& pIndices) const
+{
+  assert(pInput.type() == Input::DynObj);
+  size_t entsize = pRegion.size() / sizeof(llvm::ELF::Elf64_Sym);
+  const llvm::ELF::Elf64_Sym* symtab =
+      reinterpret_cast<const llvm::ELF::Elf64_Sym*>(pRegion.begin());
 
-    // get ld_type
-    ResolveInfo::Type ld_type = getSymType(st_info, st_shndx);
+  std::vector<AliasInfo> potential_aliases;
+  RawSymbol sym;
+  std::vector<size_t>::const_iterator idx, idxEnd = pIndices.end();
+  for (idx = pIndices.begin(); idx != idxEnd; ++idx) {
+    if (0 == *idx || *idx >= entsize)
+      return false;
+    decodeSymbol(symtab[*idx], pStrTab, sym);
+    readSymbol(pInput, pBuilder, sym, potential_aliases);
+  }
 
-    // get ld_desc
-    ResolveInfo::Desc ld_desc = getSymDesc(st_shndx, pInput);
+  analyzeAliases(pBuilder, potential_aliases);
+  return true;
+}
 
-    // get ld_binding
-    ResolveInfo::Binding ld_binding = getSymBinding((st_info >> 4), st_shndx, st_other);
+/// readRawSymbols - decode the ELF symbols in pRegion without creating any
+/// symbol
+void ELFReader<64, true>::readRawSymbols(llvm::StringRef pRegion,
+                                         const char* pStrTab,
+                                         RawSymbolTable& pTable) const
+{
+  size_t entsize = pRegion.size() / sizeof(llvm::ELF::Elf64_Sym);
+  const llvm::ELF::Elf64_Sym* symtab =
+      reinterpret_cast<const llvm::ELF::Elf64_Sym*>(pRegion.begin());
 
-    // get ld_value - ld_value must be section relative.
-    uint64_t ld_value = getSymValue(st_value, st_shndx, pInput);
+  pTable.resize(entsize);
+  for (size_t idx = 1; idx < entsize; ++idx)
+    decodeSymbol(symtab[idx], pStrTab, pTable[idx]);
+}
 
-    // get ld_vis
-    ResolveInfo::Visibility ld_vis = getSymVisibility(st_other);
+/// readSymbols - create LDSymbols from the symbols decoded by readRawSymbols
+bool ELFReader<64, true>::readSymbols(Input& pInput,
+                                      IRBuilder& pBuilder,
+                                      const RawSymbolTable& pTable) const
+{
+  // skip the first NULL symbol
+  pInput.context()->addSymbol(LDSymbol::Null());
 
-    // get section
-    LDSection* section = NULL;
-    if (st_shndx < llvm::ELF::SHN_LORESERVE) // including ABS and COMMON
-      section = pInput.context()->getSection(st_shndx);
+  /// recording symbols added from DynObj to analyze weak alias
+  std::vector<AliasInfo> potential_aliases;
+  for (size_t idx = 1; idx < pTable.size(); ++idx)
+    readSymbol(pInput, pBuilder, pTable[idx], potential_aliases);
 
-    // get ld_name
-    std::string ld_name;
-    if (ResolveInfo::Section == ld_type) {
-      // Section symbol's st_name is the section index.
-      assert(NULL != section && "get a invalid section");
-      ld_name = section->name();
-    }
-    else {
-      ld_name = std::string(pStrTab + st_name);
-    }
+  if (pInput.type() == Input::DynObj)
+    analyzeAliases(pBuilder, potential_aliases);
+  return true;
+}
+
+/// readAliasCandidates - collect the potential weak aliases of a DynObj
+void ELFReader<64, true>::readAliasCandidates(llvm::StringRef pRegion,
+                                              size_t pBegin,
+                                              size_t pEnd,
+                                              AliasCandidateList& pList) const
+{
+  size_t entsize = pRegion.size() / sizeof(llvm::ELF::Elf64_Sym);
+  const llvm::ELF::Elf64_Sym* symtab =
+      reinterpret_cast<const llvm::ELF::Elf64_Sym*>(pRegion.begin());
 
-    LDSymbol* psym = pBuilder.AddSymbol(pInput,
-                                        ld_name,
-                                        ld_type,
-                                        ld_desc,
-                                        ld_binding,
-                                        st_size,
-                                        ld_value,
-                                        section,
-                                        ld_vis);
-
-    if (is_dyn_obj
-        && NULL != psym
-        && ResolveInfo::Undefined != ld_desc
-        && (ResolveInfo::Global == ld_binding ||
-            ResolveInfo::Weak == ld_binding)
-        && ResolveInfo::Object == ld_type ) {
-      AliasInfo p;
-      p.pt_alias = psym;
-      p.ld_binding = ld_binding;
-      p.ld_value = ld_value;
-      potential_aliases.push_back(p);
+  if (pEnd > entsize)
+    pEnd = entsize;
+  for (size_t idx = pBegin; idx < pEnd; ++idx) {
+    uint8_t st_info = symtab[idx].st_info;
+    uint8_t st_bind = (st_info >> 4);
+    if (llvm::ELF::STT_OBJECT != (st_info & 0xf) ||
+        (llvm::ELF::STB_GLOBAL != st_bind && llvm::ELF::STB_WEAK != st_bind))
+      continue;
+
+    uint16_t st_shndx = symtab[idx].st_shndx;
+    uint64_t st_value = symtab[idx].st_value;
+    if (!llvm::sys::IsLittleEndianHost) {
+      st_shndx = mcld::bswap16(st_shndx);
+      st_value = mcld::bswap64(st_value);
     }
+    if (llvm::ELF::SHN_UNDEF == st_shndx)
+      continue;
+    pList.push_back(std::make_pair(uint64_t(st_value), idx));
+  }
+}
 
-  } // end of for loop
-
-  // analyze weak alias here
-  if (is_dyn_obj) {
-    // sort symbols by symbol value and then weak before strong
-    std::sort(potential_aliases.begin(), potential_aliases.end(), less);
-
-    // for each weak symbol, find out all its aliases, and
-    // then link them as a circular list in Module
-    std::vector<AliasInfo>::iterator sym_it, sym_e;
-    sym_e = potential_aliases.end();
-    for (sym_it = potential_aliases.begin(); sym_it!=sym_e; ++sym_it) {
-      if (ResolveInfo::Weak!=sym_it->ld_binding)
-        continue;
-
-      Module& pModule = pBuilder.getModule();
-      std::vector<AliasInfo>::iterator alias_it = sym_it+1;
-      while(alias_it!=sym_e) {
-        if (sym_it->ld_value != alias_it->ld_value)
-          break;
-
-        if (sym_it + 1 == alias_it)
-          pModule.CreateAliasList(*sym_it->pt_alias->resolveInfo());
-        pModule.addAlias(*alias_it->pt_alias->resolveInfo());
-        ++alias_it;
-      }
-
-      sym_it = alias_it - 1;
-    }// end of for loop
+/// decodeSymbol - decode an ELF symbol to the host endian
+void ELFReader<64, true>::decodeSymbol(const Symbol& pSym,
+                                       const char* pStrTab,
+                                       RawSymbol& pResult)
+{
+  uint32_t st_name = 0x0;
+  if (llvm::sys::IsLittleEndianHost) {
+    st_name          = pSym.st_name;
+    pResult.value    = pSym.st_value;
+    pResult.size     = pSym.st_size;
+    pResult.shndx    = pSym.st_shndx;
   }
-  return true;
+  else {
+    st_name          = mcld::bswap32(pSym.st_name);
+    pResult.value    = mcld::bswap64(pSym.st_value);
+    pResult.size     = mcld::bswap64(pSym.st_size);
+    pResult.shndx    = mcld::bswap16(pSym.st_shndx);
+  }
+  pResult.info  = pSym.st_info;
+  pResult.other = pSym.st_other;
+  pResult.name  = llvm::StringRef(pStrTab + st_name);
+}
+
+/// readSymbol - create LDSymbol from a decoded ELF symbol
+void ELFReader<64, true>::readSymbol(Input& pInput,
+                                     IRBuilder& pBuilder,
+                                     const RawSymbol& pSym,
+                                     std::vector<AliasInfo>& pAliases) const
+{
+  uint64_t st_value = pSym.value;
+  uint64_t st_size  = pSym.size;
+  uint8_t  st_info  = pSym.info;
+  uint8_t  st_other = pSym.other;
+  uint16_t st_shndx = pSym.shndx;
+
+  // If the section should not be included, set the st_shndx SHN_UNDEF
+  // - A section in interrelated groups are not included.
+  if (pInput.type() == Input::Object &&
+      st_shndx < llvm::ELF::SHN_LORESERVE &&
+      st_shndx != llvm::ELF::SHN_UNDEF) {
+    if (NULL == pInput.context()->getSection(st_shndx))
+      st_shndx = llvm::ELF::SHN_UNDEF;
+  }
+
+  // get ld_type
+  ResolveInfo::Type ld_type = getSymType(st_info, st_shndx);
+
+  // get ld_desc
+  ResolveInfo::Desc ld_desc = getSymDesc(st_shndx, pInput);
+
+  // get ld_binding
+  ResolveInfo::Binding ld_binding = getSymBinding((st_info >> 4), st_shndx, st_other);
+
+  // get ld_value - ld_value must be section relative.
+  uint64_t ld_value = getSymValue(st_value, st_shndx, pInput);
+
+  // get ld_vis
+  ResolveInfo::Visibility ld_vis = getSymVisibility(st_other);
+
+  // get section
+  LDSection* section = NULL;
+  if (st_shndx < llvm::ELF::SHN_LORESERVE) // including ABS and COMMON
+    section = pInput.context()->getSection(st_shndx);
+
+  // get ld_name, which refers to the string table or the section name
+  // directly. The name is copied only once, into the ResolveInfo.
+  llvm::StringRef ld_name;
+  if (ResolveInfo::Section == ld_type) {
+    // Section symbol's st_name is the section index.
+    assert(NULL != section && "get a invalid section");
+    ld_name = section->name();
+  }
+  else {
+    ld_name = pSym.name;
+  }
+
+  LDSymbol* psym = pBuilder.AddSymbol(pInput,
+                                      ld_name,
+                                      ld_type,
+                                      ld_desc,
+                                      ld_binding,
+                                      st_size,
+                                      ld_value,
+                                      section,
+                                      ld_vis);
+
+  // recording symbols added from DynObj to analyze weak alias
+  if (pInput.type() == Input::DynObj
+      && NULL != psym
+      && ResolveInfo::Undefined != ld_desc
+      && (ResolveInfo::Global == ld_binding ||
+          ResolveInfo::Weak == ld_binding)
+      && ResolveInfo::Object == ld_type) {
+    AliasInfo p;
+    p.pt_alias = psym;
+    p.ld_binding = ld_binding;
+    p.ld_value = ld_value;
+    pAliases.push_back(p);
+  }
+}
+
+/// analyzeAliases - analyze the weak aliases of a DynObj
+void ELFReader<64, true>::analyzeAliases(IRBuilder& pBuilder,
+                                         std::vector<AliasInfo>& pAliases)
+{
+  // sort symbols by symbol value and then weak before strong
+  std::sort(pAliases.begin(), pAliases.end(), less);
+
+  // for each weak symbol, find out all its aliases, and
+  // then link them as a circular list in Module
+  std::vector<AliasInfo>::iterator sym_it, sym_e;
+  sym_e = pAliases.end();
+  for (sym_it = pAliases.begin(); sym_it!=sym_e; ++sym_it) {
+    if (ResolveInfo::Weak!=sym_it->ld_binding)
+      continue;
+
+    Module& pModule = pBuilder.getModule();
+    std::vector<AliasInfo>::iterator alias_it = sym_it+1;
+    while(alias_it!=sym_e) {
+      if (sym_it->ld_value != alias_it->ld_value)
+        break;
+
+      if (sym_it + 1 == alias_it)
+        pModule.CreateAliasList(*sym_it->pt_alias->resolveInfo());
+      pModule.addAlias(*alias_it->pt_alias->resolveInfo());
+      ++alias_it;
+    }
+
+    sym_it = alias_it - 1;
+  }// end of for loop
 }
 
 //===----------------------------------------------------------------------===//
@@ -871,6 +1098,7 @@ bool ELFReader<64, true>::readSectionHeaders(Input& pInput,
   uint32_t sh_link      = 0x0;
   uint32_t sh_info      = 0x0;
   uint64_t sh_addralign = 0x0;
+  uint64_t sh_entsize   = 0x0;
 
   // if shnum and shstrtab overflow, the actual values are in the 1st shdr
   if (shnum == llvm::ELF::SHN_UNDEF || shstrtab == llvm::ELF::SHN_XINDEX) {
@@ -928,6 +1156,7 @@ bool ELFReader<64, true>::readSectionHeaders(Input& pInput,
       sh_link      = shdrTab[idx].sh_link;
       sh_info      = shdrTab[idx].sh_info;
       sh_addralign = shdrTab[idx].sh_addralign;
+      sh_entsize   = shdrTab[idx].sh_entsize;
     }
     else {
       sh_name      = mcld::bswap32(shdrTab[idx].sh_name);
@@ -938,6 +1167,7 @@ bool ELFReader<64, true>::readSectionHeaders(Input& pInput,
       sh_link      = mcld::bswap32(shdrTab[idx].sh_link);
       sh_info      = mcld::bswap32(shdrTab[idx].sh_info);
       sh_addralign = mcld::bswap64(shdrTab[idx].sh_addralign);
+      sh_entsize   = mcld::bswap64(shdrTab[idx].sh_entsize);
     }
 
     LDSection* section = IRBuilder::CreateELFHeader(pInput,
@@ -948,6 +1178,7 @@ bool ELFReader<64, true>::readSectionHeaders(Input& pInput,
     section->setSize(sh_size);
     section->setOffset(sh_offset);
     section->setInfo(sh_info);
+    section->setEntSize(sh_entsize);
 
     if (sh_link != 0x0 || sh_info != 0x0) {
       LinkInfo link_info = { section, sh_link, sh_info };
@@ -13,6 +13,7 @@
 #include <mcld/LinkerConfig.h>
 #include <mcld/MC/Attribute.h>
 #include <mcld/MC/Input.h>
+#include <mcld/LD/NamePool.h>
 #include <mcld/LD/ResolveInfo.h>
 #include <mcld/LD/ELFObjectReader.h>
 #include <mcld/Support/FileSystem.h>
@@ -99,6 +100,8 @@ bool GNUArchiveReader::readArchive(const LinkerConfig& pConfig,
   if (pArchive.getARFile().attribute()->isWholeArchive())
     return includeAllMembers(pConfig, pArchive);
 
+  const NamePool::UndefList& undefs = m_Module.getNamePool().undefs();
+
   // if this is the first time read this archive, setup symtab and strtab
   if (pArchive.getSymbolTable().empty()) {
   // read the symtab of the archive
@@ -111,37 +114,61 @@ bool GNUArchiveReader::readArchive(const LinkerConfig& pConfig,
   pArchive.addArchiveMember(pArchive.getARFile().name(),
                             pArchive.inputs().root(),
                             &InputTree::Downward);
+
+  // look up every armap entry once. The undefined symbols created from now
+  // on are handled by the worklist below.
+  pArchive.setUndefCursor(undefs.size());
+  for (size_t idx = 0; idx < pArchive.numOfSymbols(); ++idx)
+    probeSymbol(pConfig, pArchive, idx);
   }
 
-  // include the needed members in the archive and build up the input tree
-  bool willSymResolved;
-  do {
-    willSymResolved = false;
-    for (size_t idx = 0; idx < pArchive.numOfSymbols(); ++idx) {
-      // bypass if we already decided to include this symbol or not
-      if (Archive::Symbol::Unknown != pArchive.getSymbolStatus(idx))
-        continue;
+  // include the members that define the undefined symbols which show up after
+  // the last visit. Including a member may append new undefined symbols, so
+  // the list is accessed by index.
+  size_t cursor = pArchive.getUndefCursor();
+  while (cursor < undefs.size()) {
+    const ResolveInfo* info = undefs[cursor++];
+    llvm::StringRef name(info->name(), info->nameSize());
+    for (size_t idx = pArchive.findSymbol(name, info->hash());
+         idx != pArchive.numOfSymbols();
+         idx = pArchive.getNextSymbol(idx)) {
+      probeSymbol(pConfig, pArchive, idx);
+    }
+  }
+  pArchive.setUndefCursor(cursor);
 
-      // bypass if another symbol with the same object file offset is included
-      if (pArchive.hasObjectMember(pArchive.getObjFileOffset(idx))) {
-        pArchive.setSymbolStatus(idx, Archive::Symbol::Include);
-        continue;
-      }
-
-      // check if we should include this defined symbol
-      Archive::Symbol::Status status =
-        shouldIncludeSymbol(pArchive.getSymbolName(idx));
-      if (Archive::Symbol::Unknown != status)
-        pArchive.setSymbolStatus(idx, status);
-
-      if (Archive::Symbol::Include == status) {
-        // include the object member from the given offset
-        includeMember(pConfig, pArchive, pArchive.getObjFileOffset(idx));
-        willSymResolved = true;
-      } // end of if
-    } // end of for
-  } while (willSymResolved);
+  return true;
+}
+
+/// probeSymbol - decide whether the armap entry pSymIdx should be included,
+/// and include the corresponding member if so
+/// @return true if the member is included by this call
+bool GNUArchiveReader::probeSymbol(const LinkerConfig& pConfig,
+                                   Archive& pArchive,
+                                   size_t pSymIdx)
+{
+  // bypass if we already decided to include this symbol or not
+  if (Archive::Symbol::Unknown != pArchive.getSymbolStatus(pSymIdx))
+    return false;
+
+  // bypass if another symbol with the same object file offset is included
+  if (pArchive.hasObjectMember(pArchive.getObjFileOffset(pSymIdx))) {
+    pArchive.setSymbolStatus(pSymIdx, Archive::Symbol::Include);
+    return false;
+  }
+
+  // check if we should include this defined symbol
+  Archive::Symbol::Status status =
+    shouldIncludeSymbol(pArchive.getSymbolName(pSymIdx),
+                        pArchive.getSymbolHash(pSymIdx));
+  if (Archive::Symbol::Unknown != status)
+    pArchive.setSymbolStatus(pSymIdx, status);
+
+  if (Archive::Symbol::Include != status)
+    return false;
 
+  // include the object member from the given offset
+  includeMember(pConfig, pArchive, pArchive.getObjFileOffset(pSymIdx));
   return true;
 }
 
@@ -342,10 +369,11 @@ bool GNUArchiveReader::readStringTable(Archive& pArchive)
 /// shouldIncludeStatus - given a sym name from armap and check if including
 /// the corresponding archive member, and then return the decision
 enum Archive::Symbol::Status
-GNUArchiveReader::shouldIncludeSymbol(const llvm::StringRef& pSymName) const
+GNUArchiveReader::shouldIncludeSymbol(const llvm::StringRef& pSymName,
+                                      uint32_t pSymHash) const
 {
   // TODO: handle symbol version issue and user defined symbols
-  const ResolveInfo* info = m_Module.getNamePool().findInfo(pSymName);
+  const ResolveInfo* info = m_Module.getNamePool().findInfo(pSymName, pSymHash);
   if (NULL != info) {
     if (!info->isUndef())
       return Archive::Symbol::Exclude;
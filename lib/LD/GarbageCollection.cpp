@@ -17,12 +17,13 @@
 #include <mcld/LD/RelocData.h>
 #include <mcld/LinkerConfig.h>
 #include <mcld/LinkerScript.h>
+#include <mcld/MC/Input.h>
 #include <mcld/Module.h>
+#include <mcld/Support/ThreadPool.h>
 #include <mcld/Target/TargetLDBackend.h>
 
 #include <llvm/Support/Casting.h>
 
-#include <queue>
 #if !defined(MCLD_ON_WIN32)
 #include <fnmatch.h>
 #define fnmatch0(pattern,string) (fnmatch(pattern,string,0) == 0)
@@ -71,39 +72,42 @@ static bool mayProcessGC(const LDSection& pSection)
 }
 
 //===----------------------------------------------------------------------===//
-// GarbageCollection::SectionReachedListMap
+// GarbageCollection::ScanJob
 //===----------------------------------------------------------------------===//
-void
-GarbageCollection::SectionReachedListMap::addReference(const LDSection& pFrom,
-                                                       const LDSection& pTo)
+/// ScanJob - collect the references made by the relocations of an input
+class GarbageCollection::ScanJob : public ThreadPool::Job
 {
-  m_ReachedSections[&pFrom].insert(&pTo);
-}
+public:
+  ScanJob(const GarbageCollection& pGC, const Input& pInput)
+    : m_GC(pGC), m_Input(pInput) {
+  }
 
-GarbageCollection::SectionListTy&
-GarbageCollection::SectionReachedListMap::getReachedList(
-                                                      const LDSection& pSection)
-{
-  return m_ReachedSections[&pSection];
-}
+  void run()
+  { m_GC.scanRelocations(m_Input, m_Edges, m_Others); }
 
-GarbageCollection::SectionListTy*
-GarbageCollection::SectionReachedListMap::findReachedList(
-                                                      const LDSection& pSection)
-{
-  ReachedSectionsTy::iterator it = m_ReachedSections.find(&pSection);
-  if (it == m_ReachedSections.end())
-    return NULL;
-  return &it->second;
-}
+  const EdgeList& edges() const { return m_Edges; }
+
+  const ReferenceList& others() const { return m_Others; }
+
+private:
+  const GarbageCollection& m_GC;
+  const Input& m_Input;
+  EdgeList m_Edges;
+  ReferenceList m_Others;
+};
 
 //===----------------------------------------------------------------------===//
 // GarbageCollection
 //===----------------------------------------------------------------------===//
 GarbageCollection::GarbageCollection(const LinkerConfig& pConfig,
                                      const TargetLDBackend& pBackend,
-                                     Module& pModule)
-  : m_Config(pConfig), m_Backend(pBackend), m_Module(pModule)
+                                     Module& pModule,
+                                     ThreadPool& pThreadPool)
+  : m_SectionIds(1024),
+    m_Config(pConfig),
+    m_Backend(pBackend),
+    m_Module(pModule),
+    m_ThreadPool(pThreadPool)
 {
 }
 
@@ -113,10 +117,10 @@ GarbageCollection::~GarbageCollection()
 
 bool GarbageCollection::run()
 {
-  // 1. traverse all the relocations to set up the reached sections of each
-  // section
+  // 1. number all the input sections, and traverse all the relocations to set
+  // up the reached sections of each section
+  numberSections();
   setUpReachedSections();
-  m_Backend.setUpReachedSectionsForGC(m_Module, m_SectionReachedListMap);
 
   // 2. get all sections defined the entry point
   SectionVecTy entry;
@@ -130,63 +134,145 @@ bool GarbageCollection::run()
   return true;
 }
 
+uint32_t GarbageCollection::getSectionId(const LDSection& pSection)
+{
+  bool exist = false;
+  SectIdEntryType* entry = m_SectionIds.insert(&pSection, exist);
+  if (!exist) {
+    entry->setValue(m_Sections.size());
+    m_Sections.push_back(&pSection);
+  }
+  return entry->value();
+}
+
+bool GarbageCollection::findSectionId(const LDSection& pSection,
+                                      uint32_t& pId) const
+{
+  SectIdTableType::const_iterator entry = m_SectionIds.find(&pSection);
+  if (NULL == entry.getEntry())
+    return false;
+  pId = entry.getEntry()->value();
+  return true;
+}
+
+void GarbageCollection::numberSections()
+{
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sect_iterator sect, sectEnd = (*obj)->context()->sectEnd();
+    for (sect = (*obj)->context()->sectBegin(); sect != sectEnd; ++sect)
+      getSectionId(**sect);
+  }
+}
+
 void GarbageCollection::setUpReachedSections()
 {
-  // traverse all the input relocations to setup the reached sections
+  // traverse the input relocations of each input on the thread pool. The
+  // section numbers are only read in the meantime.
+  std::vector<ScanJob*> jobs;
+  ThreadPool::JobList job_list;
   Module::obj_iterator input, inEnd = m_Module.obj_end();
   for (input = m_Module.obj_begin(); input != inEnd; ++input) {
-    LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
-    for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
-      // bypass the discarded relocation section
-      // 1. its section kind is changed to Ignore. (The target section is a
-      // discarded group section.)
-      // 2. it has no reloc data. (All symbols in the input relocs are in the
-      // discarded group sections)
-      LDSection* reloc_sect = *rs;
-      LDSection* apply_sect = reloc_sect->getLink();
-      if ((LDFileFormat::Ignore == reloc_sect->kind()) ||
-          (!reloc_sect->hasRelocData()))
+    jobs.push_back(new ScanJob(*this, **input));
+    job_list.push_back(jobs.back());
+  }
+  m_ThreadPool.run(job_list);
+
+  // merge the references in the input order. The sections without numbers
+  // yet are numbered here.
+  EdgeList edges;
+  std::vector<ScanJob*>::iterator job, jEnd = jobs.end();
+  for (job = jobs.begin(); job != jEnd; ++job) {
+    edges.insert(edges.end(), (*job)->edges().begin(), (*job)->edges().end());
+    ReferenceList::const_iterator ref, refEnd = (*job)->others().end();
+    for (ref = (*job)->others().begin(); ref != refEnd; ++ref) {
+      edges.push_back(std::make_pair(getSectionId(*ref->first),
+                                     getSectionId(*ref->second)));
+    }
+    delete *job;
+  }
+
+  // the references set up by the backend
+  SectionReachedListMap target_refs;
+  m_Backend.setUpReachedSectionsForGC(m_Module, target_refs);
+  const ReferenceList& refs = target_refs.references();
+  ReferenceList::const_iterator ref, refEnd = refs.end();
+  for (ref = refs.begin(); ref != refEnd; ++ref) {
+    edges.push_back(std::make_pair(getSectionId(*ref->first),
+                                   getSectionId(*ref->second)));
+  }
+
+  buildAdjacency(edges);
+}
+
+void GarbageCollection::scanRelocations(const Input& pInput,
+                                        EdgeList& pEdges,
+                                        ReferenceList& pOthers) const
+{
+  LDContext::const_sect_iterator rs, rsEnd = pInput.context()->relocSectEnd();
+  for (rs = pInput.context()->relocSectBegin(); rs != rsEnd; ++rs) {
+    // bypass the discarded relocation section
+    // 1. its section kind is changed to Ignore. (The target section is a
+    // discarded group section.)
+    // 2. it has no reloc data. (All symbols in the input relocs are in the
+    // discarded group sections)
+    LDSection* reloc_sect = *rs;
+    LDSection* apply_sect = reloc_sect->getLink();
+    if ((LDFileFormat::Ignore == reloc_sect->kind()) ||
+        (!reloc_sect->hasRelocData()))
+      continue;
+
+    // bypass the apply target sections which are not handled by gc
+    if (!mayProcessGC(*apply_sect))
+      continue;
+
+    uint32_t apply_id = 0;
+    bool apply_has_id = findSectionId(*apply_sect, apply_id);
+    RelocData::iterator reloc_it, rEnd = reloc_sect->getRelocData()->end();
+    for (reloc_it = reloc_sect->getRelocData()->begin(); reloc_it != rEnd;
+                                                                 ++reloc_it) {
+      Relocation* reloc = llvm::cast<Relocation>(reloc_it);
+      ResolveInfo* sym = reloc->symInfo();
+      // only the target symbols defined in the input fragments can make the
+      // reference
+      if (NULL == sym)
+        continue;
+      if (!sym->isDefine() || !sym->outSymbol()->hasFragRef())
         continue;
 
-      // bypass the apply target sections which are not handled by gc
-      if (!mayProcessGC(*apply_sect))
+      // only the target symbols defined in the concerned sections can make
+      // the reference
+      const LDSection* target_sect =
+              &sym->outSymbol()->fragRef()->frag()->getParent()->getSection();
+      if (!mayProcessGC(*target_sect))
         continue;
 
-      bool add_first = false;
-      SectionListTy* reached_sects = NULL;
-      RelocData::iterator reloc_it, rEnd = reloc_sect->getRelocData()->end();
-      for (reloc_it = reloc_sect->getRelocData()->begin(); reloc_it != rEnd;
-                                                                   ++reloc_it) {
-        Relocation* reloc = llvm::cast<Relocation>(reloc_it);
-        ResolveInfo* sym = reloc->symInfo();
-        // only the target symbols defined in the input fragments can make the
-        // reference
-        if (NULL == sym)
-          continue;
-        if (!sym->isDefine() || !sym->outSymbol()->hasFragRef())
-          continue;
-
-        // only the target symbols defined in the concerned sections can make
-        // the reference
-        const LDSection* target_sect =
-                &sym->outSymbol()->fragRef()->frag()->getParent()->getSection();
-        if (!mayProcessGC(*target_sect))
-          continue;
-
-        // setup the reached list, if we first add the element to reached list
-        // of this section, create an entry in ReachedSections map
-        if (!add_first) {
-          reached_sects = &m_SectionReachedListMap.getReachedList(*apply_sect);
-          add_first = true;
-        }
-        reached_sects->insert(target_sect);
-      }
-      reached_sects = NULL;
-      add_first = false;
+      uint32_t target_id = 0;
+      if (apply_has_id && findSectionId(*target_sect, target_id))
+        pEdges.push_back(std::make_pair(apply_id, target_id));
+      else
+        pOthers.push_back(std::make_pair(apply_sect, target_sect));
     }
   }
 }
 
+void GarbageCollection::buildAdjacency(const EdgeList& pEdges)
+{
+  // counting sort the edges by their sources
+  size_t num_sects = m_Sections.size();
+  m_ReachedBegin.assign(num_sects + 1, 0);
+  EdgeList::const_iterator edge, eEnd = pEdges.end();
+  for (edge = pEdges.begin(); edge != eEnd; ++edge)
+    ++m_ReachedBegin[edge->first + 1];
+  for (size_t i = 0; i < num_sects; ++i)
+    m_ReachedBegin[i + 1] += m_ReachedBegin[i];
+
+  std::vector<uint32_t> pos(m_ReachedBegin.begin(), m_ReachedBegin.end() - 1);
+  m_Reached.resize(pEdges.size());
+  for (edge = pEdges.begin(); edge != eEnd; ++edge)
+    m_Reached[pos[edge->first]++] = edge->second;
+}
+
 void GarbageCollection::getEntrySections(SectionVecTy& pEntry)
 {
   // all the KEEP sections defined in ldscript are entries, traverse all the
@@ -274,38 +360,35 @@ void GarbageCollection::getEntrySections(SectionVecTy& pEntry)
 
 void GarbageCollection::findReferencedSections(SectionVecTy& pEntry)
 {
-  // list of sections waiting to be processed
-  typedef std::queue<const LDSection*> WorkListTy;
-  WorkListTy work_list;
-  // start from each entry, resolve the transitive closure
+  // number the entries first, the sections numbered after the references are
+  // set up reach no section
+  std::vector<uint32_t> entry_ids;
   SectionVecTy::iterator entry_it, entry_end = pEntry.end();
-  for (entry_it = pEntry.begin(); entry_it != entry_end; ++entry_it) {
-    // add entry point to work list
-    work_list.push(*entry_it);
-
-    // add section from the work_list to the referencedSections until every
-    // reached sections are added
-    while (!work_list.empty()) {
-      const LDSection* sect = work_list.front();
-      work_list.pop();
-      // add section to the ReferencedSections, if the section has been put into
-      // referencedSections, skip this section
-      if (!m_ReferencedSections.insert(sect).second)
-        continue;
-
-      // get the section reached list, if the section do not has one, which
-      // means no referenced between it and other sections, then skip it
-      SectionListTy* reach_list =
-                                 m_SectionReachedListMap.findReachedList(*sect);
-      if (NULL == reach_list)
-        continue;
+  for (entry_it = pEntry.begin(); entry_it != entry_end; ++entry_it)
+    entry_ids.push_back(getSectionId(**entry_it));
+  m_ReachedBegin.resize(m_Sections.size() + 1, m_ReachedBegin.back());
+  m_Referenced.assign(m_Sections.size(), false);
+
+  // list of sections waiting to be processed. A section is marked when it is
+  // pushed, so each section is pushed at most once.
+  std::vector<uint32_t> work_list;
+  std::vector<uint32_t>::iterator id, idEnd = entry_ids.end();
+  for (id = entry_ids.begin(); id != idEnd; ++id) {
+    if (!m_Referenced[*id]) {
+      m_Referenced[*id] = true;
+      work_list.push_back(*id);
+    }
+  }
 
-      // put the reached sections to work list, skip the one already be in
-      // referencedSections
-      SectionListTy::iterator it, end = reach_list->end();
-      for (it = reach_list->begin(); it != end; ++it) {
-        if (m_ReferencedSections.find(*it) == m_ReferencedSections.end())
-          work_list.push(*it);
+  // resolve the transitive closure of the entries
+  while (!work_list.empty()) {
+    uint32_t id = work_list.back();
+    work_list.pop_back();
+    for (uint32_t i = m_ReachedBegin[id]; i < m_ReachedBegin[id + 1]; ++i) {
+      uint32_t reached = m_Reached[i];
+      if (!m_Referenced[reached]) {
+        m_Referenced[reached] = true;
+        work_list.push_back(reached);
       }
     }
   }
@@ -323,7 +406,8 @@ void GarbageCollection::stripSections()
       if (!mayProcessGC(*section))
         continue;
 
-      if (m_ReferencedSections.find(section) == m_ReferencedSections.end())
+      uint32_t id = 0;
+      if (!findSectionId(*section, id) || !m_Referenced[id])
         section->setKind(LDFileFormat::Ignore);
     }
   }
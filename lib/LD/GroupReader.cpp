@@ -115,7 +115,9 @@ bool GroupReader::readGroup(Module::input_iterator pRoot,
   }
 
   // after read in all the archives, traverse the archive list in a loop until
-  // there is no unresolved symbols added
+  // there is no unresolved symbols added. Each archive only looks up the
+  // undefined symbols added since its last visit, so a pass costs the number
+  // of new undefined symbols rather than the size of the armaps.
   ArchiveListType::iterator it = ar_list.begin();
   ArchiveListType::iterator end = ar_list.end();
   while (cur_obj_cnt != last_obj_cnt) {
@@ -0,0 +1,550 @@
+//===- IdenticalCodeFolding.cpp -------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/ADT/StringHash.h>
+#include <mcld/Fragment/FragmentRef.h>
+#include <mcld/Fragment/RegionFragment.h>
+#include <mcld/Fragment/Relocation.h>
+#include <mcld/LD/IdenticalCodeFolding.h>
+#include <mcld/LD/LDContext.h>
+#include <mcld/LD/LDFileFormat.h>
+#include <mcld/LD/LDSection.h>
+#include <mcld/LD/LDSymbol.h>
+#include <mcld/LD/RelocData.h>
+#include <mcld/LD/ResolveInfo.h>
+#include <mcld/LD/SectionData.h>
+#include <mcld/LinkerConfig.h>
+#include <mcld/MC/Input.h>
+#include <mcld/Module.h>
+#include <mcld/Support/ThreadPool.h>
+#include <mcld/Target/TargetLDBackend.h>
+
+#include <llvm/Support/Casting.h>
+#include <llvm/Support/ELF.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+using namespace mcld;
+
+//===----------------------------------------------------------------------===//
+// Non-member functions
+//===----------------------------------------------------------------------===//
+namespace {
+
+/// Mix - mix pValue into the hash value pHash
+inline uint32_t Mix(uint32_t pHash, uint64_t pValue)
+{
+  pHash = (pHash ^ (uint32_t)pValue) * 0x01000193u;
+  return (pHash ^ (uint32_t)(pValue >> 32)) * 0x01000193u;
+}
+
+/// isFoldable - check if pSection is a code section which may be folded
+bool isFoldable(const LDSection& pSection)
+{
+  if (LDFileFormat::Regular != pSection.kind() ||
+      llvm::ELF::SHT_PROGBITS != pSection.type())
+    return false;
+
+  uint32_t flag = pSection.flag();
+  if (0x0 == (flag & llvm::ELF::SHF_ALLOC) ||
+      0x0 == (flag & llvm::ELF::SHF_EXECINSTR) ||
+      0x0 != (flag & llvm::ELF::SHF_WRITE))
+    return false;
+
+  // the pieces of .init and .fini are concatenated into one function
+  if (".init" == pSection.name() || ".fini" == pSection.name())
+    return false;
+
+  // only the sections read as a whole region
+  return (0x0 != pSection.size() &&
+          pSection.hasSectionData() &&
+          1 == pSection.getSectionData()->size() &&
+          llvm::isa<RegionFragment>(pSection.getSectionData()->front()) &&
+          pSection.getSectionData()->front().size() == pSection.size());
+}
+
+typedef std::pair<std::pair<size_t, uint32_t>, size_t> ClassKey;
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// IdenticalCodeFolding::CollectJob
+//===----------------------------------------------------------------------===//
+/// CollectJob - record the relocations of an input
+class IdenticalCodeFolding::CollectJob : public ThreadPool::Job
+{
+public:
+  CollectJob(const IdenticalCodeFolding& pICF, const Input& pInput)
+    : m_ICF(pICF), m_Input(pInput) {
+  }
+
+  void run()
+  { m_ICF.collectRelocations(m_Input, m_Taken); }
+
+  const std::vector<size_t>& taken() const { return m_Taken; }
+
+private:
+  const IdenticalCodeFolding& m_ICF;
+  const Input& m_Input;
+  std::vector<size_t> m_Taken;
+};
+
+//===----------------------------------------------------------------------===//
+// IdenticalCodeFolding::HashJob
+//===----------------------------------------------------------------------===//
+/// HashJob - hash a range of candidates. Without classes, the contents and
+/// the relocations are hashed into the candidates. Otherwise the classes of
+/// the referred candidates are hashed into pHashes.
+class IdenticalCodeFolding::HashJob : public ThreadPool::Job
+{
+public:
+  HashJob(const std::vector<Candidate*>& pCandidates,
+          const std::vector<size_t>* pClasses,
+          std::vector<uint32_t>& pHashes,
+          size_t pBegin,
+          size_t pEnd)
+    : m_Candidates(pCandidates), m_pClasses(pClasses), m_Hashes(pHashes),
+      m_Begin(pBegin), m_End(pEnd) {
+  }
+
+  void run() {
+    static const hash::StringHash<hash::DJB> hash_func =
+                                                  hash::StringHash<hash::DJB>();
+    for (size_t idx = m_Begin; idx < m_End; ++idx) {
+      Candidate& cand = *m_Candidates[idx];
+      RelocList::const_iterator reloc, rEnd = cand.relocs.end();
+      if (NULL == m_pClasses) {
+        uint32_t result = hash_func(cand.content);
+        result = Mix(result, cand.section->align());
+        for (reloc = cand.relocs.begin(); reloc != rEnd; ++reloc) {
+          result = Mix(result, reloc->offset);
+          result = Mix(result, reloc->type);
+          result = Mix(result, reloc->addend);
+          result = Mix(result, reloc->targetOffset);
+        }
+        cand.hash = result;
+      }
+      else {
+        uint32_t result = 0;
+        for (reloc = cand.relocs.begin(); reloc != rEnd; ++reloc) {
+          if (NotCandidate != reloc->candidate)
+            result = Mix(result, (*m_pClasses)[reloc->candidate]);
+        }
+        m_Hashes[idx] = result;
+      }
+    }
+  }
+
+private:
+  const std::vector<Candidate*>& m_Candidates;
+  const std::vector<size_t>* m_pClasses;
+  std::vector<uint32_t>& m_Hashes;
+  size_t m_Begin;
+  size_t m_End;
+};
+
+//===----------------------------------------------------------------------===//
+// IdenticalCodeFolding::RewriteJob
+//===----------------------------------------------------------------------===//
+/// RewriteJob - move the symbols of an input
+class IdenticalCodeFolding::RewriteJob : public ThreadPool::Job
+{
+public:
+  RewriteJob(const IdenticalCodeFolding& pICF, Input& pInput)
+    : m_ICF(pICF), m_Input(pInput) {
+  }
+
+  void run()
+  { m_ICF.rewriteInput(m_Input); }
+
+private:
+  const IdenticalCodeFolding& m_ICF;
+  Input& m_Input;
+};
+
+//===----------------------------------------------------------------------===//
+// IdenticalCodeFolding
+//===----------------------------------------------------------------------===//
+const size_t IdenticalCodeFolding::NotCandidate = ~size_t(0);
+
+IdenticalCodeFolding::IdenticalCodeFolding(const LinkerConfig& pConfig,
+                                           const TargetLDBackend& pBackend,
+                                           Module& pModule,
+                                           ThreadPool& pThreadPool)
+  : m_CandidateIds(1024),
+    m_Config(pConfig),
+    m_Backend(pBackend),
+    m_Module(pModule),
+    m_ThreadPool(pThreadPool)
+{
+}
+
+IdenticalCodeFolding::~IdenticalCodeFolding()
+{
+  std::vector<Candidate*>::iterator cand, cEnd = m_Candidates.end();
+  for (cand = m_Candidates.begin(); cand != cEnd; ++cand)
+    delete *cand;
+}
+
+bool IdenticalCodeFolding::run()
+{
+  if (LinkerConfig::Object == m_Config.codeGenType() ||
+      GeneralOptions::ICFNone == m_Config.options().getICFMode())
+    return true;
+
+  // 1. collect the candidate sections and their relocations
+  findCandidates();
+  if (m_Candidates.empty())
+    return true;
+
+  ThreadPool::JobList job_list;
+  std::vector<CollectJob*> collect_jobs;
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    collect_jobs.push_back(new CollectJob(*this, **obj));
+    job_list.push_back(collect_jobs.back());
+  }
+  m_ThreadPool.run(job_list);
+
+  // 2. keep the sections whose addresses may be taken
+  bool safe = (GeneralOptions::ICFSafe == m_Config.options().getICFMode());
+  for (size_t i = 0; i < collect_jobs.size(); ++i) {
+    if (safe) {
+      std::vector<size_t>::const_iterator taken,
+                                          tEnd = collect_jobs[i]->taken().end();
+      for (taken = collect_jobs[i]->taken().begin(); taken != tEnd; ++taken)
+        m_Candidates[*taken]->keep = true;
+    }
+    delete collect_jobs[i];
+  }
+  if (safe)
+    markExported();
+
+  // 3. find the identical sections
+  findClasses(m_Candidates, m_FoldTo, m_ThreadPool);
+
+  bool folded = false;
+  for (size_t idx = 0; idx < m_FoldTo.size(); ++idx) {
+    if (idx != m_FoldTo[idx]) {
+      m_Candidates[idx]->section->setKind(LDFileFormat::Ignore);
+      folded = true;
+    }
+  }
+  if (!folded)
+    return true;
+
+  // 4. move the symbols to the kept sections
+  job_list.clear();
+  std::vector<RewriteJob*> rewrite_jobs;
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    rewrite_jobs.push_back(new RewriteJob(*this, **obj));
+    job_list.push_back(rewrite_jobs.back());
+  }
+  m_ThreadPool.run(job_list);
+  for (size_t i = 0; i < rewrite_jobs.size(); ++i)
+    delete rewrite_jobs[i];
+  return true;
+}
+
+void IdenticalCodeFolding::findClasses(
+                                    const std::vector<Candidate*>& pCandidates,
+                                    std::vector<size_t>& pClasses,
+                                    ThreadPool& pThreadPool)
+{
+  size_t num = pCandidates.size();
+  pClasses.resize(num);
+  for (size_t idx = 0; idx < num; ++idx)
+    pClasses[idx] = idx;
+  if (0 == num)
+    return;
+
+  // 1. hash the contents and the relocations, one range per thread
+  std::vector<uint32_t> hashes(num, 0);
+  std::vector<HashJob*> hash_jobs;
+  ThreadPool::JobList job_list;
+  size_t chunk = (num + pThreadPool.size() - 1) / pThreadPool.size();
+  for (size_t begin = 0; begin < num; begin += chunk) {
+    size_t end = (begin + chunk < num) ? (begin + chunk) : num;
+    hash_jobs.push_back(new HashJob(pCandidates, NULL, hashes, begin, end));
+    job_list.push_back(hash_jobs.back());
+  }
+  pThreadPool.run(job_list);
+  for (size_t i = 0; i < hash_jobs.size(); ++i)
+    delete hash_jobs[i];
+
+  // 2. the initial classes by the contents and the relocations. The kept
+  // candidates are classes by themselves.
+  std::vector<ClassKey> order;
+  order.reserve(num);
+  for (size_t idx = 0; idx < num; ++idx) {
+    if (!pCandidates[idx]->keep)
+      order.push_back(ClassKey(std::make_pair(size_t(0),
+                                              pCandidates[idx]->hash),
+                               idx));
+  }
+  std::sort(order.begin(), order.end());
+
+  size_t num_classes = num - order.size();
+  std::vector<size_t> reps;
+  for (size_t i = 0; i < order.size(); ++i) {
+    if (0 == i || order[i].first != order[i - 1].first)
+      reps.clear();
+    const Candidate& cand = *pCandidates[order[i].second];
+    std::vector<size_t>::iterator rep, repEnd = reps.end();
+    for (rep = reps.begin(); rep != repEnd; ++rep) {
+      if (isConstantEqual(*pCandidates[*rep], cand))
+        break;
+    }
+    if (rep == repEnd) {
+      reps.push_back(order[i].second);
+      ++num_classes;
+      continue;
+    }
+    pClasses[order[i].second] = *rep;
+  }
+
+  // 3. refine the classes by the classes of the referred candidates until
+  // nothing changes
+  std::vector<size_t> new_classes(num);
+  while (true) {
+    job_list.clear();
+    hash_jobs.clear();
+    for (size_t begin = 0; begin < num; begin += chunk) {
+      size_t end = (begin + chunk < num) ? (begin + chunk) : num;
+      hash_jobs.push_back(new HashJob(pCandidates, &pClasses, hashes,
+                                      begin, end));
+      job_list.push_back(hash_jobs.back());
+    }
+    pThreadPool.run(job_list);
+    for (size_t i = 0; i < hash_jobs.size(); ++i)
+      delete hash_jobs[i];
+
+    for (size_t i = 0; i < order.size(); ++i) {
+      size_t idx = order[i].second;
+      order[i].first = std::make_pair(pClasses[idx], hashes[idx]);
+    }
+    std::sort(order.begin(), order.end());
+
+    size_t new_num_classes = num - order.size();
+    new_classes = pClasses;
+    for (size_t i = 0; i < order.size(); ++i) {
+      if (0 == i || order[i].first != order[i - 1].first)
+        reps.clear();
+      const Candidate& cand = *pCandidates[order[i].second];
+      std::vector<size_t>::iterator rep, repEnd = reps.end();
+      for (rep = reps.begin(); rep != repEnd; ++rep) {
+        if (isVariableEqual(*pCandidates[*rep], cand, pClasses))
+          break;
+      }
+      if (rep == repEnd) {
+        reps.push_back(order[i].second);
+        new_classes[order[i].second] = order[i].second;
+        ++new_num_classes;
+        continue;
+      }
+      new_classes[order[i].second] = *rep;
+    }
+
+    pClasses.swap(new_classes);
+    // the classes are only split, so the same number means the same classes
+    if (new_num_classes == num_classes)
+      break;
+    num_classes = new_num_classes;
+  }
+}
+
+bool IdenticalCodeFolding::isConstantEqual(const Candidate& pX,
+                                           const Candidate& pY)
+{
+  if (pX.hash != pY.hash ||
+      pX.section->align() != pY.section->align() ||
+      pX.section->flag() != pY.section->flag() ||
+      pX.content != pY.content ||
+      pX.relocs.size() != pY.relocs.size())
+    return false;
+
+  for (size_t i = 0; i < pX.relocs.size(); ++i) {
+    const Reloc& x = pX.relocs[i];
+    const Reloc& y = pY.relocs[i];
+    if (x.offset != y.offset ||
+        x.type != y.type ||
+        x.addend != y.addend ||
+        x.targetOffset != y.targetOffset)
+      return false;
+    if ((NotCandidate == x.candidate) != (NotCandidate == y.candidate))
+      return false;
+    if (NotCandidate == x.candidate && x.target != y.target)
+      return false;
+  }
+  return true;
+}
+
+bool IdenticalCodeFolding::isVariableEqual(const Candidate& pX,
+                                           const Candidate& pY,
+                                           const std::vector<size_t>& pClasses)
+{
+  for (size_t i = 0; i < pX.relocs.size(); ++i) {
+    const Reloc& x = pX.relocs[i];
+    if (NotCandidate == x.candidate)
+      continue;
+    if (pClasses[x.candidate] != pClasses[pY.relocs[i].candidate])
+      return false;
+  }
+  return true;
+}
+
+void IdenticalCodeFolding::findCandidates()
+{
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sect_iterator sect, sectEnd = (*obj)->context()->sectEnd();
+    for (sect = (*obj)->context()->sectBegin(); sect != sectEnd; ++sect) {
+      LDSection* section = *sect;
+      if (!isFoldable(*section))
+        continue;
+
+      Candidate* cand = new Candidate();
+      cand->section = section;
+      cand->content =
+          llvm::cast<RegionFragment>(section->getSectionData()->front())
+                                                                .getRegion();
+      cand->hash = 0;
+      cand->keep = false;
+
+      bool exist = false;
+      SectIdEntryType* entry = m_CandidateIds.insert(section, exist);
+      entry->setValue(m_Candidates.size());
+      m_Candidates.push_back(cand);
+    }
+
+    // the sections linked by the other sections (e.g., .ARM.exidx) are kept
+    for (sect = (*obj)->context()->sectBegin(); sect != sectEnd; ++sect) {
+      if (LDFileFormat::Relocation == (*sect)->kind() ||
+          NULL == (*sect)->getLink())
+        continue;
+      size_t linked = findCandidate(*(*sect)->getLink());
+      if (NotCandidate != linked)
+        m_Candidates[linked]->keep = true;
+    }
+  }
+}
+
+size_t IdenticalCodeFolding::findCandidate(const LDSection& pSection) const
+{
+  SectIdTableType::const_iterator entry = m_CandidateIds.find(&pSection);
+  if (NULL == entry.getEntry())
+    return NotCandidate;
+  return entry.getEntry()->value();
+}
+
+void IdenticalCodeFolding::collectRelocations(const Input& pInput,
+                                              std::vector<size_t>& pTaken) const
+{
+  LDContext::const_sect_iterator rs, rsEnd = pInput.context()->relocSectEnd();
+  for (rs = pInput.context()->relocSectBegin(); rs != rsEnd; ++rs) {
+    LDSection* reloc_sect = *rs;
+    LDSection* apply_sect = reloc_sect->getLink();
+    if ((LDFileFormat::Ignore == reloc_sect->kind()) ||
+        (!reloc_sect->hasRelocData()) ||
+        (LDFileFormat::Ignore == apply_sect->kind()))
+      continue;
+
+    size_t apply = findCandidate(*apply_sect);
+
+    // the references from the unwind tables and the debugging information
+    // do not take the addresses
+    bool may_take = (0x0 != (apply_sect->flag() & llvm::ELF::SHF_ALLOC) &&
+                     LDFileFormat::EhFrame != apply_sect->kind());
+
+    RelocData::iterator reloc_it, rEnd = reloc_sect->getRelocData()->end();
+    for (reloc_it = reloc_sect->getRelocData()->begin(); reloc_it != rEnd;
+                                                                 ++reloc_it) {
+      Relocation* reloc = llvm::cast<Relocation>(reloc_it);
+      Reloc entry;
+      entry.offset = reloc->targetRef().offset();
+      entry.type = reloc->type();
+      entry.addend = reloc->addend();
+      entry.candidate = NotCandidate;
+      entry.target = reloc->symInfo();
+      entry.targetOffset = 0;
+
+      ResolveInfo* sym = reloc->symInfo();
+      if (NULL != sym && NULL != sym->outSymbol() &&
+          sym->outSymbol()->hasFragRef()) {
+        const FragmentRef* ref = sym->outSymbol()->fragRef();
+        entry.target = ref->frag();
+        entry.targetOffset = ref->offset();
+        if (llvm::isa<RegionFragment>(ref->frag())) {
+          entry.candidate =
+                        findCandidate(ref->frag()->getParent()->getSection());
+          if (NotCandidate != entry.candidate) {
+            entry.target = NULL;
+            if (may_take && !m_Backend.isCallRelocation(entry.type))
+              pTaken.push_back(entry.candidate);
+          }
+        }
+      }
+
+      if (NotCandidate != apply)
+        m_Candidates[apply]->relocs.push_back(entry);
+    }
+  }
+}
+
+void IdenticalCodeFolding::markExported()
+{
+  bool export_all = (LinkerConfig::DynObj == m_Config.codeGenType() ||
+                     m_Config.options().exportDynamic());
+
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sym_iterator sym, symEnd = (*obj)->context()->symTabEnd();
+    for (sym = (*obj)->context()->symTabBegin(); sym != symEnd; ++sym) {
+      if (NULL == *sym || !(*sym)->hasFragRef())
+        continue;
+      const ResolveInfo* info = (*sym)->resolveInfo();
+      if (info->isLocal() ||
+          ResolveInfo::Hidden == info->visibility() ||
+          ResolveInfo::Internal == info->visibility())
+        continue;
+      // the symbols referred by the shared objects are exported as well
+      if (!export_all && !info->isInDyn())
+        continue;
+
+      const Fragment* frag = (*sym)->fragRef()->frag();
+      if (!llvm::isa<RegionFragment>(frag))
+        continue;
+      size_t cand = findCandidate(frag->getParent()->getSection());
+      if (NotCandidate != cand)
+        m_Candidates[cand]->keep = true;
+    }
+  }
+}
+
+void IdenticalCodeFolding::rewriteInput(Input& pInput) const
+{
+  // the output symbols of the global symbols share the fragment references of
+  // their input symbols
+  LDContext::sym_iterator sym, symEnd = pInput.context()->symTabEnd();
+  for (sym = pInput.context()->symTabBegin(); sym != symEnd; ++sym) {
+    if (NULL == *sym || !(*sym)->hasFragRef())
+      continue;
+    FragmentRef* frag_ref = (*sym)->fragRef();
+    if (!llvm::isa<RegionFragment>(frag_ref->frag()))
+      continue;
+    size_t cand = findCandidate(frag_ref->frag()->getParent()->getSection());
+    if (NotCandidate == cand || cand == m_FoldTo[cand])
+      continue;
+
+    LDSection* kept = m_Candidates[m_FoldTo[cand]]->section;
+    frag_ref->assign(kept->getSectionData()->front(), frag_ref->offset());
+  }
+}
+
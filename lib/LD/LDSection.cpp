@@ -11,6 +11,7 @@
 #include <mcld/Support/GCFactory.h>
 
 #include <llvm/Support/ManagedStatic.h>
+#include <llvm/Support/Mutex.h>
 
 using namespace mcld;
 
@@ -18,6 +19,9 @@ typedef GCFactory<LDSection, MCLD_SECTIONS_PER_INPUT> SectionFactory;
 
 static llvm::ManagedStatic<SectionFactory> g_SectFactory;
 
+// input section headers are created concurrently, see ObjectReader::readHeader
+static llvm::sys::Mutex g_SectFactoryLock;
+
 //===----------------------------------------------------------------------===//
 // LDSection
 //===----------------------------------------------------------------------===//
@@ -30,6 +34,7 @@ LDSection::LDSection()
     m_Offset(~uint64_t(0)),
     m_Addr(0x0),
     m_Align(0),
+    m_EntSize(0),
     m_Info(0),
     m_pLink(NULL),
     m_Index(0) {
@@ -50,6 +55,7 @@ LDSection::LDSection(const std::string& pName,
     m_Offset(~uint64_t(0)),
     m_Addr(pAddr),
     m_Align(0),
+    m_EntSize(0),
     m_Info(0),
     m_pLink(NULL),
     m_Index(0) {
@@ -72,13 +78,16 @@ LDSection* LDSection::Create(const std::string& pName,
                              uint64_t pSize,
                              uint64_t pAddr)
 {
+  g_SectFactoryLock.acquire();
   LDSection* result = g_SectFactory->allocate();
+  g_SectFactoryLock.release();
   new (result) LDSection(pName, pKind, pType, pFlag, pSize, pAddr);
   return result;
 }
 
 void LDSection::Destroy(LDSection*& pSection)
 {
+  llvm::sys::ScopedLock lock(g_SectFactoryLock);
   g_SectFactory->destroy(pSection);
   g_SectFactory->deallocate(pSection);
   pSection = NULL;
@@ -86,6 +95,7 @@ void LDSection::Destroy(LDSection*& pSection)
 
 void LDSection::Clear()
 {
+  llvm::sys::ScopedLock lock(g_SectFactoryLock);
   g_SectFactory->clear();
 }
 
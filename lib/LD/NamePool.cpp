@@ -10,13 +10,15 @@
 #include <mcld/LD/NamePool.h>
 #include <mcld/LD/StaticResolver.h>
 
+#include <cassert>
+
 using namespace mcld;
 
 //===----------------------------------------------------------------------===//
 // NamePool
 //===----------------------------------------------------------------------===//
 NamePool::NamePool(NamePool::size_type pSize)
-  : m_pResolver(new StaticResolver()), m_Table(pSize) {
+  : m_pResolver(new StaticResolver()), m_pLoader(NULL), m_Table(pSize) {
 }
 
 NamePool::~NamePool()
@@ -40,6 +42,7 @@ ResolveInfo* NamePool::createSymbol(const llvm::StringRef& pName,
 {
   ResolveInfo** result = m_FreeInfoSet.allocate();
   (*result) = ResolveInfo::Create(pName);
+  (*result)->setHash(m_Table.hash()(pName));
   (*result)->setIsSymbol(true);
   (*result)->setSource(pIsDyn);
   (*result)->setType(pType);
@@ -64,12 +67,18 @@ void NamePool::insertSymbol(const llvm::StringRef& pName,
                               ResolveInfo* pOldInfo,
                               Resolver::Result& pResult)
 {
+  uint32_t hash = m_Table.hash()(pName);
+
+  // The deferred symbols of the name are resolved before this one.
+  if (NULL != m_pLoader)
+    loadSymbols(pName, hash);
+
   // We should check if there is any symbol with the same name existed.
   // If it already exists, we should use resolver to decide which symbol
   // should be reserved. Otherwise, we insert the symbol and set up its
   // attributes.
   bool exist = false;
-  ResolveInfo* old_symbol = m_Table.insert(pName, exist);
+  ResolveInfo* old_symbol = m_Table.insert(pName, hash, exist);
   ResolveInfo* new_symbol = NULL;
   if (exist && old_symbol->isSymbol()) {
     new_symbol = m_Table.getEntryFactory().produce(pName);
@@ -78,6 +87,7 @@ void NamePool::insertSymbol(const llvm::StringRef& pName,
     exist = false;
     new_symbol = old_symbol;
   }
+  new_symbol->setHash(hash);
 
   new_symbol->setIsSymbol(true);
   new_symbol->setSource(pIsDyn);
@@ -92,6 +102,8 @@ void NamePool::insertSymbol(const llvm::StringRef& pName,
     pResult.info      = new_symbol;
     pResult.existent  = false;
     pResult.overriden = true;
+    if (new_symbol->isUndef() && !new_symbol->isWeak())
+      m_Undefs.push_back(new_symbol);
     return;
   }
   else if (NULL != pOldInfo) {
@@ -100,6 +112,8 @@ void NamePool::insertSymbol(const llvm::StringRef& pName,
   }
 
   // exist and is a symbol
+  bool was_undef = old_symbol->isUndef() && !old_symbol->isWeak();
+
   // symbol resolution
   bool override = false;
   unsigned int action = Resolver::LastAction;
@@ -112,6 +126,10 @@ void NamePool::insertSymbol(const llvm::StringRef& pName,
       m_pResolver->resolveAgain(*this, action, *old_symbol, *new_symbol, pResult);
   }
 
+  if (!was_undef && NULL != pResult.info &&
+      pResult.info->isUndef() && !pResult.info->isWeak())
+    m_Undefs.push_back(pResult.info);
+
   m_Table.getEntryFactory().destroy(new_symbol);
   return;
 }
@@ -119,7 +137,10 @@ void NamePool::insertSymbol(const llvm::StringRef& pName,
 llvm::StringRef NamePool::insertString(const llvm::StringRef& pString)
 {
   bool exist = false;
-  ResolveInfo* resolve_info = m_Table.insert(pString, exist);
+  uint32_t hash = m_Table.hash()(pString);
+  ResolveInfo* resolve_info = m_Table.insert(pString, hash, exist);
+  if (!exist)
+    resolve_info->setHash(hash);
   return llvm::StringRef(resolve_info->name(), resolve_info->nameSize());
 }
 
@@ -133,11 +154,20 @@ NamePool::size_type NamePool::capacity() const
   return (m_Table.numOfBuckets() - m_Table.numOfEntries());
 }
 
+/// loadSymbols - ask the loader to insert the deferred symbols of pName
+void NamePool::loadSymbols(const llvm::StringRef& pName, uint32_t pHash)
+{
+  assert(NULL != m_pLoader);
+  Table::iterator iter = m_Table.find(pName, pHash);
+  if (NULL != iter.getEntry() && iter.getEntry()->isSymbol())
+    return;
+  m_pLoader->load(pName);
+}
+
 /// findInfo - find the resolved ResolveInfo
 ResolveInfo* NamePool::findInfo(const llvm::StringRef& pName)
 {
-  Table::iterator iter = m_Table.find(pName);
-  return iter.getEntry();
+  return findInfo(pName, m_Table.hash()(pName));
 }
 
 /// findInfo - find the resolved ResolveInfo
@@ -147,6 +177,23 @@ const ResolveInfo* NamePool::findInfo(const llvm::StringRef& pName) const
   return iter.getEntry();
 }
 
+/// findInfo - find the resolved ResolveInfo by the name and its hash value
+ResolveInfo* NamePool::findInfo(const llvm::StringRef& pName, uint32_t pHash)
+{
+  if (NULL != m_pLoader)
+    loadSymbols(pName, pHash);
+  Table::iterator iter = m_Table.find(pName, pHash);
+  return iter.getEntry();
+}
+
+/// findInfo - find the resolved ResolveInfo by the name and its hash value
+const ResolveInfo*
+NamePool::findInfo(const llvm::StringRef& pName, uint32_t pHash) const
+{
+  Table::const_iterator iter = m_Table.find(pName, pHash);
+  return iter.getEntry();
+}
+
 /// findSymbol - find the resolved output LDSymbol
 LDSymbol* NamePool::findSymbol(const llvm::StringRef& pName)
 {
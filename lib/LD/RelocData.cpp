@@ -11,6 +11,8 @@
 
 #include <llvm/Support/ManagedStatic.h>
 
+#include <cassert>
+
 using namespace mcld;
 
 typedef GCFactory<RelocData, MCLD_SECTIONS_PER_INPUT> RelocDataFactory;
@@ -59,3 +61,12 @@ Relocation& RelocData::remove(Relocation& pRelocation)
   Relocation* rel = m_Relocations.remove(iter);
   return *rel;
 }
+
+void RelocData::reorder(const std::vector<Relocation*>& pRelocs)
+{
+  assert(pRelocs.size() == size());
+  m_Relocations.clear();
+  std::vector<Relocation*>::const_iterator it, ie = pRelocs.end();
+  for (it = pRelocs.begin(); it != ie; ++it)
+    m_Relocations.push_back(*it);
+}
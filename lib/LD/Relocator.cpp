@@ -7,7 +7,9 @@
 //
 //===----------------------------------------------------------------------===//
 #include <mcld/Config/Config.h>
+#include <mcld/ADT/SizeTraits.h>
 #include <mcld/Fragment/Fragment.h>
+#include <mcld/LinkerConfig.h>
 #include <mcld/LD/LDContext.h>
 #include <mcld/LD/LDSection.h>
 #include <mcld/LD/LDSymbol.h>
@@ -19,6 +21,9 @@
 #ifdef HAVE_CXXABI_H
 #include <cxxabi.h>
 #endif
+#include <llvm/Support/Host.h>
+
+#include <cstring>
 #include <sstream>
 
 using namespace mcld;
@@ -62,10 +67,11 @@ void Relocator::partialScanRelocation(Relocation& pReloc,
   if (pReloc.symInfo()->type() == ResolveInfo::Section) {
     LDSymbol* input_sym = pReloc.symInfo()->outSymbol();
 
-    // 1. update the relocation target offset
+    // 1. update the relocation target offset. It is kept in the addend, and
+    // added to the place by ObjectLinker if the output has no addend field.
     assert(input_sym->hasFragRef());
     uint64_t offset = input_sym->fragRef()->getOutputOffset();
-    pReloc.target() += offset;
+    pReloc.setAddend(pReloc.addend() + offset);
 
     // 2. get output section symbol
     // get the output LDSection which the symbol defined in
@@ -78,6 +84,88 @@ void Relocator::partialScanRelocation(Relocation& pReloc,
   }
 }
 
+Relocator::DWord Relocator::readTarget(const Relocation& pReloc) const
+{
+  const FragmentRef& place = pReloc.targetRef();
+  assert(NULL != place.frag());
+
+  // read a word, but not beyond the fragment of the place
+  size_t size = config().targets().bitclass() / 8;
+  size_t avail = 0;
+  if (place.offset() < place.frag()->size())
+    avail = place.frag()->size() - place.offset();
+  if (size > avail)
+    size = avail;
+
+  uint64_t data = 0;
+  uint32_t data32 = 0;
+  void* dest = &data;
+  if (32 == config().targets().bitclass())
+    dest = &data32;
+
+  if (NULL == m_pOutput) {
+    // not applying yet, read the input section
+    place.memcpy(dest, size);
+  }
+  else {
+    const LDSection& sect = place.frag()->getParent()->getSection();
+    std::memcpy(dest, m_pOutput + sect.offset() + place.getOutputOffset(),
+                size);
+  }
+
+  // byte swapping if the host and target have different endian
+  if (llvm::sys::IsLittleEndianHost != config().targets().isLittleEndian()) {
+    data32 = mcld::bswap32(data32);
+    data = mcld::bswap64(data);
+  }
+
+  if (32 == config().targets().bitclass())
+    return data32;
+  return data;
+}
+
+void Relocator::writeTarget(const Relocation& pReloc, DWord pData) const
+{
+  assert(NULL != m_pOutput && "write a relocation before the output is set");
+  const FragmentRef& place = pReloc.targetRef();
+  uint8_t* target_addr = m_pOutput +
+                         place.frag()->getParent()->getSection().offset() +
+                         place.getOutputOffset();
+
+  // byte swapping if target and host has different endian, and then write back
+  Size size = getSize(pReloc.type());
+  if (llvm::sys::IsLittleEndianHost != config().targets().isLittleEndian()) {
+    uint64_t tmp_data = 0;
+
+    switch (size) {
+      case 8u:
+        tmp_data = pData;
+        std::memcpy(target_addr, &tmp_data, 1);
+        break;
+
+      case 16u:
+        tmp_data = mcld::bswap16(pData);
+        std::memcpy(target_addr, &tmp_data, 2);
+        break;
+
+      case 32u:
+        tmp_data = mcld::bswap32(pData);
+        std::memcpy(target_addr, &tmp_data, 4);
+        break;
+
+      case 64u:
+        tmp_data = mcld::bswap64(pData);
+        std::memcpy(target_addr, &tmp_data, 8);
+        break;
+
+      default:
+        break;
+    }
+  }
+  else
+    std::memcpy(target_addr, &pData, size / 8);
+}
+
 void Relocator::issueUndefRef(Relocation& pReloc,
                               LDSection& pSection,
                               Input& pInput)
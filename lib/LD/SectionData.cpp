@@ -12,6 +12,9 @@
 #include <mcld/Support/GCFactory.h>
 
 #include <llvm/Support/ManagedStatic.h>
+#include <llvm/Support/Mutex.h>
+
+#include <algorithm>
 
 using namespace mcld;
 
@@ -19,20 +22,27 @@ typedef GCFactory<SectionData, MCLD_SECTIONS_PER_INPUT> SectDataFactory;
 
 static llvm::ManagedStatic<SectDataFactory> g_SectDataFactory;
 
+// input section data are created concurrently, see ObjectReader::readSectionData
+static llvm::sys::Mutex g_SectDataFactoryLock;
+
 //===----------------------------------------------------------------------===//
 // SectionData
 //===----------------------------------------------------------------------===//
 SectionData::SectionData()
-  : m_pSection(NULL) {
+  : m_IndexState(IndexStale), m_pSection(NULL) {
+  m_Fragments.setOwner(this);
 }
 
 SectionData::SectionData(LDSection &pSection)
-  : m_pSection(&pSection) {
+  : m_IndexState(IndexStale), m_pSection(&pSection) {
+  m_Fragments.setOwner(this);
 }
 
 SectionData* SectionData::Create(LDSection& pSection)
 {
+  g_SectDataFactoryLock.acquire();
   SectionData* result = g_SectDataFactory->allocate();
+  g_SectDataFactoryLock.release();
   new (result) SectionData(pSection);
   return result;
 }
@@ -40,12 +50,93 @@ SectionData* SectionData::Create(LDSection& pSection)
 void SectionData::Destroy(SectionData*& pSection)
 {
   pSection->~SectionData();
+  llvm::sys::ScopedLock lock(g_SectDataFactoryLock);
   g_SectDataFactory->deallocate(pSection);
   pSection = NULL;
 }
 
 void SectionData::Clear()
 {
+  llvm::sys::ScopedLock lock(g_SectDataFactoryLock);
   g_SectDataFactory->clear();
 }
 
+
+Fragment* SectionData::findFragment(uint64_t pOffset, uint64_t& pFragOffset)
+{
+  if (empty())
+    return NULL;
+
+  if (IndexStale == m_IndexState)
+    m_IndexState = buildIndex() ? IndexBuilt : IndexNone;
+
+  if (IndexBuilt == m_IndexState) {
+    std::vector<uint64_t>::const_iterator it =
+      std::lower_bound(m_IndexEnds.begin(), m_IndexEnds.end(), pOffset);
+    if (m_IndexEnds.end() == it)
+      return NULL;
+
+    Fragment* frag = m_IndexFrags[it - m_IndexEnds.begin()];
+    pFragOffset = pOffset - (*it - frag->size());
+    return frag;
+  }
+
+  // the fragments can not be indexed, walk through them
+  uint64_t start = 0;
+  iterator frag, fragEnd = end();
+  for (frag = begin(); frag != fragEnd; ++frag) {
+    uint64_t frag_end = start + frag->size();
+    if (frag_end >= pOffset) {
+      pFragOffset = pOffset - start;
+      return &*frag;
+    }
+    start = frag_end;
+  }
+  return NULL;
+}
+
+bool SectionData::buildIndex()
+{
+  m_IndexFrags.clear();
+  m_IndexEnds.clear();
+
+  uint64_t offset = 0;
+  iterator frag, fragEnd = end();
+  for (frag = begin(); frag != fragEnd; ++frag) {
+    if (Fragment::Alignment == frag->getKind()) {
+      m_IndexFrags.clear();
+      m_IndexEnds.clear();
+      return false;
+    }
+    offset += frag->size();
+    m_IndexFrags.push_back(&*frag);
+    m_IndexEnds.push_back(offset);
+  }
+  return true;
+}
+
+//===----------------------------------------------------------------------===//
+// SectionData::FragmentListTraits
+//===----------------------------------------------------------------------===//
+void SectionData::FragmentListTraits::addNodeToList(Fragment* pFrag)
+{
+  if (NULL != m_pOwner)
+    m_pOwner->invalidateIndex();
+}
+
+void SectionData::FragmentListTraits::removeNodeFromList(Fragment* pFrag)
+{
+  if (NULL != m_pOwner)
+    m_pOwner->invalidateIndex();
+}
+
+void SectionData::FragmentListTraits::transferNodesFromList(
+                                        FragmentListTraits& pFrom,
+                                        llvm::ilist_iterator<Fragment> pFirst,
+                                        llvm::ilist_iterator<Fragment> pLast)
+{
+  if (NULL != m_pOwner)
+    m_pOwner->invalidateIndex();
+  if (NULL != pFrom.m_pOwner)
+    pFrom.m_pOwner->invalidateIndex();
+}
@@ -0,0 +1,615 @@
+//===- SectionMerger.cpp --------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/ADT/StringHash.h>
+#include <mcld/Fragment/FragmentRef.h>
+#include <mcld/Fragment/MergedFragment.h>
+#include <mcld/Fragment/RegionFragment.h>
+#include <mcld/Fragment/Relocation.h>
+#include <mcld/LD/LDContext.h>
+#include <mcld/LD/LDFileFormat.h>
+#include <mcld/LD/LDSection.h>
+#include <mcld/LD/LDSymbol.h>
+#include <mcld/LD/RelocData.h>
+#include <mcld/LD/SectionData.h>
+#include <mcld/LD/SectionMerger.h>
+#include <mcld/LinkerConfig.h>
+#include <mcld/LinkerScript.h>
+#include <mcld/MC/Input.h>
+#include <mcld/Module.h>
+#include <mcld/Object/ObjectBuilder.h>
+#include <mcld/Object/SectionMap.h>
+#include <mcld/Support/ThreadPool.h>
+
+#include <llvm/Support/Casting.h>
+#include <llvm/Support/ELF.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace mcld;
+
+//===----------------------------------------------------------------------===//
+// Non-member functions
+//===----------------------------------------------------------------------===//
+namespace {
+
+/// SuffixCompare - order the pieces by their reversed characters, from the
+/// greatest to the least. The strings which end with a string S are then
+/// right before S. See StringTableBuilder.
+struct SuffixCompare
+{
+  bool operator()(const SectionMerger::Piece* pX,
+                  const SectionMerger::Piece* pY) const
+  {
+    size_t x = pX->data.size();
+    size_t y = pY->data.size();
+    while (0 != x && 0 != y) {
+      --x;
+      --y;
+      if (pX->data[x] != pY->data[y])
+        return (unsigned char)pX->data[x] > (unsigned char)pY->data[y];
+    }
+    // one is the suffix of the other, put the longer one first
+    return x > y;
+  }
+};
+
+/// isZero - check if the pSize bytes at pData are all zero
+bool isZero(const char* pData, uint64_t pSize)
+{
+  for (uint64_t i = 0; i < pSize; ++i) {
+    if (0x0 != pData[i])
+      return false;
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// SectionMerger::ScanJob
+//===----------------------------------------------------------------------===//
+/// ScanJob - check the relocations of an input
+class SectionMerger::ScanJob : public ThreadPool::Job
+{
+public:
+  ScanJob(const SectionMerger& pMerger, const Input& pInput)
+    : m_Merger(pMerger), m_Input(pInput) {
+  }
+
+  void run()
+  { m_Merger.scanRelocations(m_Input); }
+
+private:
+  const SectionMerger& m_Merger;
+  const Input& m_Input;
+};
+
+//===----------------------------------------------------------------------===//
+// SectionMerger::SplitJob
+//===----------------------------------------------------------------------===//
+/// SplitJob - split a range of candidates into pieces
+class SectionMerger::SplitJob : public ThreadPool::Job
+{
+public:
+  SplitJob(std::vector<Candidate*>& pCandidates, size_t pBegin, size_t pEnd)
+    : m_Candidates(pCandidates), m_Begin(pBegin), m_End(pEnd) {
+  }
+
+  void run() {
+    static const hash::StringHash<hash::DJB> hash_func =
+                                                  hash::StringHash<hash::DJB>();
+    for (size_t idx = m_Begin; idx < m_End; ++idx) {
+      Candidate& cand = *m_Candidates[idx];
+      if (!cand.valid)
+        continue;
+
+      const LDSection& sect = *cand.section;
+      const RegionFragment& region =
+                     llvm::cast<RegionFragment>(sect.getSectionData()->front());
+      if (!splitPieces(region.getRegion(),
+                       sect.entSize(),
+                       (0x0 != (sect.flag() & llvm::ELF::SHF_STRINGS)),
+                       cand.pieces)) {
+        cand.valid = false;
+        cand.pieces.clear();
+        continue;
+      }
+
+      PieceList::iterator piece, pEnd = cand.pieces.end();
+      for (piece = cand.pieces.begin(); piece != pEnd; ++piece)
+        piece->hash = hash_func(piece->data);
+    }
+  }
+
+private:
+  std::vector<Candidate*>& m_Candidates;
+  size_t m_Begin;
+  size_t m_End;
+};
+
+//===----------------------------------------------------------------------===//
+// SectionMerger::ShardJob
+//===----------------------------------------------------------------------===//
+/// ShardJob - find the leaders of the pieces of a shard of a group
+class SectionMerger::ShardJob : public ThreadPool::Job
+{
+public:
+  std::vector<Piece*>& members() { return m_Members; }
+
+  void run()
+  { findLeaders(m_Members); }
+
+private:
+  /// the pieces of this shard, in the input order
+  std::vector<Piece*> m_Members;
+};
+
+//===----------------------------------------------------------------------===//
+// SectionMerger::RewriteJob
+//===----------------------------------------------------------------------===//
+/// RewriteJob - move the relocations and the symbols of an input
+class SectionMerger::RewriteJob : public ThreadPool::Job
+{
+public:
+  RewriteJob(const SectionMerger& pMerger, Input& pInput)
+    : m_Merger(pMerger), m_Input(pInput) {
+  }
+
+  void run()
+  { m_Merger.rewriteInput(m_Input); }
+
+private:
+  const SectionMerger& m_Merger;
+  Input& m_Input;
+};
+
+//===----------------------------------------------------------------------===//
+// SectionMerger
+//===----------------------------------------------------------------------===//
+SectionMerger::SectionMerger(const LinkerConfig& pConfig,
+                             Module& pModule,
+                             ThreadPool& pThreadPool)
+  : m_CandidateIds(1024),
+    m_Config(pConfig),
+    m_Module(pModule),
+    m_ThreadPool(pThreadPool)
+{
+}
+
+SectionMerger::~SectionMerger()
+{
+  std::vector<Candidate*>::iterator cand, cEnd = m_Candidates.end();
+  for (cand = m_Candidates.begin(); cand != cEnd; ++cand)
+    delete *cand;
+}
+
+bool SectionMerger::run()
+{
+  // the merged sections are kept as they are in partial linking
+  if (LinkerConfig::Object == m_Config.codeGenType())
+    return true;
+
+  // 1. collect the mergeable sections
+  findCandidates();
+  if (m_Candidates.empty())
+    return true;
+
+  // 2. drop the sections which can not be moved because of the relocations
+  ThreadPool::JobList job_list;
+  std::vector<ScanJob*> scan_jobs;
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    scan_jobs.push_back(new ScanJob(*this, **obj));
+    job_list.push_back(scan_jobs.back());
+  }
+  m_ThreadPool.run(job_list);
+  for (size_t i = 0; i < scan_jobs.size(); ++i)
+    delete scan_jobs[i];
+
+  // 3. split the sections into pieces, one range per thread
+  job_list.clear();
+  std::vector<SplitJob*> split_jobs;
+  size_t num = m_Candidates.size();
+  size_t chunk = (num + m_ThreadPool.size() - 1) / m_ThreadPool.size();
+  for (size_t begin = 0; begin < num; begin += chunk) {
+    size_t end = (begin + chunk < num) ? (begin + chunk) : num;
+    split_jobs.push_back(new SplitJob(m_Candidates, begin, end));
+    job_list.push_back(split_jobs.back());
+  }
+  m_ThreadPool.run(job_list);
+  for (size_t i = 0; i < split_jobs.size(); ++i)
+    delete split_jobs[i];
+
+  groupCandidates();
+  if (m_Groups.empty())
+    return true;
+
+  // 4. distribute the pieces to the shards of their groups in the input
+  // order, and find the leaders in each shard
+  std::vector<ShardJob> shard_jobs(m_Groups.size() * NumOfShards);
+  for (size_t g = 0; g < m_Groups.size(); ++g) {
+    ShardJob* shards = &shard_jobs[g * NumOfShards];
+    std::vector<size_t>::iterator mem, memEnd = m_Groups[g].members.end();
+    for (mem = m_Groups[g].members.begin(); mem != memEnd; ++mem) {
+      PieceList& pieces = m_Candidates[*mem]->pieces;
+      PieceList::iterator piece, pEnd = pieces.end();
+      for (piece = pieces.begin(); piece != pEnd; ++piece)
+        shards[getShardOf(piece->hash)].members().push_back(&*piece);
+    }
+  }
+  job_list.clear();
+  std::vector<ShardJob>::iterator shard, sEnd = shard_jobs.end();
+  for (shard = shard_jobs.begin(); shard != sEnd; ++shard) {
+    if (!shard->members().empty())
+      job_list.push_back(&*shard);
+  }
+  m_ThreadPool.run(job_list);
+
+  // 5. place the leaders in the merged fragments
+  std::vector<Group>::iterator group, gEnd = m_Groups.end();
+  for (group = m_Groups.begin(); group != gEnd; ++group)
+    layoutGroup(*group);
+
+  // 6. move the relocations and the symbols to the merged layout
+  job_list.clear();
+  std::vector<RewriteJob*> rewrite_jobs;
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    rewrite_jobs.push_back(new RewriteJob(*this, **obj));
+    job_list.push_back(rewrite_jobs.back());
+  }
+  m_ThreadPool.run(job_list);
+  for (size_t i = 0; i < rewrite_jobs.size(); ++i)
+    delete rewrite_jobs[i];
+
+  // 7. replace the input sections by the merged fragments
+  replaceSections();
+  return true;
+}
+
+bool SectionMerger::splitPieces(llvm::StringRef pContent,
+                                uint64_t pEntSize,
+                                bool pIsString,
+                                PieceList& pPieces)
+{
+  if (0x0 == pEntSize || 0x0 != (pContent.size() % pEntSize))
+    return false;
+
+  Piece piece;
+  piece.outOffset = 0;
+  piece.hash = 0;
+  piece.leader = NULL;
+
+  uint64_t size = pContent.size();
+  uint64_t offset = 0;
+  while (offset < size) {
+    uint64_t end = offset;
+    if (pIsString) {
+      // find the null terminator, which is an entry of zeros
+      if (1 == pEntSize) {
+        const void* nul = std::memchr(pContent.data() + offset, 0x0,
+                                      size - offset);
+        if (NULL == nul)
+          return false;
+        end = (const char*)nul - pContent.data() + 1;
+      }
+      else {
+        while (end < size && !isZero(pContent.data() + end, pEntSize))
+          end += pEntSize;
+        if (end == size)
+          return false;
+        end += pEntSize;
+      }
+    }
+    else {
+      end = offset + pEntSize;
+    }
+
+    piece.data = pContent.slice(offset, end);
+    piece.inOffset = offset;
+    pPieces.push_back(piece);
+    offset = end;
+  }
+  return true;
+}
+
+uint64_t SectionMerger::getOutputOffset(const PieceList& pPieces,
+                                        uint64_t pOffset)
+{
+  assert(!pPieces.empty());
+  // find the last piece which starts at or before pOffset
+  size_t low = 0, high = pPieces.size();
+  while (high - low > 1) {
+    size_t mid = low + (high - low) / 2;
+    if (pPieces[mid].inOffset <= pOffset)
+      low = mid;
+    else
+      high = mid;
+  }
+  const Piece& piece = pPieces[low];
+  return piece.outOffset + (pOffset - piece.inOffset);
+}
+
+void SectionMerger::findCandidates()
+{
+  SectionMap& section_map = m_Module.getScript().sectionMap();
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sect_iterator sect, sectEnd = (*obj)->context()->sectEnd();
+    for (sect = (*obj)->context()->sectBegin(); sect != sectEnd; ++sect) {
+      LDSection* section = *sect;
+      if (LDFileFormat::Regular != section->kind() &&
+          LDFileFormat::Debug != section->kind())
+        continue;
+      if (llvm::ELF::SHT_PROGBITS != section->type() ||
+          0x0 == (section->flag() & llvm::ELF::SHF_MERGE) ||
+          0x0 == section->entSize() ||
+          0x0 == section->size())
+        continue;
+
+      // only the sections read as a whole region
+      if (!section->hasSectionData() ||
+          1 != section->getSectionData()->size() ||
+          !llvm::isa<RegionFragment>(section->getSectionData()->front()) ||
+          section->getSectionData()->front().size() != section->size())
+        continue;
+
+      // the discarded sections are ignored by ObjectBuilder::MergeSection
+      SectionMap::mapping pair =
+        section_map.find((*obj)->path().native(), section->name());
+      if (NULL != pair.first && pair.first->isDiscard())
+        continue;
+
+      Candidate* cand = new Candidate();
+      cand->input = *obj;
+      cand->section = section;
+      cand->group = 0;
+      cand->valid = true;
+
+      bool exist = false;
+      SectIdEntryType* entry = m_CandidateIds.insert(section, exist);
+      entry->setValue(m_Candidates.size());
+      m_Candidates.push_back(cand);
+    }
+  }
+}
+
+SectionMerger::Candidate*
+SectionMerger::findCandidate(const LDSection& pSection) const
+{
+  SectIdTableType::const_iterator entry = m_CandidateIds.find(&pSection);
+  if (NULL == entry.getEntry())
+    return NULL;
+  return m_Candidates[entry.getEntry()->value()];
+}
+
+void SectionMerger::scanRelocations(const Input& pInput) const
+{
+  LDContext::const_sect_iterator rs, rsEnd = pInput.context()->relocSectEnd();
+  for (rs = pInput.context()->relocSectBegin(); rs != rsEnd; ++rs) {
+    LDSection* reloc_sect = *rs;
+    if ((LDFileFormat::Ignore == reloc_sect->kind()) ||
+        (!reloc_sect->hasRelocData()))
+      continue;
+
+    // the relocated contents can not be moved
+    Candidate* apply = findCandidate(*reloc_sect->getLink());
+    if (NULL != apply)
+      apply->valid = false;
+
+    // the addends of REL relocations are kept in the relocated contents
+    if (llvm::ELF::SHT_REL != reloc_sect->type())
+      continue;
+
+    RelocData::iterator reloc_it, rEnd = reloc_sect->getRelocData()->end();
+    for (reloc_it = reloc_sect->getRelocData()->begin(); reloc_it != rEnd;
+                                                                 ++reloc_it) {
+      Relocation* reloc = llvm::cast<Relocation>(reloc_it);
+      ResolveInfo* sym = reloc->symInfo();
+      if (NULL == sym || ResolveInfo::Section != sym->type() ||
+          !sym->outSymbol()->hasFragRef())
+        continue;
+      const LDSection& target =
+                sym->outSymbol()->fragRef()->frag()->getParent()->getSection();
+      Candidate* cand = findCandidate(target);
+      if (NULL != cand)
+        cand->valid = false;
+    }
+  }
+}
+
+void SectionMerger::groupCandidates()
+{
+  SectionMap& section_map = m_Module.getScript().sectionMap();
+  for (size_t idx = 0; idx < m_Candidates.size(); ++idx) {
+    Candidate& cand = *m_Candidates[idx];
+    if (!cand.valid)
+      continue;
+
+    const LDSection& sect = *cand.section;
+    SectionMap::mapping pair =
+      section_map.find(cand.input->path().native(), sect.name());
+    std::string output = (NULL == pair.first) ? sect.name() :
+                                                pair.first->name();
+    uint32_t flag = sect.flag() & ~llvm::ELF::SHF_GROUP;
+
+    // the number of groups is small
+    size_t g = 0;
+    for (; g < m_Groups.size(); ++g) {
+      const Group& group = m_Groups[g];
+      if (group.output == output && group.flag == flag &&
+          group.entSize == sect.entSize() && group.align == sect.align())
+        break;
+    }
+    if (g == m_Groups.size()) {
+      Group group;
+      group.output = output;
+      group.flag = flag;
+      group.entSize = sect.entSize();
+      group.align = sect.align();
+      group.frag = NULL;
+      m_Groups.push_back(group);
+    }
+    m_Groups[g].members.push_back(idx);
+    cand.group = g;
+  }
+}
+
+void SectionMerger::findLeaders(std::vector<Piece*>& pMembers)
+{
+  // open addressing, at most half full
+  size_t num_buckets = 16;
+  while (num_buckets < 2 * pMembers.size())
+    num_buckets <<= 1;
+  std::vector<Piece*> buckets(num_buckets, NULL);
+  size_t mask = num_buckets - 1;
+
+  std::vector<Piece*>::iterator mem, memEnd = pMembers.end();
+  for (mem = pMembers.begin(); mem != memEnd; ++mem) {
+    Piece* piece = *mem;
+    size_t idx = piece->hash & mask;
+    while (NULL != buckets[idx]) {
+      Piece* leader = buckets[idx];
+      if (leader->hash == piece->hash && leader->data == piece->data)
+        break;
+      idx = (idx + 1) & mask;
+    }
+    if (NULL == buckets[idx])
+      buckets[idx] = piece;
+    piece->leader = buckets[idx];
+  }
+}
+
+void SectionMerger::layoutGroup(Group& pGroup)
+{
+  pGroup.frag = new MergedFragment();
+
+  std::vector<Piece*> leaders;
+  std::vector<size_t>::iterator mem, memEnd = pGroup.members.end();
+  for (mem = pGroup.members.begin(); mem != memEnd; ++mem) {
+    PieceList& pieces = m_Candidates[*mem]->pieces;
+    PieceList::iterator piece, pEnd = pieces.end();
+    for (piece = pieces.begin(); piece != pEnd; ++piece) {
+      if (piece->leader == &*piece)
+        leaders.push_back(&*piece);
+    }
+  }
+
+  uint64_t align = (0x0 == pGroup.align) ? 1 : pGroup.align;
+  bool tail_merge = m_Config.options().tailMergeStrings() &&
+                    0x0 != (pGroup.flag & llvm::ELF::SHF_STRINGS) &&
+                    1 == pGroup.entSize &&
+                    1 == align;
+  if (tail_merge) {
+    // a string which is the tail of the previous one shares its bytes
+    std::sort(leaders.begin(), leaders.end(), SuffixCompare());
+    const Piece* previous = NULL;
+    std::vector<Piece*>::iterator leader, lEnd = leaders.end();
+    for (leader = leaders.begin(); leader != lEnd; ++leader) {
+      Piece* piece = *leader;
+      if (NULL != previous && previous->data.endswith(piece->data)) {
+        piece->outOffset = previous->outOffset + previous->data.size() -
+                           piece->data.size();
+        continue;
+      }
+      piece->outOffset = pGroup.frag->size();
+      pGroup.frag->append(piece->data, piece->outOffset);
+      previous = piece;
+    }
+  }
+  else {
+    // the leaders in the input order
+    std::vector<Piece*>::iterator leader, lEnd = leaders.end();
+    for (leader = leaders.begin(); leader != lEnd; ++leader) {
+      uint64_t offset = (pGroup.frag->size() + align - 1) & ~(align - 1);
+      (*leader)->outOffset = offset;
+      pGroup.frag->append((*leader)->data, offset);
+    }
+  }
+
+  // the other pieces go to their leaders
+  for (mem = pGroup.members.begin(); mem != memEnd; ++mem) {
+    PieceList& pieces = m_Candidates[*mem]->pieces;
+    PieceList::iterator piece, pEnd = pieces.end();
+    for (piece = pieces.begin(); piece != pEnd; ++piece)
+      piece->outOffset = piece->leader->outOffset;
+  }
+}
+
+void SectionMerger::rewriteInput(Input& pInput) const
+{
+  // 1. the addends of the relocations against the section symbols, which are
+  // the offsets in the merged sections
+  LDContext::sect_iterator rs, rsEnd = pInput.context()->relocSectEnd();
+  for (rs = pInput.context()->relocSectBegin(); rs != rsEnd; ++rs) {
+    LDSection* reloc_sect = *rs;
+    if ((LDFileFormat::Ignore == reloc_sect->kind()) ||
+        (!reloc_sect->hasRelocData()))
+      continue;
+
+    RelocData::iterator reloc_it, rEnd = reloc_sect->getRelocData()->end();
+    for (reloc_it = reloc_sect->getRelocData()->begin(); reloc_it != rEnd;
+                                                                 ++reloc_it) {
+      Relocation* reloc = llvm::cast<Relocation>(reloc_it);
+      ResolveInfo* sym = reloc->symInfo();
+      if (NULL == sym || ResolveInfo::Section != sym->type() ||
+          !sym->outSymbol()->hasFragRef())
+        continue;
+      const Fragment* frag = sym->outSymbol()->fragRef()->frag();
+      if (!llvm::isa<RegionFragment>(frag))
+        continue;
+      const Candidate* cand = findCandidate(frag->getParent()->getSection());
+      if (NULL == cand || !cand->valid)
+        continue;
+      reloc->setAddend(getOutputOffset(cand->pieces, reloc->addend()));
+    }
+  }
+
+  // 2. the symbols defined in the merged sections. The output symbols of the
+  // global symbols share the fragment references of their input symbols.
+  LDContext::sym_iterator sym, symEnd = pInput.context()->symTabEnd();
+  for (sym = pInput.context()->symTabBegin(); sym != symEnd; ++sym) {
+    if (NULL == *sym || !(*sym)->hasFragRef())
+      continue;
+    FragmentRef* frag_ref = (*sym)->fragRef();
+    if (!llvm::isa<RegionFragment>(frag_ref->frag()))
+      continue;
+    const Candidate* cand =
+                    findCandidate(frag_ref->frag()->getParent()->getSection());
+    if (NULL == cand || !cand->valid)
+      continue;
+
+    MergedFragment& merged = *m_Groups[cand->group].frag;
+    if (ResolveInfo::Section == (*sym)->type())
+      frag_ref->assign(merged, 0);
+    else
+      frag_ref->assign(merged,
+                       getOutputOffset(cand->pieces, frag_ref->offset()));
+  }
+}
+
+void SectionMerger::replaceSections()
+{
+  std::vector<Group>::iterator group, gEnd = m_Groups.end();
+  for (group = m_Groups.begin(); group != gEnd; ++group) {
+    std::vector<size_t>::iterator mem, memEnd = group->members.end();
+    for (mem = group->members.begin(); mem != memEnd; ++mem) {
+      LDSection& sect = *m_Candidates[*mem]->section;
+      if (mem != group->members.begin()) {
+        sect.setKind(LDFileFormat::Ignore);
+        continue;
+      }
+      SectionData& data = *sect.getSectionData();
+      data.getFragmentList().clear();
+      ObjectBuilder::AppendFragment(*group->frag, data);
+      sect.setSize(group->frag->size());
+    }
+  }
+}
+
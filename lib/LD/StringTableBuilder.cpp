@@ -0,0 +1,139 @@
+//===- StringTableBuilder.cpp ---------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/LD/StringTableBuilder.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+using namespace mcld;
+
+namespace {
+
+/// SuffixCompare - order the strings by their reversed characters, from the
+/// greatest to the least. The strings which end with a string S are then
+/// right before S, and the last of them has the shortest tail containing S.
+struct SuffixCompare
+{
+  bool operator()(const llvm::StringRef& pX, const llvm::StringRef& pY) const
+  {
+    size_t x = pX.size();
+    size_t y = pY.size();
+    while (0 != x && 0 != y) {
+      --x;
+      --y;
+      if (pX[x] != pY[y])
+        return (unsigned char)pX[x] > (unsigned char)pY[y];
+    }
+    // one is the suffix of the other, put the longer one first
+    return x > y;
+  }
+};
+
+} // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// StringTableBuilder
+//===----------------------------------------------------------------------===//
+const size_t StringTableBuilder::NotFound = ~size_t(0);
+
+StringTableBuilder::StringTableBuilder()
+  : m_Size(0), m_bFinalized(false) {
+}
+
+StringTableBuilder::~StringTableBuilder()
+{
+}
+
+void StringTableBuilder::add(const llvm::StringRef& pStr)
+{
+  assert(!m_bFinalized && "add a string to a finalized string table");
+  bool exist = false;
+  EntryType* entry = m_StringMap.insert(pStr, exist);
+  if (!exist) {
+    entry->setValue(NotFound);
+    m_Strings.push_back(pStr);
+  }
+}
+
+void StringTableBuilder::addCopy(const llvm::StringRef& pStr)
+{
+  if (m_StringMap.find(pStr) != m_StringMap.end())
+    return;
+  m_Copies.push_back(pStr.str());
+  add(m_Copies.back());
+}
+
+void StringTableBuilder::finalize()
+{
+  assert(!m_bFinalized && "finalize a string table twice");
+
+  std::sort(m_Strings.begin(), m_Strings.end(), SuffixCompare());
+
+  // the leading null byte is the empty string
+  m_Size = 1;
+  llvm::StringRef previous;
+  size_t prev_offset = 0;
+  std::vector<llvm::StringRef>::iterator str, strEnd = m_Strings.end();
+  for (str = m_Strings.begin(); str != strEnd; ++str) {
+    size_t offset = 0;
+    if (str->empty()) {
+      offset = 0;
+    }
+    else if (previous.endswith(*str)) {
+      // share the tail of the previous string
+      offset = prev_offset + previous.size() - str->size();
+    }
+    else {
+      offset = m_Size;
+      m_Size += str->size() + 1;
+      m_Layout.push_back(*str);
+      previous = *str;
+      prev_offset = offset;
+    }
+    m_StringMap.find(*str).getEntry()->setValue(offset);
+  }
+  m_bFinalized = true;
+}
+
+size_t StringTableBuilder::getOffset(const llvm::StringRef& pStr) const
+{
+  assert(m_bFinalized && "get an offset before the string table is finalized");
+  StringMapType::const_iterator it = m_StringMap.find(pStr);
+  if (it == m_StringMap.end())
+    return NotFound;
+  return it.getEntry()->value();
+}
+
+void StringTableBuilder::emit(char* pBuffer) const
+{
+  assert(m_bFinalized && "emit a string table before it is finalized");
+  if (0 == m_Size)
+    return;
+
+  char* data = pBuffer;
+  *data++ = '\0';
+  std::vector<llvm::StringRef>::const_iterator str, strEnd = m_Layout.end();
+  for (str = m_Layout.begin(); str != strEnd; ++str) {
+    std::memcpy(data, str->data(), str->size());
+    data += str->size();
+    *data++ = '\0';
+  }
+}
+
+void StringTableBuilder::clear()
+{
+  m_StringMap.clear();
+  m_Strings.clear();
+  m_Layout.clear();
+  m_Copies.clear();
+  m_Size = 0;
+  m_bFinalized = false;
+}
+
@@ -21,6 +21,61 @@ static inline void SpecToFilename(const std::string& pSpec, std::string& pFile)
   pFile += pSpec;
 }
 
+/// FindInDirs - find the file of a namespec in the directories in order.
+/// Each MCLDDirectory reads its entries only once, so a lookup is a probe of
+/// its cache in every directory.
+static mcld::sys::fs::Path* FindInDirs(const SearchDirs::DirList& pDirList,
+                                       const std::string& pNamespec,
+                                       mcld::Input::Type pType)
+{
+  assert(Input::DynObj  == pType ||
+         Input::Archive == pType ||
+         Input::Script  == pType);
+
+  std::string file, shared_file, static_file;
+  switch(pType) {
+  case Input::Script:
+    file.assign(pNamespec);
+    break;
+  case Input::DynObj:
+  case Input::Archive :
+    SpecToFilename(pNamespec, file);
+    shared_file = file + mcld::sys::fs::detail::shared_library_extension;
+    static_file = file + mcld::sys::fs::detail::static_library_extension;
+    break;
+  default:
+    break;
+  } // end of switch
+
+  // for all MCLDDirectorys
+  mcld::sys::fs::Path* result = NULL;
+  SearchDirs::DirList::const_iterator mcld_dir, mcld_dir_end = pDirList.end();
+  for (mcld_dir = pDirList.begin(); mcld_dir != mcld_dir_end; ++mcld_dir) {
+    switch(pType) {
+    case Input::Script: {
+      result = (*mcld_dir)->find(file);
+      if (NULL != result)
+        return result;
+      break;
+    }
+    case Input::DynObj: {
+      result = (*mcld_dir)->find(shared_file);
+      if (NULL != result)
+        return result;
+    }
+    /** Fall through **/
+    case Input::Archive : {
+      result = (*mcld_dir)->find(static_file);
+      if (NULL != result)
+        return result;
+    }
+    default:
+      break;
+    } // end of switch
+  } // end of for
+  return NULL;
+}
+
 //===----------------------------------------------------------------------===//
 // SearchDirs
 //===----------------------------------------------------------------------===//
@@ -76,133 +131,11 @@ bool SearchDirs::insert(const sys::fs::Path& pPath)
 mcld::sys::fs::Path*
 SearchDirs::find(const std::string& pNamespec, mcld::Input::Type pType)
 {
-  assert(Input::DynObj  == pType ||
-         Input::Archive == pType ||
-         Input::Script  == pType);
-
-  std::string file;
-  switch(pType) {
-  case Input::Script:
-    file.assign(pNamespec);
-    break;
-  case Input::DynObj:
-  case Input::Archive :
-    SpecToFilename(pNamespec, file);
-    break;
-  default:
-    break;
-  } // end of switch
-
-  // for all MCLDDirectorys
-  DirList::iterator mcld_dir, mcld_dir_end = m_DirList.end();
-  for (mcld_dir = m_DirList.begin(); mcld_dir != mcld_dir_end; ++mcld_dir) {
-    // for all entries in MCLDDirectory
-    MCLDDirectory::iterator entry = (*mcld_dir)->begin();
-    MCLDDirectory::iterator enEnd = (*mcld_dir)->end();
-
-    switch(pType) {
-    case Input::Script: {
-      while (entry != enEnd) {
-        if (file == entry.path()->filename())
-          return entry.path();
-        ++entry;
-      }
-      break;
-    }
-    case Input::DynObj: {
-      while (entry != enEnd) {
-        if (file == entry.path()->stem().native() ) {
-          if (mcld::sys::fs::detail::shared_library_extension ==
-                entry.path()->extension().native()) {
-            return entry.path();
-          }
-        }
-        ++entry;
-      }
-    }
-    /** Fall through **/
-    case Input::Archive : {
-      entry = (*mcld_dir)->begin();
-      enEnd = (*mcld_dir)->end();
-      while (entry != enEnd) {
-        if (file == entry.path()->stem().native() &&
-            mcld::sys::fs::detail::static_library_extension ==
-              entry.path()->extension().native()) {
-          return entry.path();
-        }
-        ++entry;
-      }
-    }
-    default:
-      break;
-    } // end of switch
-  } // end of for
-  return NULL;
+  return FindInDirs(m_DirList, pNamespec, pType);
 }
 
 const mcld::sys::fs::Path*
 SearchDirs::find(const std::string& pNamespec, mcld::Input::Type pType) const
 {
-  assert(Input::DynObj  == pType ||
-         Input::Archive == pType ||
-         Input::Script  == pType);
-
-  std::string file;
-  switch(pType) {
-  case Input::Script:
-    file.assign(pNamespec);
-    break;
-  case Input::DynObj:
-  case Input::Archive :
-    SpecToFilename(pNamespec, file);
-    break;
-  default:
-    break;
-  } // end of switch
-
-  // for all MCLDDirectorys
-  DirList::const_iterator mcld_dir, mcld_dir_end = m_DirList.end();
-  for (mcld_dir = m_DirList.begin(); mcld_dir != mcld_dir_end; ++mcld_dir) {
-    // for all entries in MCLDDirectory
-    MCLDDirectory::iterator entry = (*mcld_dir)->begin();
-    MCLDDirectory::iterator enEnd = (*mcld_dir)->end();
-
-    switch(pType) {
-    case Input::Script: {
-      while (entry != enEnd) {
-        if (file == entry.path()->filename())
-          return entry.path();
-        ++entry;
-      }
-      break;
-    }
-    case Input::DynObj: {
-      while (entry != enEnd) {
-        if (file == entry.path()->stem().native() ) {
-          if (mcld::sys::fs::detail::shared_library_extension ==
-                entry.path()->extension().native()) {
-            return entry.path();
-          }
-        }
-        ++entry;
-      }
-    }
-    /** Fall through **/
-    case Input::Archive : {
-      entry = (*mcld_dir)->begin();
-      enEnd = (*mcld_dir)->end();
-      while ( entry!=enEnd ) {
-        if (file == entry.path()->stem().native() &&
-            mcld::sys::fs::detail::static_library_extension ==
-              entry.path()->extension().native()) {
-          return entry.path();
-        }
-        ++entry;
-      }
-    }
-    default:
-      break;
-    } // end of switch
-  } // end of for
-  return NULL;
+  return FindInDirs(m_DirList, pNamespec, pType);
 }
@@ -69,6 +69,7 @@ SymbolCategory& SymbolCategory::add(LDSymbol& pSymbol, Category::Type pTarget)
 {
   Category* current = m_pRegular;
   m_OutputSymbols.push_back(&pSymbol);
+  m_Positions[&pSymbol] = m_OutputSymbols.size() - 1;
 
   // use non-stable bubble sort to arrange the order of symbols.
   while (NULL != current) {
@@ -77,10 +78,8 @@ SymbolCategory& SymbolCategory::add(LDSymbol& pSymbol, Category::Type pTarget)
       break;
     }
     else {
-      if (!current->empty()) {
-        std::swap(m_OutputSymbols[current->begin],
-                  m_OutputSymbols[current->end]);
-      }
+      if (!current->empty())
+        swap(current->begin, current->end);
       current->end++;
       current->begin++;
       current = current->prev;
@@ -120,32 +119,18 @@ SymbolCategory& SymbolCategory::arrange(LDSymbol& pSymbol,
   }
 
   assert(NULL != current);
-  size_t pos = 0;
-  if (!current->empty()) {
-    // find the position of source
-    pos = current->begin;
-    while (pos != current->end) {
-      if (m_OutputSymbols[pos] == &pSymbol)
-        break;
-      ++pos;
-    }
-  }
+  size_t pos = find(pSymbol, *current);
   // FIXME: Try to search the symbol explicitly, if symbol is not in the given
   // source category. Or we need to add some logics like shouldForceLocal() in
   // SymbolCategory::Category::categorize().
   if (current->end == pos || current->empty()) {
     current = m_pFile;
     do {
-      pos = current->begin;
-      while (pos != current->end) {
-        if (m_OutputSymbols[pos] == &pSymbol) {
-          distance = pTarget - current->type;
-          break;
-        }
-        ++pos;
-      }
-      if (pos != current->end)
+      pos = find(pSymbol, *current);
+      if (pos != current->end) {
+        distance = pTarget - current->type;
         break;
+      }
       current = current->next;
     } while (current != NULL);
     assert(current != NULL);
@@ -162,7 +147,7 @@ SymbolCategory& SymbolCategory::arrange(LDSymbol& pSymbol,
       else {
         assert(!current->isLast() && "target category is wrong.");
         rear = current->end - 1;
-        std::swap(m_OutputSymbols[pos], m_OutputSymbols[rear]);
+        swap(pos, rear);
         pos = rear;
         current->next->begin--;
         current->end--;
@@ -183,7 +168,7 @@ SymbolCategory& SymbolCategory::arrange(LDSymbol& pSymbol,
       }
       else {
         assert(!current->isFirst() && "target category is wrong.");
-        std::swap(m_OutputSymbols[current->begin], m_OutputSymbols[pos]);
+        swap(current->begin, pos);
         pos = current->begin;
         current->begin++;
         current->prev->end++;
@@ -196,6 +181,37 @@ SymbolCategory& SymbolCategory::arrange(LDSymbol& pSymbol,
   return *this;
 }
 
+void SymbolCategory::swap(size_t pPos1, size_t pPos2)
+{
+  std::swap(m_OutputSymbols[pPos1], m_OutputSymbols[pPos2]);
+  m_Positions[m_OutputSymbols[pPos1]] = pPos1;
+  m_Positions[m_OutputSymbols[pPos2]] = pPos2;
+}
+
+size_t SymbolCategory::find(const LDSymbol& pSymbol,
+                            const Category& pCategory) const
+{
+  // use the recorded position if the symbol is still there
+  PositionMap::const_iterator entry = m_Positions.find(&pSymbol);
+  if (m_Positions.end() != entry) {
+    size_t pos = entry->second;
+    if (pos >= pCategory.begin && pos < pCategory.end &&
+        m_OutputSymbols[pos] == &pSymbol)
+      return pos;
+    if (pos < m_OutputSymbols.size() && m_OutputSymbols[pos] == &pSymbol)
+      return pCategory.end;
+  }
+
+  // the symbols are reordered from outside, search for it
+  size_t pos = pCategory.begin;
+  while (pos != pCategory.end) {
+    if (m_OutputSymbols[pos] == &pSymbol)
+      break;
+    ++pos;
+  }
+  return pos;
+}
+
 SymbolCategory& SymbolCategory::arrange(LDSymbol& pSymbol,
                                         const ResolveInfo& pSourceInfo)
 {
@@ -216,7 +232,7 @@ SymbolCategory& SymbolCategory::changeCommonsToGlobal()
       m_pDynamic->begin--;
       break;
     case Category::Regular:
-      std::swap(m_OutputSymbols[pos], m_OutputSymbols[m_pDynamic->end - 1]);
+      swap(pos, m_pDynamic->end - 1);
       m_pCommon->end--;
       m_pDynamic->begin--;
       m_pDynamic->end--;
@@ -78,6 +78,7 @@ LDSection* ObjectBuilder::MergeSection(const Input& pInputFile,
                                pInputSection.type(),
                                pInputSection.flag());
     target->setAlign(pInputSection.align());
+    target->setEntSize(pInputSection.entSize());
     m_Module.getSectionTable().push_back(target);
   }
 
@@ -22,6 +22,8 @@
 #include <mcld/LD/GroupReader.h>
 #include <mcld/LD/BinaryReader.h>
 #include <mcld/LD/GarbageCollection.h>
+#include <mcld/LD/IdenticalCodeFolding.h>
+#include <mcld/LD/SectionMerger.h>
 #include <mcld/LD/ObjectWriter.h>
 #include <mcld/LD/ResolveInfo.h>
 #include <mcld/LD/RelocData.h>
@@ -36,16 +38,106 @@
 #include <mcld/Support/RealPath.h>
 #include <mcld/Support/FileOutputBuffer.h>
 #include <mcld/Support/MsgHandling.h>
+#include <mcld/Support/ThreadPool.h>
 #include <mcld/Target/TargetLDBackend.h>
 #include <mcld/Fragment/Relocation.h>
 #include <mcld/Object/ObjectBuilder.h>
 
 #include <llvm/Support/Casting.h>
+#include <llvm/Support/ELF.h>
 #include <llvm/Support/Host.h>
 
 using namespace llvm;
 using namespace mcld;
 
+//===----------------------------------------------------------------------===//
+// Helper functions
+//===----------------------------------------------------------------------===//
+/// isApplicable - return false if pReloc is dropped with its discarded target
+static bool isApplicable(const Relocation& pReloc)
+{
+  // bypass the reloc if the symbol is in the discarded input section
+  const ResolveInfo* info = pReloc.symInfo();
+  return !(!info->outSymbol()->hasFragRef() &&
+           ResolveInfo::Section == info->type() &&
+           ResolveInfo::Undefined == info->desc());
+}
+
+/// applyRelocations - apply all relocations of pInput to their places in the
+/// output file
+static void applyRelocations(Relocator& pRelocator, Input& pInput)
+{
+  pRelocator.initializeApply(pInput);
+  LDContext::sect_iterator rs, rsEnd = pInput.context()->relocSectEnd();
+  for (rs = pInput.context()->relocSectBegin(); rs != rsEnd; ++rs) {
+    // bypass the reloc section if
+    // 1. its section kind is changed to Ignore. (The target section is a
+    // discarded group section.)
+    // 2. it has no reloc data. (All symbols in the input relocs are in the
+    // discarded group sections)
+    if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
+      continue;
+    RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
+    for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+      Relocation* relocation = llvm::cast<Relocation>(reloc);
+      if (isApplicable(*relocation))
+        relocation->apply(pRelocator);
+    } // for all relocations
+  } // for all relocation section
+  pRelocator.finalizeApply(pInput);
+}
+
+namespace {
+
+/** \class ApplyRelocJob
+ *  \brief ApplyRelocJob applies the relocations of an input.
+ *
+ *  Relocations of an input only write to the places in the sections of the
+ *  input, so inputs are independent of each other once layout is done.
+ */
+class ApplyRelocJob : public ThreadPool::Job
+{
+public:
+  ApplyRelocJob(Relocator& pRelocator, Input& pInput)
+    : m_Relocator(pRelocator), m_Input(pInput) {
+  }
+
+  void run()
+  { applyRelocations(m_Relocator, m_Input); }
+
+private:
+  Relocator& m_Relocator;
+  Input& m_Input;
+};
+
+/** \class ReadObjectJob
+ *  \brief ReadObjectJob reads the section headers, the independent section
+ *  contents and the raw symbol table of a relocatable object.
+ */
+class ReadObjectJob : public ThreadPool::Job
+{
+public:
+  ReadObjectJob(ObjectReader& pReader, Input& pInput)
+    : m_Reader(pReader), m_Input(pInput) {
+  }
+
+  void run()
+  {
+    bool doContinue = false;
+    if (!m_Reader.isMyFormat(m_Input, doContinue) ||
+        !m_Reader.readHeader(m_Input))
+      return;
+    m_Reader.readSectionData(m_Input);
+    m_Reader.readRawSymbols(m_Input);
+  }
+
+private:
+  ObjectReader& m_Reader;
+  Input& m_Input;
+};
+
+} // anonymous namespace
+
 //===----------------------------------------------------------------------===//
 // ObjectLinker
 //===----------------------------------------------------------------------===//
@@ -61,7 +153,8 @@ ObjectLinker::ObjectLinker(const LinkerConfig& pConfig,
     m_pGroupReader(NULL),
     m_pBinaryReader(NULL),
     m_pScriptReader(NULL),
-    m_pWriter(NULL) {
+    m_pWriter(NULL),
+    m_pThreadPool(NULL) {
 }
 
 ObjectLinker::~ObjectLinker()
@@ -73,6 +166,7 @@ ObjectLinker::~ObjectLinker()
   delete m_pBinaryReader;
   delete m_pScriptReader;
   delete m_pWriter;
+  delete m_pThreadPool;
 }
 
 bool ObjectLinker::initialize(Module& pModule, IRBuilder& pBuilder)
@@ -90,6 +184,9 @@ bool ObjectLinker::initialize(Module& pModule, IRBuilder& pBuilder)
   m_pScriptReader  = new ScriptReader(*m_pGroupReader);
   m_pWriter        = m_LDBackend.createWriter();
 
+  // initialize the threads for the parallel phases
+  m_pThreadPool    = new ThreadPool(m_Config.options().numOfThreads());
+
   // initialize Relocator
   m_LDBackend.initRelocator();
 
@@ -113,6 +210,9 @@ bool ObjectLinker::initStdSections()
 
 void ObjectLinker::normalize()
 {
+  // -----  parse the objects in parallel  ----- //
+  readObjects();
+
   // -----  set up inputs  ----- //
   Module::input_iterator input, inEnd = m_pModule->input_end();
   for (input = m_pModule->input_begin(); input!=inEnd; ++input) {
@@ -193,6 +293,38 @@ void ObjectLinker::normalize()
   } // end of for
 }
 
+/// readObjects - parse the relocatable objects in the input tree in
+/// parallel. Each job reads the section headers, the sections that are not
+/// group members and decodes the symbol table of one object. The loop in
+/// normalize() then finishes every object serially in command-line order:
+///  - readSections() decides COMDAT and .gnu.linkonce groups through the
+///    shared signature map, where the first input wins, and reads .eh_frame
+///    and the target sections.
+///  - readSymbols() creates the symbols from the decoded table and resolves
+///    them into the NamePool, so the resolution result does not depend on
+///    the number of threads.
+/// Archive members are pulled in by GroupReader on demand and stay serial.
+void ObjectLinker::readObjects()
+{
+  if (!getThreadPool().isParallel() || m_Config.options().isBinaryInput())
+    return;
+
+  std::vector<ReadObjectJob> jobs;
+  Module::input_iterator input, inEnd = m_pModule->input_end();
+  for (input = m_pModule->input_begin(); input != inEnd; ++input) {
+    // only the inputs whose type is not known yet may be relocatable objects
+    if (Input::Unknown != (*input)->type() || !(*input)->hasMemArea())
+      continue;
+    jobs.push_back(ReadObjectJob(*getObjectReader(), **input));
+  }
+
+  ThreadPool::JobList job_list;
+  std::vector<ReadObjectJob>::iterator job, jEnd = jobs.end();
+  for (job = jobs.begin(); job != jEnd; ++job)
+    job_list.push_back(&*job);
+  getThreadPool().run(job_list);
+}
+
 bool ObjectLinker::linkable() const
 {
   // check we have input and output files
@@ -233,9 +365,21 @@ void ObjectLinker::dataStrippingOpt()
 {
   // Garbege collection
   if (m_Config.options().GCSections()) {
-    GarbageCollection GC(m_Config, m_LDBackend, *m_pModule);
+    GarbageCollection GC(m_Config, m_LDBackend, *m_pModule,
+                         getThreadPool());
     GC.run();
   }
+
+  // Merge the SHF_MERGE sections
+  SectionMerger merger(m_Config, *m_pModule, getThreadPool());
+  merger.run();
+
+  // Identical code folding, which sees the merged constants as identical
+  if (GeneralOptions::ICFNone != m_Config.options().getICFMode()) {
+    IdenticalCodeFolding ICF(m_Config, m_LDBackend, *m_pModule,
+                             getThreadPool());
+    ICF.run();
+  }
   return;
 }
 
@@ -598,6 +742,9 @@ bool ObjectLinker::prelayout()
     eh_frame_sect->getEhFrame()->computeOffsetSize();
   m_LDBackend.createAndSizeEhFrameHdr(*m_pModule);
 
+  // reserve .note.gnu.build-id, which is filled after the output is written
+  m_LDBackend.createAndSizeBuildID(*m_pModule);
+
   return true;
 }
 
@@ -685,137 +832,84 @@ bool ObjectLinker::finalizeSymbolValue()
   return finalized && scriptSymsFinalized && assertionsPassed;
 }
 
-/// relocate - applying relocation entries and create relocation
-/// section in the output files
-/// Create relocation section, asking TargetLDBackend to
-/// read the relocation information into RelocationEntry
-/// and push_back into the relocation section
-bool ObjectLinker::relocation()
+/// emitOutput - emit the output file.
+bool ObjectLinker::emitOutput(FileOutputBuffer& pOutput)
+{
+  return llvm::errc::success == getWriter()->writeObject(*m_pModule, pOutput,
+                                                         getThreadPool());
+}
+
+/// relocation - apply relocation entries to their places in the output file.
+/// The sections which are filled up by applying relocations (GOT and dynamic
+/// relocations) are written out afterwards.
+bool ObjectLinker::relocation(FileOutputBuffer& pOutput)
 {
+  Relocator& relocator = *m_LDBackend.getRelocator();
+  relocator.setOutput(pOutput.getBufferStart());
+
   // when producing relocatables, no need to apply relocation
-  if (LinkerConfig::Object == m_Config.codeGenType())
+  if (LinkerConfig::Object == m_Config.codeGenType()) {
+    partialSyncRelocationResult(pOutput);
+    relocator.setOutput(NULL);
     return true;
+  }
 
   // apply all relocations of all inputs
   Module::obj_iterator input, inEnd = m_pModule->obj_end();
-  for (input = m_pModule->obj_begin(); input != inEnd; ++input) {
-    m_LDBackend.getRelocator()->initializeApply(**input);
-    LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
-    for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
-      // bypass the reloc section if
-      // 1. its section kind is changed to Ignore. (The target section is a
-      // discarded group section.)
-      // 2. it has no reloc data. (All symbols in the input relocs are in the
-      // discarded group sections)
-      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
-        continue;
-      RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
-      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
-        Relocation* relocation = llvm::cast<Relocation>(reloc);
-
-        // bypass the reloc if the symbol is in the discarded input section
-        ResolveInfo* info = relocation->symInfo();
-        if (!info->outSymbol()->hasFragRef() &&
-            ResolveInfo::Section == info->type() &&
-            ResolveInfo::Undefined == info->desc())
-          continue;
-
-        relocation->apply(*m_LDBackend.getRelocator());
-      } // for all relocations
-    } // for all relocation section
-    m_LDBackend.getRelocator()->finalizeApply(**input);
-  } // for all inputs
+  if (getThreadPool().isParallel() && relocator.isApplyThreadSafe()) {
+    std::vector<ApplyRelocJob> jobs;
+    jobs.reserve(m_pModule->getObjectList().size());
+    for (input = m_pModule->obj_begin(); input != inEnd; ++input)
+      jobs.push_back(ApplyRelocJob(relocator, **input));
+
+    ThreadPool::JobList job_list;
+    std::vector<ApplyRelocJob>::iterator job, jEnd = jobs.end();
+    for (job = jobs.begin(); job != jEnd; ++job)
+      job_list.push_back(&*job);
+    getThreadPool().run(job_list);
+  }
+  else {
+    for (input = m_pModule->obj_begin(); input != inEnd; ++input)
+      applyRelocations(relocator, **input);
+  }
 
-  // apply relocations created by relaxation
+  // apply relocations created by relaxation. They may target the stubs shared
+  // by many inputs, so apply them after all inputs are done.
   BranchIslandFactory* br_factory = m_LDBackend.getBRIslandFactory();
   BranchIslandFactory::iterator facIter, facEnd = br_factory->end();
   for (facIter = br_factory->begin(); facIter != facEnd; ++facIter) {
     BranchIsland& island = *facIter;
     BranchIsland::reloc_iterator iter, iterEnd = island.reloc_end();
     for (iter = island.reloc_begin(); iter != iterEnd; ++iter)
-      (*iter)->apply(*m_LDBackend.getRelocator());
+      (*iter)->apply(relocator);
   }
-  return true;
-}
+  relocator.setOutput(NULL);
 
-/// emitOutput - emit the output file.
-bool ObjectLinker::emitOutput(FileOutputBuffer& pOutput)
-{
-  return llvm::errc::success == getWriter()->writeObject(*m_pModule, pOutput);
+  // write out the sections filled up by the relocator
+  Module::iterator sect, sectEnd = m_pModule->end();
+  for (sect = m_pModule->begin(); sect != sectEnd; ++sect) {
+    if (m_LDBackend.isFilledByRelocator(**sect))
+      getWriter()->writeSection(*m_pModule, pOutput, *sect);
+  }
+  return true;
 }
 
-
 /// postProcessing - do modification after all processes
 bool ObjectLinker::postProcessing(FileOutputBuffer& pOutput)
 {
-  if (LinkerConfig::Object != m_Config.codeGenType())
-    normalSyncRelocationResult(pOutput);
-  else
-    partialSyncRelocationResult(pOutput);
-
   // emit .eh_frame_hdr
-  // eh_frame_hdr should be emitted after syncRelocation, because eh_frame_hdr
-  // needs FDE PC value, which will be corrected at syncRelocation
+  // eh_frame_hdr should be emitted after relocation, because eh_frame_hdr
+  // needs FDE PC value, which will be corrected when applying relocations
   m_LDBackend.postProcessing(pOutput);
-  return true;
-}
-
-void ObjectLinker::normalSyncRelocationResult(FileOutputBuffer& pOutput)
-{
-  uint8_t* data = pOutput.getBufferStart();
-
-  // sync all relocations of all inputs
-  Module::obj_iterator input, inEnd = m_pModule->obj_end();
-  for (input = m_pModule->obj_begin(); input != inEnd; ++input) {
-    LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
-    for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
-      // bypass the reloc section if
-      // 1. its section kind is changed to Ignore. (The target section is a
-      // discarded group section.)
-      // 2. it has no reloc data. (All symbols in the input relocs are in the
-      // discarded group sections)
-      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
-        continue;
-      RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
-      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
-        Relocation* relocation = llvm::cast<Relocation>(reloc);
-
-        // bypass the reloc if the symbol is in the discarded input section
-        ResolveInfo* info = relocation->symInfo();
-        if (!info->outSymbol()->hasFragRef() &&
-            ResolveInfo::Section == info->type() &&
-            ResolveInfo::Undefined == info->desc())
-          continue;
-
-        // bypass the relocation with NONE type. This is to avoid overwrite the
-        // target result by NONE type relocation if there is a place which has
-        // two relocations to apply to, and one of it is NONE type. The result
-        // we want is the value of the other relocation result. For example,
-        // in .exidx, there are usually an R_ARM_NONE and R_ARM_PREL31 apply to
-        // the same place
-        if (0x0 == relocation->type())
-          continue;
-        writeRelocationResult(*relocation, data);
-      } // for all relocations
-    } // for all relocation section
-  } // for all inputs
 
-  // sync relocations created by relaxation
-  BranchIslandFactory* br_factory = m_LDBackend.getBRIslandFactory();
-  BranchIslandFactory::iterator facIter, facEnd = br_factory->end();
-  for (facIter = br_factory->begin(); facIter != facEnd; ++facIter) {
-    BranchIsland& island = *facIter;
-    BranchIsland::reloc_iterator iter, iterEnd = island.reloc_end();
-    for (iter = island.reloc_begin(); iter != iterEnd; ++iter) {
-      Relocation* reloc = *iter;
-      writeRelocationResult(*reloc, data);
-    }
-  }
+  // the build ID is a hash of the whole output, so it is written at last
+  m_LDBackend.emitBuildID(pOutput, getThreadPool());
+  return true;
 }
 
 void ObjectLinker::partialSyncRelocationResult(FileOutputBuffer& pOutput)
 {
-  uint8_t* data = pOutput.getBufferStart();
+  Relocator& relocator = *m_LDBackend.getRelocator();
 
   // traverse outputs' LDSection to get RelocData
   Module::iterator sectIter, sectEnd = m_pModule->end();
@@ -823,62 +917,24 @@ void ObjectLinker::partialSyncRelocationResult(FileOutputBuffer& pOutput)
     if (LDFileFormat::Relocation != (*sectIter)->kind())
       continue;
 
+    // Relocator::partialScanRelocation keeps the offset of the input section
+    // in the addend. Rela entries carry it in their addend field, and Rel
+    // entries add it to the place.
+    if (llvm::ELF::SHT_REL != (*sectIter)->type())
+      continue;
+
     RelocData* reloc_data = (*sectIter)->getRelocData();
     RelocData::iterator relocIter, relocEnd = reloc_data->end();
     for (relocIter = reloc_data->begin(); relocIter != relocEnd; ++relocIter) {
       Relocation* reloc = llvm::cast<Relocation>(relocIter);
 
-      // bypass the relocation with NONE type. This is to avoid overwrite the
-      // target result by NONE type relocation if there is a place which has
-      // two relocations to apply to, and one of it is NONE type. The result
-      // we want is the value of the other relocation result. For example,
-      // in .exidx, there are usually an R_ARM_NONE and R_ARM_PREL31 apply to
-      // the same place
-      if (0x0 == reloc->type())
+      // a NONE relocation leaves its place as it is
+      if (0x0 == reloc->type() || 0x0 == reloc->addend())
         continue;
-      writeRelocationResult(*reloc, data);
+      relocator.writeTarget(*reloc,
+                            relocator.readTarget(*reloc) + reloc->addend());
     }
   }
 }
 
-void ObjectLinker::writeRelocationResult(Relocation& pReloc, uint8_t* pOutput)
-{
-  // get output file offset
-  size_t out_offset =
-                 pReloc.targetRef().frag()->getParent()->getSection().offset() +
-                 pReloc.targetRef().getOutputOffset();
-
-  uint8_t* target_addr = pOutput + out_offset;
-  // byte swapping if target and host has different endian, and then write back
-  if(llvm::sys::IsLittleEndianHost != m_Config.targets().isLittleEndian()) {
-     uint64_t tmp_data = 0;
-
-     switch(pReloc.size(*m_LDBackend.getRelocator())) {
-       case 8u:
-         std::memcpy(target_addr, &pReloc.target(), 1);
-         break;
-
-       case 16u:
-         tmp_data = mcld::bswap16(pReloc.target());
-         std::memcpy(target_addr, &tmp_data, 2);
-         break;
-
-       case 32u:
-         tmp_data = mcld::bswap32(pReloc.target());
-         std::memcpy(target_addr, &tmp_data, 4);
-         break;
-
-       case 64u:
-         tmp_data = mcld::bswap64(pReloc.target());
-         std::memcpy(target_addr, &tmp_data, 8);
-         break;
-
-       default:
-         break;
-    }
-  }
-  else
-    std::memcpy(target_addr, &pReloc.target(),
-                                      pReloc.size(*m_LDBackend.getRelocator())/8);
-}
 
@@ -16,10 +16,15 @@
 #include <mcld/LD/LDSection.h>
 #include <mcld/LD/SectionData.h>
 #include <mcld/Fragment/NullFragment.h>
+#include <mcld/ADT/HashEntry.h>
+#include <mcld/ADT/HashTable.h>
+#include <mcld/ADT/StringHash.h>
 #include <llvm/Support/Casting.h>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <climits>
+#include <list>
 #if !defined(MCLD_ON_WIN32)
 #include <fnmatch.h>
 #define fnmatch0(pattern,string) (fnmatch(pattern,string,0) == 0)
@@ -156,11 +161,208 @@ SectionMap::Output::dot_iterator SectionMap::Output::find_last_explicit_dot()
   return dot_end();
 }
 
+//===----------------------------------------------------------------------===//
+// SectionMap::Matcher
+//===----------------------------------------------------------------------===//
+/** \class SectionMap::Matcher
+ *  \brief Matcher is the compiled form of the input section descriptions.
+ *
+ *  Every input section description is a rule, numbered in the order find()
+ *  used to visit them, and the first matching rule wins. The section
+ *  patterns of the rules are indexed by their kind:
+ *   - a literal name is looked up in a hash table,
+ *   - a prefix pattern ("name*") is looked up by hashing each prefix of the
+ *     section name whose length is used by some pattern,
+ *   - the other wildcard patterns are kept in the rule order and matched by
+ *     fnmatch, only up to the best rule found by the indexes.
+ *  A rule whose section pattern matches is then checked against the file
+ *  name and the excluded files.
+ */
+struct SectionMap::Matcher
+{
+  typedef HashEntry<const llvm::StringRef,
+                    size_t,
+                    hash::StringCompare<llvm::StringRef> > EntryType;
+
+  typedef HashTable<EntryType,
+                    hash::StringHash<hash::DJB>,
+                    EntryFactory<EntryType> > IndexType;
+
+  typedef std::vector<size_t> RuleList;
+
+  typedef std::pair<const WildcardPattern*, size_t> Glob;
+
+  /// NotFound - the rule number of an unmatched section
+  static const size_t NotFound = ~size_t(0);
+
+  Matcher(const SectionMap& pMap);
+
+  /// find - get the number of the first rule that matches
+  size_t find(const SectionMap& pMap,
+              const std::string& pInputFile,
+              const std::string& pInputSection);
+
+  /// index - add pRule to the rules of pKey in pIndex
+  void index(IndexType& pIndex, const llvm::StringRef& pKey, size_t pRule);
+
+  /// lookUp - append the rules of pKey in pIndex to pResult
+  void lookUp(const IndexType& pIndex,
+              const llvm::StringRef& pKey,
+              RuleList& pResult) const;
+
+  /// isLiteral - a pattern without wildcard matches only its own name
+  static bool isLiteral(const std::string& pPattern);
+
+  std::vector<mapping> rules;
+
+  IndexType names;
+  IndexType prefixes;
+  std::vector<size_t> prefixLengths;
+  std::vector<RuleList> ruleLists;
+  std::vector<Glob> globs;
+
+  /// cache - the rule number of each (file, section) pair, the key is the
+  /// file name and the section name separated by a null character
+  IndexType cache;
+  std::list<std::string> cacheKeys;
+};
+
+SectionMap::Matcher::Matcher(const SectionMap& pMap)
+{
+  const_iterator out, outEnd = pMap.end();
+  for (out = pMap.begin(); out != outEnd; ++out) {
+    Output::const_iterator in, inEnd = (*out)->end();
+    for (in = (*out)->begin(); in != inEnd; ++in) {
+      size_t rule = rules.size();
+      rules.push_back(std::make_pair(const_cast<Output*>(*out),
+                                     const_cast<Input*>(*in)));
+      if (!(*in)->spec().hasSections())
+        continue;
+
+      StringList::const_iterator sect, sectEnd;
+      sectEnd = (*in)->spec().sections().end();
+      for (sect = (*in)->spec().sections().begin(); sect != sectEnd; ++sect) {
+        const WildcardPattern* pattern = llvm::cast<WildcardPattern>(*sect);
+        if (pattern->name().empty()) {
+          // an empty pattern is taken as a prefix pattern longer than any
+          // name, so it matches nothing
+          continue;
+        }
+
+        if (pattern->isPrefix()) {
+          index(prefixes, pattern->prefix(), rule);
+          prefixLengths.push_back(pattern->prefix().size());
+        }
+        else if (isLiteral(pattern->name()))
+          index(names, pattern->name(), rule);
+        else
+          globs.push_back(std::make_pair(pattern, rule));
+      }
+    }
+  }
+
+  std::sort(prefixLengths.begin(), prefixLengths.end());
+  prefixLengths.erase(std::unique(prefixLengths.begin(), prefixLengths.end()),
+                      prefixLengths.end());
+}
+
+size_t SectionMap::Matcher::find(const SectionMap& pMap,
+                                 const std::string& pInputFile,
+                                 const std::string& pInputSection)
+{
+  std::string key = pInputFile;
+  key.push_back('\0');
+  key.append(pInputSection);
+  IndexType::iterator cached = cache.find(key);
+  if (cached != cache.end())
+    return cached.getEntry()->value();
+
+  // the rules whose section patterns match, from the indexes
+  RuleList candidates;
+  lookUp(names, pInputSection, candidates);
+  llvm::StringRef sect_name(pInputSection);
+  std::vector<size_t>::const_iterator len, lenEnd = prefixLengths.end();
+  for (len = prefixLengths.begin(); len != lenEnd; ++len) {
+    if (*len > sect_name.size())
+      break;
+    lookUp(prefixes, sect_name.substr(0, *len), candidates);
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  size_t result = NotFound;
+  RuleList::const_iterator cand, candEnd = candidates.end();
+  for (cand = candidates.begin(); cand != candEnd; ++cand) {
+    if (pMap.matchedFile(*rules[*cand].second, pInputFile)) {
+      result = *cand;
+      break;
+    }
+  }
+
+  // the wildcard patterns can only improve on a rule that comes later
+  std::vector<Glob>::const_iterator glob, globEnd = globs.end();
+  for (glob = globs.begin(); glob != globEnd; ++glob) {
+    if (glob->second >= result)
+      break;
+    if (pMap.matched(*glob->first, pInputSection) &&
+        pMap.matchedFile(*rules[glob->second].second, pInputFile)) {
+      result = glob->second;
+      break;
+    }
+  }
+
+  cacheKeys.push_back(key);
+  bool exist = false;
+  cache.insert(cacheKeys.back(), exist)->setValue(result);
+  return result;
+}
+
+void SectionMap::Matcher::index(IndexType& pIndex,
+                                const llvm::StringRef& pKey,
+                                size_t pRule)
+{
+  bool exist = false;
+  EntryType* entry = pIndex.insert(pKey, exist);
+  if (!exist) {
+    entry->setValue(ruleLists.size());
+    ruleLists.push_back(RuleList());
+  }
+  RuleList& list = ruleLists[entry->value()];
+  if (list.empty() || list.back() != pRule)
+    list.push_back(pRule);
+}
+
+void SectionMap::Matcher::lookUp(const IndexType& pIndex,
+                                 const llvm::StringRef& pKey,
+                                 RuleList& pResult) const
+{
+  IndexType::const_iterator entry = pIndex.find(pKey);
+  if (entry == pIndex.end())
+    return;
+  const RuleList& list = ruleLists[entry.getEntry()->value()];
+  pResult.insert(pResult.end(), list.begin(), list.end());
+}
+
+bool SectionMap::Matcher::isLiteral(const std::string& pPattern)
+{
+#if !defined(MCLD_ON_WIN32)
+  return (std::string::npos == pPattern.find_first_of("*?[\\"));
+#else
+  // PathMatchSpec ignores the case, so compare with it anyway
+  return false;
+#endif
+}
+
 //===----------------------------------------------------------------------===//
 // SectionMap
 //===----------------------------------------------------------------------===//
+SectionMap::SectionMap()
+  : m_pMatcher(NULL) {
+}
+
 SectionMap::~SectionMap()
 {
+  delete m_pMatcher;
+
   iterator out, outBegin = begin(), outEnd = end();
   for (out = outBegin; out != outEnd; ++out) {
     if (*out != NULL) {
@@ -178,29 +380,21 @@ SectionMap::const_mapping
 SectionMap::find(const std::string& pInputFile,
                  const std::string& pInputSection) const
 {
-  const_iterator out, outBegin = begin(), outEnd = end();
-  for (out = outBegin; out != outEnd; ++out) {
-    Output::const_iterator in, inBegin = (*out)->begin(), inEnd = (*out)->end();
-    for (in = inBegin; in != inEnd; ++in) {
-      if (matched(**in, pInputFile, pInputSection))
-        return std::make_pair(*out, *in);
-    }
-  }
-  return std::make_pair((const Output*)NULL, (const Input*)NULL);
+  size_t rule = getMatcher().find(*this, pInputFile, pInputSection);
+  if (Matcher::NotFound == rule)
+    return std::make_pair((const Output*)NULL, (const Input*)NULL);
+  const mapping& result = m_pMatcher->rules[rule];
+  return std::make_pair((const Output*)result.first,
+                        (const Input*)result.second);
 }
 
 SectionMap::mapping SectionMap::find(const std::string& pInputFile,
                                      const std::string& pInputSection)
 {
-  iterator out, outBegin = begin(), outEnd = end();
-  for (out = outBegin; out != outEnd; ++out) {
-    Output::iterator in, inBegin = (*out)->begin(), inEnd = (*out)->end();
-    for (in = inBegin; in != inEnd; ++in) {
-      if (matched(**in, pInputFile, pInputSection))
-        return std::make_pair(*out, *in);
-    }
-  }
-  return std::make_pair((Output*)NULL, (Input*)NULL);
+  size_t rule = getMatcher().find(*this, pInputFile, pInputSection);
+  if (Matcher::NotFound == rule)
+    return std::make_pair((Output*)NULL, (Input*)NULL);
+  return m_pMatcher->rules[rule];
 }
 
 SectionMap::const_iterator
@@ -230,6 +424,7 @@ SectionMap::insert(const std::string& pInputSection,
                    const std::string& pOutputSection,
                    InputSectDesc::KeepPolicy pPolicy)
 {
+  invalidate();
   iterator out, outBegin = begin(), outEnd = end();
   for (out = outBegin; out != outEnd; ++out) {
     if ((*out)->name().compare(pOutputSection) == 0)
@@ -263,6 +458,7 @@ std::pair<SectionMap::mapping, bool>
 SectionMap::insert(const InputSectDesc& pInputDesc,
                    const OutputSectDesc& pOutputDesc)
 {
+  invalidate();
   iterator out, outBegin = begin(), outEnd = end();
   for (out = outBegin; out != outEnd; ++out) {
     if ((*out)->name().compare(pOutputDesc.name()) == 0 &&
@@ -299,15 +495,28 @@ SectionMap::insert(const InputSectDesc& pInputDesc,
 SectionMap::iterator
 SectionMap::insert(iterator pPosition, LDSection* pSection)
 {
+  invalidate();
   Output* output = new Output(pSection->name());
   output->append(new Input(pSection->name(), InputSectDesc::NoKeep));
   output->setSection(pSection);
   return m_OutputDescList.insert(pPosition, output);
 }
 
-bool SectionMap::matched(const SectionMap::Input& pInput,
-                         const std::string& pInputFile,
-                         const std::string& pInputSection) const
+SectionMap::Matcher& SectionMap::getMatcher() const
+{
+  if (NULL == m_pMatcher)
+    m_pMatcher = new Matcher(*this);
+  return *m_pMatcher;
+}
+
+void SectionMap::invalidate()
+{
+  delete m_pMatcher;
+  m_pMatcher = NULL;
+}
+
+bool SectionMap::matchedFile(const SectionMap::Input& pInput,
+                             const std::string& pInputFile) const
 {
   if (pInput.spec().hasFile() && !matched(pInput.spec().file(), pInputFile))
       return false;
@@ -322,16 +531,7 @@ bool SectionMap::matched(const SectionMap::Input& pInput,
     }
   }
 
-  if (pInput.spec().hasSections()) {
-    StringList::const_iterator sect, sectEnd = pInput.spec().sections().end();
-    for (sect = pInput.spec().sections().begin(); sect != sectEnd; ++sect) {
-      if (matched(llvm::cast<WildcardPattern>(**sect), pInputSection)) {
-        return true;
-      }
-    }
-  }
-
-  return false;
+  return true;
 }
 
 bool SectionMap::matched(const WildcardPattern& pPattern,
@@ -124,6 +124,24 @@ FileStatus Directory::symlinkStatus() const
   return  m_SymLinkStatus;
 }
 
+Path* Directory::find(const llvm::StringRef& pFileName)
+{
+  // read all the entries into the cache
+  if (isGood() && !m_CacheFull) {
+    DirIterator reader(this, m_Cache.end());
+    while (!m_CacheFull)
+      detail::bring_one_into_cache(reader);
+  }
+
+  // the entries are keyed by their paths
+  std::string key(m_Path.native());
+  key.append(pFileName.data(), pFileName.size());
+  PathCache::iterator entry = m_Cache.find(key);
+  if (NULL == entry.getEntry())
+    return NULL;
+  return &entry.getEntry()->value();
+}
+
 Directory::iterator Directory::begin()
 {
   if (m_CacheFull && m_Cache.empty())
@@ -61,6 +61,9 @@ inline static int oflag(FileHandle::OpenMode pMode)
   if (FileHandle::Truncate == (pMode & FileHandle::Truncate))
     result |= O_TRUNC;
 
+  if (FileHandle::Exclusive == (pMode & FileHandle::Exclusive))
+    result |= O_EXCL;
+
   return result;
 }
 
@@ -161,6 +164,22 @@ bool FileHandle::truncate(size_t pSize)
   return true;
 }
 
+bool FileHandle::allocate(size_t pSize)
+{
+  if (!isOpened() || !isWritable()) {
+    setState(BadBit);
+    return false;
+  }
+
+  if (-1 == sys::fs::detail::fallocate(m_Handler, pSize)) {
+    setState(FailBit);
+    return false;
+  }
+
+  m_Size = pSize;
+  return true;
+}
+
 bool FileHandle::read(void* pMemBuffer, size_t pStartOffset, size_t pLength)
 {
   if (!isOpened() || !isReadable()) {
@@ -8,6 +8,7 @@
 //===----------------------------------------------------------------------===//
 #include <mcld/Support/FileOutputBuffer.h>
 #include <mcld/Support/FileHandle.h>
+#include <mcld/Support/FileSystem.h>
 #include <mcld/Support/Path.h>
 
 using namespace mcld;
@@ -15,7 +16,13 @@ using llvm::sys::fs::mapped_file_region;
 
 FileOutputBuffer::FileOutputBuffer(llvm::sys::fs::mapped_file_region* pRegion,
                                    FileHandle& pFileHandle)
-  : m_pRegion(pRegion), m_FileHandle(pFileHandle)
+  : m_pRegion(pRegion), m_pFileHandle(&pFileHandle),
+    m_pBuffer((uint8_t*)pRegion->data()), m_Size(pRegion->size())
+{
+}
+
+FileOutputBuffer::FileOutputBuffer(uint8_t* pBuffer, size_t pSize)
+  : m_pRegion(), m_pFileHandle(NULL), m_pBuffer(pBuffer), m_Size(pSize)
 {
 }
 
@@ -40,12 +47,22 @@ llvm::error_code FileOutputBuffer::create(FileHandle& pFileHandle,
   if (EC)
     return EC;
 
+  // The output is written almost in order, and may be large.
+  sys::fs::detail::advise_sequential(mapped_file->data(), mapped_file->size());
+
   pResult.reset(new FileOutputBuffer(mapped_file.get(), pFileHandle));
   if (pResult)
     mapped_file.take();
   return llvm::error_code::success();
 }
 
+llvm::error_code FileOutputBuffer::create(uint8_t* pBuffer,
+    size_t pSize, llvm::OwningPtr<FileOutputBuffer>& pResult)
+{
+  pResult.reset(new FileOutputBuffer(pBuffer, pSize));
+  return llvm::error_code::success();
+}
+
 MemoryRegion FileOutputBuffer::request(size_t pOffset, size_t pLength)
 {
   if (pOffset > getBufferSize() || (pOffset + pLength) > getBufferSize())
@@ -55,5 +72,7 @@ MemoryRegion FileOutputBuffer::request(size_t pOffset, size_t pLength)
 
 llvm::StringRef FileOutputBuffer::getPath() const
 {
-  return m_FileHandle.path().native();
+  if (NULL == m_pFileHandle)
+    return llvm::StringRef();
+  return m_pFileHandle->path().native();
 }
@@ -0,0 +1,144 @@
+//===- SHA1.cpp -----------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/Support/SHA1.h>
+
+#include <cstring>
+
+using namespace mcld;
+
+//===----------------------------------------------------------------------===//
+// Helper Functions
+//===----------------------------------------------------------------------===//
+static inline uint32_t RotateLeft(uint32_t pValue, unsigned int pBits)
+{
+  return (pValue << pBits) | (pValue >> (32 - pBits));
+}
+
+static inline uint32_t ReadBigEndian32(const uint8_t* pData)
+{
+  return ((uint32_t)pData[0] << 24) | ((uint32_t)pData[1] << 16) |
+         ((uint32_t)pData[2] << 8) | (uint32_t)pData[3];
+}
+
+static inline void WriteBigEndian32(uint8_t* pData, uint32_t pValue)
+{
+  pData[0] = (uint8_t)(pValue >> 24);
+  pData[1] = (uint8_t)(pValue >> 16);
+  pData[2] = (uint8_t)(pValue >> 8);
+  pData[3] = (uint8_t)pValue;
+}
+
+//===----------------------------------------------------------------------===//
+// SHA1
+//===----------------------------------------------------------------------===//
+SHA1::SHA1()
+  : m_BufferSize(0), m_Length(0) {
+  m_State[0] = 0x67452301;
+  m_State[1] = 0xEFCDAB89;
+  m_State[2] = 0x98BADCFE;
+  m_State[3] = 0x10325476;
+  m_State[4] = 0xC3D2E1F0;
+}
+
+void SHA1::update(const uint8_t* pData, size_t pSize)
+{
+  m_Length += pSize;
+
+  // fill up the pending block first
+  if (0 != m_BufferSize) {
+    size_t num = BlockSize - m_BufferSize;
+    if (num > pSize)
+      num = pSize;
+    memcpy(m_Buffer + m_BufferSize, pData, num);
+    m_BufferSize += num;
+    pData += num;
+    pSize -= num;
+    if (BlockSize != m_BufferSize)
+      return;
+    processBlock(m_Buffer);
+    m_BufferSize = 0;
+  }
+
+  // compress the whole blocks in place
+  for (; pSize >= BlockSize; pData += BlockSize, pSize -= BlockSize)
+    processBlock(pData);
+
+  memcpy(m_Buffer, pData, pSize);
+  m_BufferSize = pSize;
+}
+
+void SHA1::final(uint8_t pDigest[DigestSize])
+{
+  uint64_t bit_length = m_Length * 8;
+
+  // append the bit '1', zeros, and the 64-bit length of the message
+  m_Buffer[m_BufferSize++] = 0x80;
+  if (m_BufferSize > BlockSize - 8) {
+    memset(m_Buffer + m_BufferSize, 0, BlockSize - m_BufferSize);
+    processBlock(m_Buffer);
+    m_BufferSize = 0;
+  }
+  memset(m_Buffer + m_BufferSize, 0, BlockSize - 8 - m_BufferSize);
+  WriteBigEndian32(m_Buffer + BlockSize - 8, (uint32_t)(bit_length >> 32));
+  WriteBigEndian32(m_Buffer + BlockSize - 4, (uint32_t)bit_length);
+  processBlock(m_Buffer);
+  m_BufferSize = 0;
+
+  for (unsigned int i = 0; i < 5; ++i)
+    WriteBigEndian32(pDigest + 4 * i, m_State[i]);
+}
+
+void SHA1::processBlock(const uint8_t* pBlock)
+{
+  uint32_t w[80];
+  for (unsigned int i = 0; i < 16; ++i)
+    w[i] = ReadBigEndian32(pBlock + 4 * i);
+  for (unsigned int i = 16; i < 80; ++i)
+    w[i] = RotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+  uint32_t a = m_State[0];
+  uint32_t b = m_State[1];
+  uint32_t c = m_State[2];
+  uint32_t d = m_State[3];
+  uint32_t e = m_State[4];
+
+  for (unsigned int i = 0; i < 80; ++i) {
+    uint32_t f, k;
+    if (i < 20) {
+      f = (b & c) | (~b & d);
+      k = 0x5A827999;
+    }
+    else if (i < 40) {
+      f = b ^ c ^ d;
+      k = 0x6ED9EBA1;
+    }
+    else if (i < 60) {
+      f = (b & c) | (b & d) | (c & d);
+      k = 0x8F1BBCDC;
+    }
+    else {
+      f = b ^ c ^ d;
+      k = 0xCA62C1D6;
+    }
+
+    uint32_t temp = RotateLeft(a, 5) + f + e + k + w[i];
+    e = d;
+    d = c;
+    c = RotateLeft(b, 30);
+    b = a;
+    a = temp;
+  }
+
+  m_State[0] += a;
+  m_State[1] += b;
+  m_State[2] += c;
+  m_State[3] += d;
+  m_State[4] += e;
+}
+
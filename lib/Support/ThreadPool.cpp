@@ -0,0 +1,57 @@
+//===- ThreadPool.cpp -----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/Config/Config.h>
+#include <mcld/Support/ThreadPool.h>
+
+#include <cstddef>
+
+using namespace mcld;
+
+//===----------------------------------------------------------------------===//
+// ThreadPool
+//===----------------------------------------------------------------------===//
+ThreadPool::ThreadPool(unsigned int pNumOfThreads)
+  : m_NumOfThreads(pNumOfThreads), m_pImpl(NULL) {
+  if (0 == m_NumOfThreads)
+    m_NumOfThreads = GetNumOfProcessors();
+
+  if (isParallel())
+    startWorkers();
+}
+
+ThreadPool::~ThreadPool()
+{
+  if (NULL != m_pImpl)
+    stopWorkers();
+}
+
+void ThreadPool::run(JobList& pJobs)
+{
+  if (pJobs.empty())
+    return;
+
+  // no worker to share the jobs with
+  if (NULL == m_pImpl || 1 == pJobs.size()) {
+    JobList::iterator job, jEnd = pJobs.end();
+    for (job = pJobs.begin(); job != jEnd; ++job)
+      (*job)->run();
+    return;
+  }
+
+  runConcurrently(pJobs);
+}
+
+//===----------------------------------------------------------------------===//
+// Platform-dependent functions
+#if defined(MCLD_ON_UNIX)
+#include "Unix/ThreadPool.inc"
+#endif
+#if defined(MCLD_ON_WIN32)
+#include "Windows/ThreadPool.inc"
+#endif
@@ -351,6 +351,12 @@ bool AArch64GNULDBackend::mergeSection(Module& pModule,
   return true;
 }
 
+bool AArch64GNULDBackend::isCallRelocation(uint32_t pType) const
+{
+  return (llvm::ELF::R_AARCH64_CALL26 == pType ||
+          llvm::ELF::R_AARCH64_JUMP26 == pType);
+}
+
 bool AArch64GNULDBackend::readSection(Input& pInput, SectionData& pSD)
 {
   // TODO
@@ -104,6 +104,9 @@ public:
   /// mergeSection - merge target dependent sections
   bool mergeSection(Module& pModule, const Input& pInput, LDSection& pSection);
 
+  /// isCallRelocation - the relocations of BL and B
+  bool isCallRelocation(uint32_t pType) const;
+
   /// readSection - read target dependent sections
   bool readSection(Input& pInput, SectionData& pSD);
 
@@ -8,7 +8,9 @@
 //===----------------------------------------------------------------------===//
 
 #define DECL_AARCH64_APPLY_RELOC_FUNC(Name) \
-static AArch64Relocator::Result Name (Relocation& pEntry, AArch64Relocator& pParent);
+static AArch64Relocator::Result Name (Relocation& pEntry, \
+                                      AArch64Relocator::DWord& pTarget, \
+                                      AArch64Relocator& pParent);
 
 #define DECL_AARCH64_APPLY_RELOC_FUNCS \
 DECL_AARCH64_APPLY_RELOC_FUNC(none) \
@@ -32,6 +32,7 @@ DECL_AARCH64_APPLY_RELOC_FUNCS
 
 /// the prototype of applying function
 typedef Relocator::Result (*ApplyFunctionType)(Relocation& pReloc,
+                                               Relocator::DWord& pTarget,
                                                AArch64Relocator& pParent);
 
 // the table entry of applying functions
@@ -70,7 +71,8 @@ AArch64Relocator::~AArch64Relocator()
 {
 }
 
-Relocator::Result AArch64Relocator::applyRelocation(Relocation& pRelocation)
+Relocator::Result AArch64Relocator::applyRelocation(Relocation& pRelocation,
+                                                    DWord& pTarget)
 {
   Relocation::Type type = pRelocation.type();
   // valid types are 0x0, 0x100-0x239
@@ -78,7 +80,7 @@ Relocator::Result AArch64Relocator::applyRelocation(Relocation& pRelocation)
     return Relocator::Unknown;
   }
   assert(ApplyFunctions.find(type) != ApplyFunctions.end());
-  return ApplyFunctions[type].func(pRelocation, *this);
+  return ApplyFunctions[type].func(pRelocation, pTarget, *this);
 }
 
 const char* AArch64Relocator::getName(Relocator::Type pType) const
@@ -410,12 +412,14 @@ void AArch64Relocator::scanRelocation(Relocation& pReloc,
 //===----------------------------------------------------------------------===//
 
 // R_AARCH64_NONE
-Relocator::Result none(Relocation& pReloc, AArch64Relocator& pParent)
+Relocator::Result none(Relocation& pReloc, Relocator::DWord& pTarget,
+                       AArch64Relocator& pParent)
 {
   return Relocator::OK;
 }
 
-Relocator::Result unsupport(Relocation& pReloc, AArch64Relocator& pParent)
+Relocator::Result unsupport(Relocation& pReloc, Relocator::DWord& pTarget,
+                            AArch64Relocator& pParent)
 {
   return Relocator::Unsupport;
 }
@@ -423,10 +427,11 @@ Relocator::Result unsupport(Relocation& pReloc, AArch64Relocator& pParent)
 // R_AARCH64_ABS64: S + A
 // R_AARCH64_ABS32: S + A
 // R_AARCH64_ABS16: S + A
-Relocator::Result abs(Relocation& pReloc, AArch64Relocator& pParent)
+Relocator::Result abs(Relocation& pReloc, Relocator::DWord& pTarget,
+                      AArch64Relocator& pParent)
 {
   ResolveInfo* rsym = pReloc.symInfo();
-  Relocator::DWord A = pReloc.target() + pReloc.addend();
+  Relocator::DWord A = pTarget + pReloc.addend();
   Relocator::DWord S = pReloc.symValue();
   Relocation* dyn_rel = pParent.getRelRelMap().lookUp(pReloc);
   bool has_dyn_rel = (NULL != dyn_rel);
@@ -435,7 +440,7 @@ Relocator::Result abs(Relocation& pReloc, AArch64Relocator& pParent)
   // If the flag of target section is not ALLOC, we will not scan this
   // relocation but perform static relocation. (e.g., applying .debug section)
   if (0x0 == (llvm::ELF::SHF_ALLOC & target_sect.flag())) {
-    pReloc.target() = S + A;
+    pTarget = S + A;
     return Relocator::OK;
   }
   // A local symbol may need RELATIVE Type dynamic relocation
@@ -464,14 +469,15 @@ Relocator::Result abs(Relocation& pReloc, AArch64Relocator& pParent)
   }
 
   // perform static relocation
-  pReloc.target() = S + A;
+  pTarget = S + A;
   return Relocator::OK;
 }
 
 // R_AARCH64_PREL64: S + A - P
 // R_AARCH64_PREL32: S + A - P
 // R_AARCH64_PREL16: S + A - P
-Relocator::Result rel(Relocation& pReloc, AArch64Relocator& pParent)
+Relocator::Result rel(Relocation& pReloc, Relocator::DWord& pTarget,
+                      AArch64Relocator& pParent)
 {
   ResolveInfo* rsym = pReloc.symInfo();
   Relocator::Address S = pReloc.symValue();
@@ -479,9 +485,9 @@ Relocator::Result rel(Relocation& pReloc, AArch64Relocator& pParent)
   Relocator::DWord   P = pReloc.place();
 
   if (llvm::ELF::R_AARCH64_PREL64 != pReloc.type())
-    A +=  pReloc.target() & get_mask(pParent.getSize(pReloc.type()));
+    A +=  pTarget & get_mask(pParent.getSize(pReloc.type()));
   else
-    A += pReloc.target();
+    A += pTarget;
 
   LDSection& target_sect = pReloc.targetRef().frag()->getParent()->getSection();
   // If the flag of target section is not ALLOC, we will not scan this
@@ -496,7 +502,7 @@ Relocator::Result rel(Relocation& pReloc, AArch64Relocator& pParent)
   }
 
   Relocator::DWord X = S + A - P;
-  pReloc.target() = X;
+  pTarget = X;
 
   if (llvm::ELF::R_AARCH64_PREL64 != pReloc.type() &&
       helper_check_signed_overflow(X, pParent.getSize(pReloc.type())))
@@ -505,14 +511,15 @@ Relocator::Result rel(Relocation& pReloc, AArch64Relocator& pParent)
 }
 
 // R_AARCH64_ADD_ABS_LO12_NC: S + A
-Relocator::Result add_abs_lo12(Relocation& pReloc, AArch64Relocator& pParent)
+Relocator::Result add_abs_lo12(Relocation& pReloc, Relocator::DWord& pTarget,
+                               AArch64Relocator& pParent)
 {
   Relocator::Address value = 0x0;
   Relocator::Address S = pReloc.symValue();
   Relocator::DWord   A = pReloc.addend();
 
   value = helper_get_page_offset(S + A);
-  pReloc.target() = helper_reencode_add_imm(pReloc.target(), value);
+  pTarget = helper_reencode_add_imm(pTarget, value);
 
   return Relocator::OK;
 }
@@ -520,7 +527,9 @@ Relocator::Result add_abs_lo12(Relocation& pReloc, AArch64Relocator& pParent)
 // R_AARCH64_ADR_PREL_PG_HI21: ((PG(S + A) - PG(P)) >> 12)
 // R_AARCH64_ADR_PREL_PG_HI21_NC: ((PG(S + A) - PG(P)) >> 12)
 Relocator::Result
-adr_prel_pg_hi21(Relocation& pReloc, AArch64Relocator& pParent)
+adr_prel_pg_hi21(Relocation& pReloc,
+                 Relocator::DWord& pTarget,
+                 AArch64Relocator& pParent)
 {
   ResolveInfo* rsym = pReloc.symInfo();
   Relocator::Address S = pReloc.symValue();
@@ -533,14 +542,15 @@ adr_prel_pg_hi21(Relocation& pReloc, AArch64Relocator& pParent)
   Relocator::DWord X = helper_get_page_address(S + A) -
                        helper_get_page_address(P);
 
-  pReloc.target() = helper_reencode_adr_imm(pReloc.target(), (X >> 12));
+  pTarget = helper_reencode_adr_imm(pTarget, (X >> 12));
 
   return Relocator::OK;
 }
 
 // R_AARCH64_CALL26: S + A - P
 // R_AARCH64_JUMP26: S + A - P
-Relocator::Result call(Relocation& pReloc, AArch64Relocator& pParent)
+Relocator::Result call(Relocation& pReloc, Relocator::DWord& pTarget,
+                       AArch64Relocator& pParent)
 {
   // If target is undefined weak symbol, we only need to jump to the
   // next instruction unless it has PLT entry. Rewrite instruction
@@ -550,7 +560,7 @@ Relocator::Result call(Relocation& pReloc, AArch64Relocator& pParent)
       !pReloc.symInfo()->isDyn() &&
       !(pReloc.symInfo()->reserved() & AArch64Relocator::ReservePLT)) {
     // change target to NOP
-    pReloc.target() = 0xd503201f;
+    pTarget = 0xd503201f;
     return Relocator::OK;
   }
 
@@ -565,13 +575,14 @@ Relocator::Result call(Relocation& pReloc, AArch64Relocator& pParent)
   Relocator::DWord X = S + A - P;
   // TODO: check overflow..
 
-  pReloc.target() = helper_reencode_branch_offset_26(pReloc.target(), X >> 2);
+  pTarget = helper_reencode_branch_offset_26(pTarget, X >> 2);
 
   return Relocator::OK;
 }
 
 // R_AARCH64_CONDBR19: S + A - P
-Relocator::Result condbr(Relocation& pReloc, AArch64Relocator& pParent)
+Relocator::Result condbr(Relocation& pReloc, Relocator::DWord& pTarget,
+                         AArch64Relocator& pParent)
 {
   // If target is undefined weak symbol, we only need to jump to the
   // next instruction unless it has PLT entry. Rewrite instruction
@@ -581,7 +592,7 @@ Relocator::Result condbr(Relocation& pReloc, AArch64Relocator& pParent)
       !pReloc.symInfo()->isDyn() &&
       !(pReloc.symInfo()->reserved() & AArch64Relocator::ReservePLT)) {
     // change target to NOP
-    pReloc.target() = 0xd503201f;
+    pTarget = 0xd503201f;
     return Relocator::OK;
   }
 
@@ -596,13 +607,14 @@ Relocator::Result condbr(Relocation& pReloc, AArch64Relocator& pParent)
   Relocator::DWord X = S + A - P;
   // TODO: check overflow..
 
-  pReloc.target() = helper_reencode_cond_branch_ofs_19(pReloc.target(), X >> 2);
+  pTarget = helper_reencode_cond_branch_ofs_19(pTarget, X >> 2);
 
   return Relocator::OK;
 }
 
 // R_AARCH64_ADR_GOT_PAGE: Page(G(GDAT(S+A))) - Page(P)
-Relocator::Result adr_got_page(Relocation& pReloc, AArch64Relocator& pParent)
+Relocator::Result adr_got_page(Relocation& pReloc, Relocator::DWord& pTarget,
+                               AArch64Relocator& pParent)
 {
   if (!(pReloc.symInfo()->reserved() & AArch64Relocator::ReserveGOT)) {
     return Relocator::BadReloc;
@@ -614,12 +626,15 @@ Relocator::Result adr_got_page(Relocation& pReloc, AArch64Relocator& pParent)
   Relocator::DWord X = helper_get_page_address(GOT_S + A) -
                        helper_get_page_address(P);
 
-  pReloc.target() = helper_reencode_adr_imm(pReloc.target(), (X >> 12));
+  pTarget = helper_reencode_adr_imm(pTarget, (X >> 12));
 
   // setup got entry value if needed
   AArch64GOTEntry* got_entry = pParent.getSymGOTMap().lookUp(*pReloc.symInfo());
-  if (NULL != got_entry && AArch64Relocator::SymVal == got_entry->getValue())
-    got_entry->setValue(pReloc.symValue());
+  {
+    llvm::sys::ScopedLock lock(pParent.getEntryLock());
+    if (NULL != got_entry && AArch64Relocator::SymVal == got_entry->getValue())
+      got_entry->setValue(pReloc.symValue());
+  }
   // setup relocation addend if needed
   Relocation* dyn_rela = pParent.getRelRelMap().lookUp(pReloc);
   if ((NULL != dyn_rela) && (AArch64Relocator::SymVal == dyn_rela->addend())) {
@@ -629,7 +644,8 @@ Relocator::Result adr_got_page(Relocation& pReloc, AArch64Relocator& pParent)
 }
 
 // R_AARCH64_LD64_GOT_LO12_NC: G(GDAT(S+A))
-Relocator::Result ld64_got_lo12(Relocation& pReloc, AArch64Relocator& pParent)
+Relocator::Result ld64_got_lo12(Relocation& pReloc, Relocator::DWord& pTarget,
+                                AArch64Relocator& pParent)
 {
   if (!(pReloc.symInfo()->reserved() & AArch64Relocator::ReserveGOT)) {
     return Relocator::BadReloc;
@@ -639,12 +655,15 @@ Relocator::Result ld64_got_lo12(Relocation& pReloc, AArch64Relocator& pParent)
   Relocator::DWord A = pReloc.addend();
   Relocator::DWord X = helper_get_page_offset(GOT_S + A);
 
-  pReloc.target() = helper_reencode_ldst_pos_imm(pReloc.target(), (X >> 3));
+  pTarget = helper_reencode_ldst_pos_imm(pTarget, (X >> 3));
 
   // setup got entry value if needed
   AArch64GOTEntry* got_entry = pParent.getSymGOTMap().lookUp(*pReloc.symInfo());
-  if (NULL != got_entry && AArch64Relocator::SymVal == got_entry->getValue())
-    got_entry->setValue(pReloc.symValue());
+  {
+    llvm::sys::ScopedLock lock(pParent.getEntryLock());
+    if (NULL != got_entry && AArch64Relocator::SymVal == got_entry->getValue())
+      got_entry->setValue(pReloc.symValue());
+  }
 
   // setup relocation addend if needed
   Relocation* dyn_rela = pParent.getRelRelMap().lookUp(pReloc);
@@ -660,7 +679,8 @@ Relocator::Result ld64_got_lo12(Relocation& pReloc, AArch64Relocator& pParent)
 // R_AARCH64_LDST32_ABS_LO12_NC: S + A
 // R_AARCH64_LDST64_ABS_LO12_NC: S + A
 // R_AARCH64_LDST128_ABS_LO12_NC: S + A
-Relocator::Result ldst_abs_lo12(Relocation& pReloc, AArch64Relocator& pParent)
+Relocator::Result ldst_abs_lo12(Relocation& pReloc, Relocator::DWord& pTarget,
+                                AArch64Relocator& pParent)
 {
   Relocator::Address S = pReloc.symValue();
   Relocator::DWord A = pReloc.addend();
@@ -668,22 +688,22 @@ Relocator::Result ldst_abs_lo12(Relocation& pReloc, AArch64Relocator& pParent)
 
   switch(pReloc.type()) {
      case llvm::ELF::R_AARCH64_LDST8_ABS_LO12_NC:
-       pReloc.target() = helper_reencode_ldst_pos_imm(pReloc.target(), X);
+       pTarget = helper_reencode_ldst_pos_imm(pTarget, X);
        break;
      case llvm::ELF::R_AARCH64_LDST16_ABS_LO12_NC:
-       pReloc.target() = helper_reencode_ldst_pos_imm(pReloc.target(),
+       pTarget = helper_reencode_ldst_pos_imm(pTarget,
                                                       (X >> 1));
        break;
      case llvm::ELF::R_AARCH64_LDST32_ABS_LO12_NC:
-       pReloc.target() = helper_reencode_ldst_pos_imm(pReloc.target(),
+       pTarget = helper_reencode_ldst_pos_imm(pTarget,
                                                       (X >> 2));
        break;
      case llvm::ELF::R_AARCH64_LDST64_ABS_LO12_NC:
-       pReloc.target() = helper_reencode_ldst_pos_imm(pReloc.target(),
+       pTarget = helper_reencode_ldst_pos_imm(pTarget,
                                                       (X >> 3));
        break;
      case llvm::ELF::R_AARCH64_LDST128_ABS_LO12_NC:
-       pReloc.target() = helper_reencode_ldst_pos_imm(pReloc.target(),
+       pTarget = helper_reencode_ldst_pos_imm(pTarget,
                                                       (X >> 4));
        break;
     default:
@@ -84,7 +84,11 @@ public:
   AArch64Relocator(AArch64GNULDBackend& pParent, const LinkerConfig& pConfig);
   ~AArch64Relocator();
 
-  Result applyRelocation(Relocation& pRelocation);
+  Result applyRelocation(Relocation& pRelocation, DWord& pTarget);
+
+  /// isApplyThreadSafe - relocations of different inputs can be applied
+  /// concurrently
+  bool isApplyThreadSafe() const { return true; }
 
   AArch64GNULDBackend& getTarget()
   { return m_Target; }
@@ -453,8 +453,6 @@ void ARMGNULDBackend::setUpReachedSectionsForGC(const Module& pModule,
 
       if (llvm::ELF::SHT_ARM_EXIDX == apply_sect->type()) {
         // 1. set up the reference according to relocations
-        bool add_first = false;
-        GarbageCollection::SectionListTy* reached_sects = NULL;
         RelocData::iterator reloc_it, rEnd = reloc_sect->getRelocData()->end();
         for (reloc_it = reloc_sect->getRelocData()->begin(); reloc_it != rEnd;
                                                                    ++reloc_it) {
@@ -475,16 +473,8 @@ void ARMGNULDBackend::setUpReachedSectionsForGC(const Module& pModule,
               target_sect->kind() != LDFileFormat::BSS)
             continue;
 
-          // setup the reached list, if we first add the element to reached list
-          // of this section, create an entry in ReachedSections map
-          if (!add_first) {
-            reached_sects = &pSectReachedListMap.getReachedList(*apply_sect);
-            add_first = true;
-          }
-          reached_sects->insert(target_sect);
+          pSectReachedListMap.addReference(*apply_sect, *target_sect);
         }
-        reached_sects = NULL;
-        add_first = false;
         // 2. set up the reference from XXX to .ARM.exidx.XXX
         assert(apply_sect->getLink() != NULL);
         pSectReachedListMap.addReference(*apply_sect->getLink(), *apply_sect);
@@ -493,6 +483,21 @@ void ARMGNULDBackend::setUpReachedSectionsForGC(const Module& pModule,
   }
 }
 
+bool ARMGNULDBackend::isCallRelocation(uint32_t pType) const
+{
+  switch (pType) {
+    case llvm::ELF::R_ARM_PC24:
+    case llvm::ELF::R_ARM_PLT32:
+    case llvm::ELF::R_ARM_CALL:
+    case llvm::ELF::R_ARM_JUMP24:
+    case llvm::ELF::R_ARM_THM_CALL:
+    case llvm::ELF::R_ARM_THM_JUMP24:
+      return true;
+    default:
+      return false;
+  }
+}
+
 bool ARMGNULDBackend::readSection(Input& pInput, SectionData& pSD)
 {
   Fragment* frag = NULL;
@@ -123,6 +123,9 @@ public:
   void setUpReachedSectionsForGC(const Module& pModule,
            GarbageCollection::SectionReachedListMap& pSectReachedListMap) const;
 
+  /// isCallRelocation - the relocations of BL, BLX and B
+  bool isCallRelocation(uint32_t pType) const;
+
   /// readSection - read target dependent sections
   bool readSection(Input& pInput, SectionData& pSD);
 
@@ -9,6 +9,7 @@
 
 #define DECL_ARM_APPLY_RELOC_FUNC(Name) \
 static ARMRelocator::Result Name    (Relocation& pEntry, \
+                                     ARMRelocator::DWord& pTarget, \
                                      ARMRelocator& pParent);
 
 #define DECL_ARM_APPLY_RELOC_FUNCS \
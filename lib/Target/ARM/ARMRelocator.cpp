@@ -320,6 +320,7 @@ DECL_ARM_APPLY_RELOC_FUNCS
 
 /// the prototype of applying function
 typedef Relocator::Result (*ApplyFunctionType)(Relocation& pReloc,
+                                               Relocator::DWord& pTarget,
                                                ARMRelocator& pParent);
 
 // the table entry of applying functions
@@ -349,14 +350,14 @@ ARMRelocator::~ARMRelocator()
 }
 
 Relocator::Result
-ARMRelocator::applyRelocation(Relocation& pRelocation)
+ARMRelocator::applyRelocation(Relocation& pRelocation, DWord& pTarget)
 {
   Relocation::Type type = pRelocation.type();
   if (type > 130) { // 131-255 doesn't noted in ARM spec
     return Relocator::Unknown;
   }
 
-  return ApplyFunctions[type].func(pRelocation, *this);
+  return ApplyFunctions[type].func(pRelocation, pTarget, *this);
 }
 
 const char* ARMRelocator::getName(Relocator::Type pType) const
@@ -807,17 +808,19 @@ void ARMRelocator::scanRelocation(Relocation& pReloc,
 //=========================================//
 
 // R_ARM_NONE
-ARMRelocator::Result none(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result none(Relocation& pReloc, ARMRelocator::DWord& pTarget,
+                          ARMRelocator& pParent)
 {
   return Relocator::OK;
 }
 
 // R_ARM_ABS32: (S + A) | T
-ARMRelocator::Result abs32(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result abs32(Relocation& pReloc, ARMRelocator::DWord& pTarget,
+                           ARMRelocator& pParent)
 {
   ResolveInfo* rsym = pReloc.symInfo();
   Relocator::DWord T = getThumbBit(pReloc);
-  Relocator::DWord A = pReloc.target() + pReloc.addend();
+  Relocator::DWord A = pTarget + pReloc.addend();
   Relocator::DWord S = pReloc.symValue();
   if (T != 0x0)
     helper_clear_thumb_bit(S);
@@ -826,7 +829,7 @@ ARMRelocator::Result abs32(Relocation& pReloc, ARMRelocator& pParent)
   // but perform static relocation. (e.g., applying .debug section)
   if (0x0 == (llvm::ELF::SHF_ALLOC &
       pReloc.targetRef().frag()->getParent()->getSection().flag())) {
-    pReloc.target() = (S + A) | T;
+    pTarget = (S + A) | T;
     return Relocator::OK;
   }
 
@@ -845,17 +848,18 @@ ARMRelocator::Result abs32(Relocation& pReloc, ARMRelocator& pParent)
   }
 
   // perform static relocation
-  pReloc.target() = (S + A) | T;
+  pTarget = (S + A) | T;
   return Relocator::OK;
 }
 
 // R_ARM_REL32: ((S + A) | T) - P
-ARMRelocator::Result rel32(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result rel32(Relocation& pReloc, ARMRelocator::DWord& pTarget,
+                           ARMRelocator& pParent)
 {
   // perform static relocation
   Relocator::Address S = pReloc.symValue();
   Relocator::DWord   T = getThumbBit(pReloc);
-  Relocator::DWord   A = pReloc.target() + pReloc.addend();
+  Relocator::DWord   A = pTarget + pReloc.addend();
 
   // An external symbol may need PLT (this reloc is from a stub/veneer)
   if (!pReloc.symInfo()->isLocal()) {
@@ -869,78 +873,90 @@ ARMRelocator::Result rel32(Relocation& pReloc, ARMRelocator& pParent)
     helper_clear_thumb_bit(S);
 
   // perform relocation
-  pReloc.target() = ((S + A) | T) - pReloc.place();
+  pTarget = ((S + A) | T) - pReloc.place();
 
   return Relocator::OK;
 }
 
 // R_ARM_BASE_PREL: B(S) + A - P
-ARMRelocator::Result base_prel(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result base_prel(Relocation& pReloc, ARMRelocator::DWord& pTarget,
+                               ARMRelocator& pParent)
 {
   // perform static relocation
-  Relocator::DWord A = pReloc.target() + pReloc.addend();
-  pReloc.target() = pReloc.symValue() + A - pReloc.place();
+  Relocator::DWord A = pTarget + pReloc.addend();
+  pTarget = pReloc.symValue() + A - pReloc.place();
   return Relocator::OK;
 }
 
 // R_ARM_GOTOFF32: ((S + A) | T) - GOT_ORG
-ARMRelocator::Result gotoff32(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result gotoff32(Relocation& pReloc, ARMRelocator::DWord& pTarget,
+                              ARMRelocator& pParent)
 {
   Relocator::DWord T = getThumbBit(pReloc);
-  Relocator::DWord A = pReloc.target() + pReloc.addend();
+  Relocator::DWord A = pTarget + pReloc.addend();
   Relocator::Address GOT_ORG = helper_GOT_ORG(pParent);
   Relocator::Address S = pReloc.symValue();
   if (T != 0x0)
     helper_clear_thumb_bit(S);
 
-  pReloc.target() = ((S + A) | T) - GOT_ORG;
+  pTarget = ((S + A) | T) - GOT_ORG;
   return Relocator::OK;
 }
 
 // R_ARM_GOT_BREL: GOT(S) + A - GOT_ORG
-ARMRelocator::Result got_brel(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result got_brel(Relocation& pReloc, ARMRelocator::DWord& pTarget,
+                              ARMRelocator& pParent)
 {
   if (!(pReloc.symInfo()->reserved() & ARMRelocator::ReserveGOT))
     return Relocator::BadReloc;
 
   Relocator::Address GOT_S = helper_get_GOT_address(*pReloc.symInfo(), pParent);
-  Relocator::DWord   A = pReloc.target() + pReloc.addend();
+  Relocator::DWord   A = pTarget + pReloc.addend();
   Relocator::Address GOT_ORG = helper_GOT_ORG(pParent);
   // Apply relocation.
-  pReloc.target() = GOT_S + A - GOT_ORG;
+  pTarget = GOT_S + A - GOT_ORG;
 
   // setup got entry value if needed
   ARMGOTEntry* got_entry = pParent.getSymGOTMap().lookUp(*pReloc.symInfo());
-  if (NULL != got_entry && ARMRelocator::SymVal == got_entry->getValue())
-    got_entry->setValue(pReloc.symValue());
+  {
+    llvm::sys::ScopedLock lock(pParent.getEntryLock());
+    if (NULL != got_entry && ARMRelocator::SymVal == got_entry->getValue())
+      got_entry->setValue(pReloc.symValue());
+  }
   return Relocator::OK;
 }
 
 // R_ARM_GOT_PREL: GOT(S) + A - P
-ARMRelocator::Result got_prel(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result got_prel(Relocation& pReloc, ARMRelocator::DWord& pTarget,
+                              ARMRelocator& pParent)
 {
   if (!(pReloc.symInfo()->reserved() & ARMRelocator::ReserveGOT)) {
     return Relocator::BadReloc;
   }
   Relocator::Address GOT_S = helper_get_GOT_address(*pReloc.symInfo(), pParent);
-  Relocator::DWord   A     = pReloc.target() + pReloc.addend();
+  Relocator::DWord   A     = pTarget + pReloc.addend();
   Relocator::Address P     = pReloc.place();
 
   // Apply relocation.
-  pReloc.target() = GOT_S + A - P;
+  pTarget = GOT_S + A - P;
 
   // setup got entry value if needed
   ARMGOTEntry* got_entry = pParent.getSymGOTMap().lookUp(*pReloc.symInfo());
-  if (NULL != got_entry && ARMRelocator::SymVal == got_entry->getValue())
-    got_entry->setValue(pReloc.symValue());
+  {
+    llvm::sys::ScopedLock lock(pParent.getEntryLock());
+    if (NULL != got_entry && ARMRelocator::SymVal == got_entry->getValue())
+      got_entry->setValue(pReloc.symValue());
+  }
   return Relocator::OK;
 }
 
 // R_ARM_THM_JUMP11: S + A - P
-ARMRelocator::Result thm_jump11(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result thm_jump11(Relocation& pReloc,
+                                ARMRelocator::DWord& pTarget,
+                                ARMRelocator& pParent)
 {
   Relocator::DWord P = pReloc.place();
-  Relocator::DWord A = helper_sign_extend((pReloc.target() & 0x07ff) << 1, 11) +
+  Relocator::DWord A = helper_sign_extend((pTarget & 0x07ff) << 1, 11) +
                        pReloc.addend();
   // S depends on PLT exists or not
   Relocator::Address S = pReloc.symValue();
@@ -951,16 +967,18 @@ ARMRelocator::Result thm_jump11(Relocation& pReloc, ARMRelocator& pParent)
   if (helper_check_signed_overflow(X, 11))
     return Relocator::Overflow;
   //                    Make sure the Imm is 0.          Result Mask.
-  pReloc.target() = (pReloc.target() & 0xFFFFF800u) | ((X & 0x0FFEu) >> 1);
+  pTarget = (pTarget & 0xFFFFF800u) | ((X & 0x0FFEu) >> 1);
   return Relocator::OK;
 }
 
 // R_ARM_THM_JUMP19: ((S + A) | T) - P
-ARMRelocator::Result thm_jump19(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result thm_jump19(Relocation& pReloc,
+                                ARMRelocator::DWord& pTarget,
+                                ARMRelocator& pParent)
 {
   // get lower and upper 16 bit instructions from relocation targetData
-  uint16_t upper_inst = *(reinterpret_cast<uint16_t*>(&pReloc.target()));
-  uint16_t lower_inst = *(reinterpret_cast<uint16_t*>(&pReloc.target()) + 1);
+  uint16_t upper_inst = *(reinterpret_cast<uint16_t*>(&pTarget));
+  uint16_t lower_inst = *(reinterpret_cast<uint16_t*>(&pTarget) + 1);
 
   Relocator::DWord T = getThumbBit(pReloc);
   Relocator::DWord A = helper_thumb32_cond_branch_offset(upper_inst,
@@ -991,8 +1009,8 @@ ARMRelocator::Result thm_jump19(Relocation& pReloc, ARMRelocator& pParent)
   upper_inst = helper_thumb32_cond_branch_upper(upper_inst, X);
   lower_inst = helper_thumb32_cond_branch_lower(lower_inst, X);
 
-  *(reinterpret_cast<uint16_t*>(&pReloc.target())) = upper_inst;
-  *(reinterpret_cast<uint16_t*>(&pReloc.target()) + 1) = lower_inst;
+  *(reinterpret_cast<uint16_t*>(&pTarget)) = upper_inst;
+  *(reinterpret_cast<uint16_t*>(&pTarget) + 1) = lower_inst;
 
   return Relocator::OK;
 }
@@ -1001,7 +1019,8 @@ ARMRelocator::Result thm_jump19(Relocation& pReloc, ARMRelocator& pParent)
 // R_ARM_PLT32: ((S + A) | T) - P
 // R_ARM_JUMP24: ((S + A) | T) - P
 // R_ARM_CALL: ((S + A) | T) - P
-ARMRelocator::Result call(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result call(Relocation& pReloc, ARMRelocator::DWord& pTarget,
+                          ARMRelocator& pParent)
 {
   // If target is undefined weak symbol, we only need to jump to the
   // next instruction unless it has PLT entry. Rewrite instruction
@@ -1011,13 +1030,13 @@ ARMRelocator::Result call(Relocation& pReloc, ARMRelocator& pParent)
       !pReloc.symInfo()->isDyn() &&
       !(pReloc.symInfo()->reserved() & ARMRelocator::ReservePLT)) {
     // change target to NOP : mov r0, r0
-    pReloc.target() = (pReloc.target() & 0xf0000000U) | 0x01a00000;
+    pTarget = (pTarget & 0xf0000000U) | 0x01a00000;
     return Relocator::OK;
   }
 
   Relocator::DWord   T = getThumbBit(pReloc);
   Relocator::DWord   A =
-    helper_sign_extend((pReloc.target() & 0x00FFFFFFu) << 2, 26) +
+    helper_sign_extend((pTarget & 0x00FFFFFFu) << 2, 26) +
     pReloc.addend();
   Relocator::Address P = pReloc.place();
   Relocator::Address S = pReloc.symValue();
@@ -1041,7 +1060,7 @@ ARMRelocator::Result call(Relocation& pReloc, ARMRelocator& pParent)
     if (pReloc.type() == llvm::ELF::R_ARM_PC24)
       return Relocator::BadReloc;
 
-    pReloc.target() = (pReloc.target() & 0xffffff) |
+    pTarget = (pTarget & 0xffffff) |
                       0xfa000000 |
                       (((S + A - P) & 2) << 23);
   }
@@ -1051,13 +1070,14 @@ ARMRelocator::Result call(Relocation& pReloc, ARMRelocator& pParent)
   if (helper_check_signed_overflow(X, 26))
     return Relocator::Overflow;
   //                    Make sure the Imm is 0.          Result Mask.
-  pReloc.target() = (pReloc.target() & 0xFF000000u) | ((X & 0x03FFFFFEu) >> 2);
+  pTarget = (pTarget & 0xFF000000u) | ((X & 0x03FFFFFEu) >> 2);
   return Relocator::OK;
 }
 
 // R_ARM_THM_CALL: ((S + A) | T) - P
 // R_ARM_THM_JUMP24: ((S + A) | T) - P
-ARMRelocator::Result thm_call(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result thm_call(Relocation& pReloc, ARMRelocator::DWord& pTarget,
+                              ARMRelocator& pParent)
 {
   // If target is undefined weak symbol, we only need to jump to the
   // next instruction unless it has PLT entry. Rewrite instruction
@@ -1066,13 +1086,13 @@ ARMRelocator::Result thm_call(Relocation& pReloc, ARMRelocator& pParent)
       pReloc.symInfo()->isUndef() &&
       !pReloc.symInfo()->isDyn() &&
       !(pReloc.symInfo()->reserved() & ARMRelocator::ReservePLT)) {
-    pReloc.target() = (0xe000U << 16) | 0xbf00U;
+    pTarget = (0xe000U << 16) | 0xbf00U;
     return Relocator::OK;
   }
 
   // get lower and upper 16 bit instructions from relocation targetData
-  uint16_t upper_inst = *(reinterpret_cast<uint16_t*>(&pReloc.target()));
-  uint16_t lower_inst = *(reinterpret_cast<uint16_t*>(&pReloc.target()) + 1);
+  uint16_t upper_inst = *(reinterpret_cast<uint16_t*>(&pTarget));
+  uint16_t lower_inst = *(reinterpret_cast<uint16_t*>(&pTarget) + 1);
 
   Relocator::DWord T = getThumbBit(pReloc);
   Relocator::DWord A = helper_thumb32_branch_offset(upper_inst, lower_inst);
@@ -1122,20 +1142,22 @@ ARMRelocator::Result thm_call(Relocation& pReloc, ARMRelocator& pParent)
   upper_inst = helper_thumb32_branch_upper(upper_inst, X);
   lower_inst = helper_thumb32_branch_lower(lower_inst, X);
 
-  *(reinterpret_cast<uint16_t*>(&pReloc.target())) = upper_inst;
-  *(reinterpret_cast<uint16_t*>(&pReloc.target()) + 1) = lower_inst;
+  *(reinterpret_cast<uint16_t*>(&pTarget)) = upper_inst;
+  *(reinterpret_cast<uint16_t*>(&pTarget) + 1) = lower_inst;
 
   return Relocator::OK;
 }
 
 // R_ARM_MOVW_ABS_NC: (S + A) | T
-ARMRelocator::Result movw_abs_nc(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result movw_abs_nc(Relocation& pReloc,
+                                 ARMRelocator::DWord& pTarget,
+                                 ARMRelocator& pParent)
 {
   ResolveInfo* rsym = pReloc.symInfo();
   Relocator::Address S = pReloc.symValue();
   Relocator::DWord T = getThumbBit(pReloc);
   Relocator::DWord A =
-             helper_extract_movw_movt_addend(pReloc.target()) + pReloc.addend();
+             helper_extract_movw_movt_addend(pTarget) + pReloc.addend();
   if (T != 0x0)
     helper_clear_thumb_bit(S);
 
@@ -1153,19 +1175,21 @@ ARMRelocator::Result movw_abs_nc(Relocation& pReloc, ARMRelocator& pParent)
 
   // perform static relocation
   Relocator::DWord X = (S + A) | T;
-  pReloc.target() = helper_insert_val_movw_movt_inst(
-                                         pReloc.target() + pReloc.addend(), X);
+  pTarget = helper_insert_val_movw_movt_inst(
+                                         pTarget + pReloc.addend(), X);
   return Relocator::OK;
 }
 
 // R_ARM_MOVW_PREL_NC: ((S + A) | T) - P
-ARMRelocator::Result movw_prel_nc(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result movw_prel_nc(Relocation& pReloc,
+                                  ARMRelocator::DWord& pTarget,
+                                  ARMRelocator& pParent)
 {
   Relocator::Address S = pReloc.symValue();
   Relocator::DWord T = getThumbBit(pReloc);
   Relocator::DWord P = pReloc.place();
   Relocator::DWord A =
-             helper_extract_movw_movt_addend(pReloc.target()) + pReloc.addend();
+             helper_extract_movw_movt_addend(pTarget) + pReloc.addend();
   if (T != 0x0)
     helper_clear_thumb_bit(S);
   Relocator::DWord X = ((S + A) | T) - P;
@@ -1173,18 +1197,19 @@ ARMRelocator::Result movw_prel_nc(Relocation& pReloc, ARMRelocator& pParent)
   if (helper_check_signed_overflow(X, 16)) {
     return Relocator::Overflow;
   } else {
-    pReloc.target() = helper_insert_val_movw_movt_inst(pReloc.target(), X);
+    pTarget = helper_insert_val_movw_movt_inst(pTarget, X);
     return Relocator::OK;
   }
 }
 
 // R_ARM_MOVT_ABS: S + A
-ARMRelocator::Result movt_abs(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result movt_abs(Relocation& pReloc, ARMRelocator::DWord& pTarget,
+                              ARMRelocator& pParent)
 {
   ResolveInfo* rsym = pReloc.symInfo();
   Relocator::Address S = pReloc.symValue();
   Relocator::DWord A =
-             helper_extract_movw_movt_addend(pReloc.target()) + pReloc.addend();
+             helper_extract_movw_movt_addend(pTarget) + pReloc.addend();
 
   LDSection& target_sect = pReloc.targetRef().frag()->getParent()->getSection();
 
@@ -1200,26 +1225,29 @@ ARMRelocator::Result movt_abs(Relocation& pReloc, ARMRelocator& pParent)
   Relocator::DWord X = S + A;
   X >>= 16;
   // perform static relocation
-  pReloc.target() = helper_insert_val_movw_movt_inst(pReloc.target(), X);
+  pTarget = helper_insert_val_movw_movt_inst(pTarget, X);
   return Relocator::OK;
 }
 
 // R_ARM_MOVT_PREL: S + A - P
-ARMRelocator::Result movt_prel(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result movt_prel(Relocation& pReloc, ARMRelocator::DWord& pTarget,
+                               ARMRelocator& pParent)
 {
   Relocator::Address S = pReloc.symValue();
   Relocator::DWord P = pReloc.place();
   Relocator::DWord A =
-             helper_extract_movw_movt_addend(pReloc.target()) + pReloc.addend();
+             helper_extract_movw_movt_addend(pTarget) + pReloc.addend();
   Relocator::DWord X = S + A - P;
   X >>= 16;
 
-  pReloc.target() = helper_insert_val_movw_movt_inst(pReloc.target(), X);
+  pTarget = helper_insert_val_movw_movt_inst(pTarget, X);
   return Relocator::OK;
 }
 
 // R_ARM_THM_MOVW_ABS_NC: (S + A) | T
-ARMRelocator::Result thm_movw_abs_nc(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result thm_movw_abs_nc(Relocation& pReloc,
+                                     ARMRelocator::DWord& pTarget,
+                                     ARMRelocator& pParent)
 {
   ResolveInfo* rsym = pReloc.symInfo();
   Relocator::Address S = pReloc.symValue();
@@ -1228,8 +1256,8 @@ ARMRelocator::Result thm_movw_abs_nc(Relocation& pReloc, ARMRelocator& pParent)
     helper_clear_thumb_bit(S);
 
   // get lower and upper 16 bit instructions from relocation targetData
-  uint16_t upper_inst = *(reinterpret_cast<uint16_t*>(&pReloc.target()));
-  uint16_t lower_inst = *(reinterpret_cast<uint16_t*>(&pReloc.target()) + 1);
+  uint16_t upper_inst = *(reinterpret_cast<uint16_t*>(&pTarget));
+  uint16_t lower_inst = *(reinterpret_cast<uint16_t*>(&pTarget) + 1);
   Relocator::DWord val = ((upper_inst) << 16) | (lower_inst);
   Relocator::DWord A =
                    helper_extract_thumb_movw_movt_addend(val) + pReloc.addend();
@@ -1247,14 +1275,16 @@ ARMRelocator::Result thm_movw_abs_nc(Relocation& pReloc, ARMRelocator& pParent)
   Relocator::DWord X = (S + A) | T;
 
   val = helper_insert_val_thumb_movw_movt_inst(val, X);
-  *(reinterpret_cast<uint16_t*>(&pReloc.target())) = val >> 16;
-  *(reinterpret_cast<uint16_t*>(&pReloc.target()) + 1) = val & 0xFFFFu;
+  *(reinterpret_cast<uint16_t*>(&pTarget)) = val >> 16;
+  *(reinterpret_cast<uint16_t*>(&pTarget) + 1) = val & 0xFFFFu;
 
   return Relocator::OK;
 }
 
 // R_ARM_THM_MOVW_PREL_NC: ((S + A) | T) - P
-ARMRelocator::Result thm_movw_prel_nc(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result thm_movw_prel_nc(Relocation& pReloc,
+                                      ARMRelocator::DWord& pTarget,
+                                      ARMRelocator& pParent)
 {
   Relocator::Address S = pReloc.symValue();
   Relocator::DWord T = getThumbBit(pReloc);
@@ -1263,23 +1293,25 @@ ARMRelocator::Result thm_movw_prel_nc(Relocation& pReloc, ARMRelocator& pParent)
     helper_clear_thumb_bit(S);
 
   // get lower and upper 16 bit instructions from relocation targetData
-  uint16_t upper_inst = *(reinterpret_cast<uint16_t*>(&pReloc.target()));
-  uint16_t lower_inst = *(reinterpret_cast<uint16_t*>(&pReloc.target()) + 1);
+  uint16_t upper_inst = *(reinterpret_cast<uint16_t*>(&pTarget));
+  uint16_t lower_inst = *(reinterpret_cast<uint16_t*>(&pTarget) + 1);
   Relocator::DWord val = ((upper_inst) << 16) | (lower_inst);
   Relocator::DWord A =
                    helper_extract_thumb_movw_movt_addend(val) + pReloc.addend();
   Relocator::DWord X = ((S + A) | T) - P;
 
   val = helper_insert_val_thumb_movw_movt_inst(val, X);
-  *(reinterpret_cast<uint16_t*>(&pReloc.target())) = val >> 16;
-  *(reinterpret_cast<uint16_t*>(&pReloc.target()) + 1) = val & 0xFFFFu;
+  *(reinterpret_cast<uint16_t*>(&pTarget)) = val >> 16;
+  *(reinterpret_cast<uint16_t*>(&pTarget) + 1) = val & 0xFFFFu;
 
   return Relocator::OK;
 }
 
 // R_ARM_THM_MOVW_BREL_NC: ((S + A) | T) - B(S)
 // R_ARM_THM_MOVW_BREL: ((S + A) | T) - B(S)
-ARMRelocator::Result thm_movw_brel(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result thm_movw_brel(Relocation& pReloc,
+                                   ARMRelocator::DWord& pTarget,
+                                   ARMRelocator& pParent)
 {
   Relocator::Address S = pReloc.symValue();
   Relocator::DWord T = getThumbBit(pReloc);
@@ -1288,8 +1320,8 @@ ARMRelocator::Result thm_movw_brel(Relocation& pReloc, ARMRelocator& pParent)
     helper_clear_thumb_bit(S);
 
   // get lower and upper 16 bit instructions from relocation targetData
-  uint16_t upper_inst = *(reinterpret_cast<uint16_t*>(&pReloc.target()));
-  uint16_t lower_inst = *(reinterpret_cast<uint16_t*>(&pReloc.target()) + 1);
+  uint16_t upper_inst = *(reinterpret_cast<uint16_t*>(&pTarget));
+  uint16_t lower_inst = *(reinterpret_cast<uint16_t*>(&pTarget) + 1);
   Relocator::DWord val = ((upper_inst) << 16) | (lower_inst);
   Relocator::DWord A =
                    helper_extract_thumb_movw_movt_addend(val) + pReloc.addend();
@@ -1297,21 +1329,23 @@ ARMRelocator::Result thm_movw_brel(Relocation& pReloc, ARMRelocator& pParent)
   Relocator::DWord X = ((S + A) | T) - P;
 
   val = helper_insert_val_thumb_movw_movt_inst(val, X);
-  *(reinterpret_cast<uint16_t*>(&pReloc.target())) = val >> 16;
-  *(reinterpret_cast<uint16_t*>(&pReloc.target()) + 1) = val & 0xFFFFu;
+  *(reinterpret_cast<uint16_t*>(&pTarget)) = val >> 16;
+  *(reinterpret_cast<uint16_t*>(&pTarget) + 1) = val & 0xFFFFu;
 
   return Relocator::OK;
 }
 
 // R_ARM_THM_MOVT_ABS: S + A
-ARMRelocator::Result thm_movt_abs(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result thm_movt_abs(Relocation& pReloc,
+                                  ARMRelocator::DWord& pTarget,
+                                  ARMRelocator& pParent)
 {
   ResolveInfo* rsym = pReloc.symInfo();
   Relocator::Address S = pReloc.symValue();
 
   // get lower and upper 16 bit instructions from relocation targetData
-  uint16_t upper_inst = *(reinterpret_cast<uint16_t*>(&pReloc.target()));
-  uint16_t lower_inst = *(reinterpret_cast<uint16_t*>(&pReloc.target()) + 1);
+  uint16_t upper_inst = *(reinterpret_cast<uint16_t*>(&pTarget));
+  uint16_t lower_inst = *(reinterpret_cast<uint16_t*>(&pTarget) + 1);
   Relocator::DWord val = ((upper_inst) << 16) | (lower_inst);
   Relocator::DWord A =
                    helper_extract_thumb_movw_movt_addend(val) + pReloc.addend();
@@ -1333,22 +1367,24 @@ ARMRelocator::Result thm_movt_abs(Relocation& pReloc, ARMRelocator& pParent)
   if (helper_check_signed_overflow(X, 16))
     return Relocator::Overflow;
   val = helper_insert_val_thumb_movw_movt_inst(val, X);
-  *(reinterpret_cast<uint16_t*>(&pReloc.target())) = val >> 16;
-  *(reinterpret_cast<uint16_t*>(&pReloc.target()) + 1) = val & 0xFFFFu;
+  *(reinterpret_cast<uint16_t*>(&pTarget)) = val >> 16;
+  *(reinterpret_cast<uint16_t*>(&pTarget) + 1) = val & 0xFFFFu;
   return Relocator::OK;
 
 }
 
 // R_ARM_THM_MOVT_PREL: S + A - P
 // R_ARM_THM_MOVT_BREL: S + A - B(S)
-ARMRelocator::Result thm_movt_prel(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result thm_movt_prel(Relocation& pReloc,
+                                   ARMRelocator::DWord& pTarget,
+                                   ARMRelocator& pParent)
 {
   Relocator::Address S = pReloc.symValue();
   Relocator::DWord P = pReloc.place();
 
   // get lower and upper 16 bit instructions from relocation targetData
-  uint16_t upper_inst = *(reinterpret_cast<uint16_t*>(&pReloc.target()));
-  uint16_t lower_inst = *(reinterpret_cast<uint16_t*>(&pReloc.target()) + 1);
+  uint16_t upper_inst = *(reinterpret_cast<uint16_t*>(&pTarget));
+  uint16_t lower_inst = *(reinterpret_cast<uint16_t*>(&pTarget) + 1);
   Relocator::DWord val = ((upper_inst) << 16) | (lower_inst);
   Relocator::DWord A =
                    helper_extract_thumb_movw_movt_addend(val) + pReloc.addend();
@@ -1356,16 +1392,17 @@ ARMRelocator::Result thm_movt_prel(Relocation& pReloc, ARMRelocator& pParent)
   X >>= 16;
 
   val = helper_insert_val_thumb_movw_movt_inst(val, X);
-  *(reinterpret_cast<uint16_t*>(&pReloc.target())) = val >> 16;
-  *(reinterpret_cast<uint16_t*>(&pReloc.target()) + 1) = val & 0xFFFFu;
+  *(reinterpret_cast<uint16_t*>(&pTarget)) = val >> 16;
+  *(reinterpret_cast<uint16_t*>(&pTarget) + 1) = val & 0xFFFFu;
 
   return Relocator::OK;
 }
 
 // R_ARM_PREL31: ((S + A) | T) - P
-ARMRelocator::Result prel31(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result prel31(Relocation& pReloc, ARMRelocator::DWord& pTarget,
+                            ARMRelocator& pParent)
 {
-  Relocator::DWord target = pReloc.target();
+  Relocator::DWord target = pTarget;
   Relocator::DWord T = getThumbBit(pReloc);
   Relocator::DWord A = helper_sign_extend(target, 31) + pReloc.addend();
   Relocator::DWord P = pReloc.place();
@@ -1380,7 +1417,7 @@ ARMRelocator::Result prel31(Relocation& pReloc, ARMRelocator& pParent)
   }
 
   Relocator::DWord X = ((S + A) | T) - P;
-  pReloc.target() = helper_bit_select(target, X, 0x7fffffffU);
+  pTarget = helper_bit_select(target, X, 0x7fffffffU);
   if (helper_check_signed_overflow(X, 31))
     return Relocator::Overflow;
   return Relocator::OK;
@@ -1389,12 +1426,14 @@ ARMRelocator::Result prel31(Relocation& pReloc, ARMRelocator& pParent)
 // R_ARM_TLS_GD32: GOT(S) + A - P
 // R_ARM_TLS_IE32: GOT(S) + A - P
 // R_ARM_TLS_LE32: S + A - tp
-ARMRelocator::Result tls(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result tls(Relocation& pReloc, ARMRelocator::DWord& pTarget,
+                         ARMRelocator& pParent)
 {
   return Relocator::Unsupport;
 }
 
-ARMRelocator::Result unsupport(Relocation& pReloc, ARMRelocator& pParent)
+ARMRelocator::Result unsupport(Relocation& pReloc, ARMRelocator::DWord& pTarget,
+                               ARMRelocator& pParent)
 {
   return Relocator::Unsupport;
 }
@@ -68,7 +68,11 @@ public:
   ARMRelocator(ARMGNULDBackend& pParent, const LinkerConfig& pConfig);
   ~ARMRelocator();
 
-  Result applyRelocation(Relocation& pRelocation);
+  Result applyRelocation(Relocation& pRelocation, DWord& pTarget);
+
+  /// isApplyThreadSafe - relocations of different inputs can be applied
+  /// concurrently
+  bool isApplyThreadSafe() const { return true; }
 
   ARMGNULDBackend& getTarget()
   { return m_Target; }
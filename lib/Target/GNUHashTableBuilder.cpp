@@ -0,0 +1,79 @@
+//===- GNUHashTableBuilder.cpp --------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/Target/GNUHashTableBuilder.h>
+
+#include <cassert>
+#include <cstddef>
+
+using namespace mcld;
+
+//===----------------------------------------------------------------------===//
+// GNUHashTableBuilder
+//===----------------------------------------------------------------------===//
+GNUHashTableBuilder::GNUHashTableBuilder(uint32_t pNumOfBuckets,
+                                         uint32_t pMaskBitsLog2,
+                                         unsigned int pBitClass)
+  : m_NumOfBuckets(pNumOfBuckets),
+    m_MaskBitsLog2(pMaskBitsLog2),
+    m_BitClass(pBitClass) {
+  assert(0 != m_NumOfBuckets);
+  assert(32 == m_BitClass || 64 == m_BitClass);
+}
+
+uint32_t GNUHashTableBuilder::numOfMaskWords() const
+{
+  uint32_t shift1 = (64 == m_BitClass) ? 6 : 5;
+  return 1u << (m_MaskBitsLog2 - shift1);
+}
+
+void GNUHashTableBuilder::build(const std::vector<uint32_t>& pHashes,
+                                uint32_t pSymIdx)
+{
+  size_t num = pHashes.size();
+  uint32_t shift1 = (64 == m_BitClass) ? 6 : 5;
+  uint32_t mask = (1u << shift1) - 1;
+  uint32_t maskwords = numOfMaskWords();
+
+  m_Order.assign(num, 0);
+  m_Buckets.assign(m_NumOfBuckets, 0);
+  m_Chains.assign(num, 0);
+  m_Bloom.assign(maskwords, 0);
+
+  // count the symbols of each bucket, and set up the bloom filter
+  std::vector<uint32_t> start(m_NumOfBuckets + 1, 0);
+  for (size_t idx = 0; idx < num; ++idx) {
+    uint32_t hash = pHashes[idx];
+    ++start[hash % m_NumOfBuckets + 1];
+
+    uint64_t& word = m_Bloom[(hash >> shift1) & (maskwords - 1)];
+    word |= uint64_t(1) << (hash & mask);
+    word |= uint64_t(1) << ((hash >> m_MaskBitsLog2) & mask);
+  }
+
+  // start[b] is the position of the first symbol in bucket b
+  for (uint32_t b = 0; b < m_NumOfBuckets; ++b) {
+    if (0 != start[b + 1])
+      m_Buckets[b] = pSymIdx + start[b];
+    start[b + 1] += start[b];
+  }
+
+  // place the symbols, the order inside a bucket is kept
+  for (size_t idx = 0; idx < num; ++idx) {
+    uint32_t pos = start[pHashes[idx] % m_NumOfBuckets]++;
+    m_Order[pos] = idx;
+    m_Chains[pos] = pHashes[idx] & ~1u;
+  }
+
+  // start[b] is now the end of bucket b, mark the last symbol of each chain
+  for (uint32_t b = 0; b < m_NumOfBuckets; ++b) {
+    if (0 != m_Buckets[b])
+      m_Chains[start[b] - 1] |= 1u;
+  }
+}
+
@@ -13,7 +13,6 @@
 #include <cassert>
 #include <vector>
 #include <algorithm>
-#include <map>
 
 #include <mcld/Module.h>
 #include <mcld/LinkerConfig.h>
@@ -26,11 +25,13 @@
 #include <mcld/LD/LDContext.h>
 #include <mcld/LD/EhFrame.h>
 #include <mcld/LD/EhFrameHdr.h>
+#include <mcld/LD/BuildID.h>
 #include <mcld/LD/RelocData.h>
 #include <mcld/LD/RelocationFactory.h>
 #include <mcld/LD/BranchIslandFactory.h>
 #include <mcld/LD/ELFSegmentFactory.h>
 #include <mcld/LD/ELFSegment.h>
+#include <mcld/LD/StringTableBuilder.h>
 #include <mcld/LD/StubFactory.h>
 #include <mcld/LD/ELFFileFormat.h>
 #include <mcld/LD/ELFObjectFileFormat.h>
@@ -39,6 +40,7 @@
 #include <mcld/Target/ELFAttribute.h>
 #include <mcld/Target/ELFDynamic.h>
 #include <mcld/Target/GNUInfo.h>
+#include <mcld/Target/GNUHashTableBuilder.h>
 #include <mcld/Support/FileOutputBuffer.h>
 #include <mcld/Support/MsgHandling.h>
 #include <mcld/Object/ObjectBuilder.h>
@@ -69,6 +71,21 @@ static bool isCIdentifier(const std::string& pName)
               == std::string::npos);
 }
 
+/// getRpathString - the value of DT_RPATH/DT_RUNPATH, the paths separated by
+/// colons
+static std::string getRpathString(const mcld::GeneralOptions& pOptions)
+{
+  std::string result;
+  mcld::GeneralOptions::const_rpath_iterator rpath,
+                                             rpathEnd = pOptions.rpath_end();
+  for (rpath = pOptions.rpath_begin(); rpath != rpathEnd; ++rpath) {
+    if (rpath != pOptions.rpath_begin())
+      result.append(1, ':');
+    result.append(*rpath);
+  }
+  return result;
+}
+
 } // anonymous namespace
 
 using namespace mcld;
@@ -87,6 +104,7 @@ GNULDBackend::GNULDBackend(const LinkerConfig& pConfig, GNUInfo* pInfo)
     m_pBRIslandFactory(NULL),
     m_pStubFactory(NULL),
     m_pEhFrameHdr(NULL),
+    m_pBuildID(NULL),
     m_pAttribute(NULL),
     m_bHasTextRel(false),
     m_bHasStaticTLS(false),
@@ -111,6 +129,9 @@ GNULDBackend::GNULDBackend(const LinkerConfig& pConfig, GNUInfo* pInfo)
     f_p_End(NULL) {
   m_pELFSegmentTable = new ELFSegmentFactory();
   m_pSymIndexMap = new HashTableType(1024);
+  m_pStrTab = new StringTableBuilder();
+  m_pDynStrTab = new StringTableBuilder();
+  m_pShStrTab = new StringTableBuilder();
   m_pAttribute = new ELFAttribute(*this, pConfig);
 }
 
@@ -122,7 +143,11 @@ GNULDBackend::~GNULDBackend()
   delete m_pExecFileFormat;
   delete m_pObjectFileFormat;
   delete m_pSymIndexMap;
+  delete m_pStrTab;
+  delete m_pDynStrTab;
+  delete m_pShStrTab;
   delete m_pEhFrameHdr;
+  delete m_pBuildID;
   delete m_pAttribute;
   delete m_pBRIslandFactory;
   delete m_pStubFactory;
@@ -742,13 +767,14 @@ const ELFFileFormat* GNULDBackend::getOutputFormat() const
 /// sizeShstrtab - compute the size of .shstrtab
 void GNULDBackend::sizeShstrtab(Module& pModule)
 {
-  size_t shstrtab = 0;
-  // compute the size of .shstrtab section.
+  // compute the layout of .shstrtab section.
+  m_pShStrTab->clear();
   Module::const_iterator sect, sectEnd = pModule.end();
   for (sect = pModule.begin(); sect != sectEnd; ++sect) {
-    shstrtab += (*sect)->name().size() + 1;
+    m_pShStrTab->add((*sect)->name());
   } // end of for
-  getOutputFormat()->getShStrTab().setSize(shstrtab);
+  m_pShStrTab->finalize();
+  getOutputFormat()->getShStrTab().setSize(m_pShStrTab->size());
 }
 
 /// sizeNamePools - compute the size of regular name pools
@@ -763,10 +789,10 @@ void GNULDBackend::sizeNamePools(Module& pModule)
   size_t symtab = 1;
   size_t dynsym = config().isCodeStatic()? 0 : 1;
 
-  // size of string tables starts from 1 to hold the null character in their
-  // first byte
-  size_t strtab   = 1;
-  size_t dynstr   = config().isCodeStatic()? 0 : 1;
+  // string tables are laid out by StringTableBuilder, which merges the
+  // identical names and the names sharing a tail
+  size_t strtab   = 0;
+  size_t dynstr   = 0;
   size_t hash     = 0;
   size_t gnuhash  = 0;
 
@@ -774,6 +800,9 @@ void GNULDBackend::sizeNamePools(Module& pModule)
   size_t symtab_local_cnt = 0;
   size_t dynsym_local_cnt = 0;
 
+  m_pStrTab->clear();
+  m_pDynStrTab->clear();
+
   Module::SymbolTable& symbols = pModule.getSymbolTable();
   Module::const_sym_iterator symbol, symEnd;
   /// Compute the size of .symtab, .strtab, and symtab_local_cnt
@@ -792,8 +821,11 @@ void GNULDBackend::sizeNamePools(Module& pModule)
       for (symbol = symbols.begin(); symbol != symEnd; ++symbol) {
         ++symtab;
         if (hasEntryInStrTab(**symbol))
-          strtab += (*symbol)->nameSize() + 1;
+          m_pStrTab->add(llvm::StringRef((*symbol)->name(),
+                                         (*symbol)->nameSize()));
       }
+      m_pStrTab->finalize();
+      strtab = m_pStrTab->size();
       symtab_local_cnt = 1 + symbols.numOfFiles() + symbols.numOfLocals() +
                          symbols.numOfLocalDyns();
       break;
@@ -803,11 +835,7 @@ void GNULDBackend::sizeNamePools(Module& pModule)
   ELFFileFormat* file_format = getOutputFormat();
 
   switch(config().codeGenType()) {
-    case LinkerConfig::DynObj: {
-      // soname
-      dynstr += config().options().soname().size() + 1;
-    }
-    /** fall through **/
+    case LinkerConfig::DynObj:
     case LinkerConfig::Exec:
     case LinkerConfig::Binary: {
       if (!config().isCodeStatic()) {
@@ -816,7 +844,8 @@ void GNULDBackend::sizeNamePools(Module& pModule)
         for (symbol = symbols.localDynBegin(); symbol != symEnd; ++symbol) {
           ++dynsym;
           if (hasEntryInStrTab(**symbol))
-            dynstr += (*symbol)->nameSize() + 1;
+            m_pDynStrTab->add(llvm::StringRef((*symbol)->name(),
+                                              (*symbol)->nameSize()));
         }
         dynsym_local_cnt = 1 + symbols.numOfLocalDyns();
 
@@ -852,7 +881,7 @@ void GNULDBackend::sizeNamePools(Module& pModule)
         Module::const_lib_iterator lib, libEnd = pModule.lib_end();
         for (lib = pModule.lib_begin(); lib != libEnd; ++lib) {
           if (!(*lib)->attribute()->isAsNeeded() || (*lib)->isNeeded()) {
-            dynstr += (*lib)->name().size() + 1;
+            m_pDynStrTab->add((*lib)->name());
             dynamic().reserveNeedEntry();
           }
         }
@@ -860,13 +889,16 @@ void GNULDBackend::sizeNamePools(Module& pModule)
         // add DT_RPATH
         if (!config().options().getRpathList().empty()) {
           dynamic().reserveNeedEntry();
-          GeneralOptions::const_rpath_iterator rpath,
-            rpathEnd = config().options().rpath_end();
-          for (rpath = config().options().rpath_begin();
-               rpath != rpathEnd; ++rpath)
-            dynstr += (*rpath).size() + 1;
+          m_pDynStrTab->addCopy(getRpathString(config().options()));
         }
 
+        // add DT_SONAME
+        if (LinkerConfig::DynObj == config().codeGenType())
+          m_pDynStrTab->add(config().options().soname());
+
+        m_pDynStrTab->finalize();
+        dynstr = m_pDynStrTab->size();
+
         // set size
         if (config().targets().is32Bits()) {
           file_format->getDynSymTab().setSize(dynsym *
@@ -916,19 +948,12 @@ void GNULDBackend::sizeNamePools(Module& pModule)
 /// emitSymbol32 - emit an ELF32 symbol
 void GNULDBackend::emitSymbol32(llvm::ELF::Elf32_Sym& pSym,
                                 LDSymbol& pSymbol,
-                                char* pStrtab,
-                                size_t pStrtabsize,
+                                size_t pStrtabIdx,
                                 size_t pSymtabIdx)
 {
    // FIXME: check the endian between host and target
    // write out symbol
-   if (hasEntryInStrTab(pSymbol)) {
-     pSym.st_name  = pStrtabsize;
-     strcpy((pStrtab + pStrtabsize), pSymbol.name());
-   }
-   else {
-     pSym.st_name  = 0;
-   }
+   pSym.st_name  = pStrtabIdx;
    pSym.st_value = pSymbol.value();
    pSym.st_size  = getSymbolSize(pSymbol);
    pSym.st_info  = getSymbolInfo(pSymbol);
@@ -939,19 +964,12 @@ void GNULDBackend::emitSymbol32(llvm::ELF::Elf32_Sym& pSym,
 /// emitSymbol64 - emit an ELF64 symbol
 void GNULDBackend::emitSymbol64(llvm::ELF::Elf64_Sym& pSym,
                                 LDSymbol& pSymbol,
-                                char* pStrtab,
-                                size_t pStrtabsize,
+                                size_t pStrtabIdx,
                                 size_t pSymtabIdx)
 {
    // FIXME: check the endian between host and target
    // write out symbol
-   if (hasEntryInStrTab(pSymbol)) {
-     pSym.st_name  = pStrtabsize;
-     strcpy((pStrtab + pStrtabsize), pSymbol.name());
-   }
-   else {
-     pSym.st_name  = 0;
-   }
+   pSym.st_name  = pStrtabIdx;
    pSym.st_value = pSymbol.value();
    pSym.st_size  = getSymbolSize(pSymbol);
    pSym.st_info  = getSymbolInfo(pSymbol);
@@ -959,6 +977,28 @@ void GNULDBackend::emitSymbol64(llvm::ELF::Elf64_Sym& pSym,
    pSym.st_shndx = getSymbolShndx(pSymbol);
 }
 
+/// getStrtabIdx - get the offset of the symbol name in a string table
+size_t GNULDBackend::getStrtabIdx(const StringTableBuilder& pBuilder,
+                                  const LDSymbol& pSymbol,
+                                  char* pStrtab,
+                                  size_t& pStrtabsize) const
+{
+  if (!hasEntryInStrTab(pSymbol))
+    return 0;
+
+  llvm::StringRef name(pSymbol.name(), pSymbol.nameSize());
+  size_t offset = pBuilder.getOffset(name);
+  if (StringTableBuilder::NotFound != offset)
+    return offset;
+
+  // the symbol is created after the table is laid out
+  offset = pStrtabsize;
+  memcpy(pStrtab + offset, name.data(), name.size());
+  pStrtab[offset + name.size()] = '\0';
+  pStrtabsize += name.size() + 1;
+  return offset;
+}
+
 /// emitRegNamePools - emit regular name pools - .symtab, .strtab
 ///
 /// the size of these tables should be computed before layout
@@ -992,12 +1032,13 @@ void GNULDBackend::emitRegNamePools(const Module& pModule,
 
   // set up strtab_region
   char* strtab = (char*)strtab_region.begin();
+  m_pStrTab->emit(strtab);
 
   // emit the first ELF symbol
   if (config().targets().is32Bits())
-    emitSymbol32(symtab32[0], *LDSymbol::Null(), strtab, 0, 0);
+    emitSymbol32(symtab32[0], *LDSymbol::Null(), 0, 0);
   else
-    emitSymbol64(symtab64[0], *LDSymbol::Null(), strtab, 0, 0);
+    emitSymbol64(symtab64[0], *LDSymbol::Null(), 0, 0);
 
   bool sym_exist = false;
   HashTableType::entry_type* entry = NULL;
@@ -1007,7 +1048,7 @@ void GNULDBackend::emitRegNamePools(const Module& pModule,
   }
 
   size_t symIdx = 1;
-  size_t strtabsize = 1;
+  size_t strtabsize = m_pStrTab->size();
 
   const Module::SymbolTable& symbols = pModule.getSymbolTable();
   Module::const_sym_iterator symbol, symEnd;
@@ -1018,13 +1059,12 @@ void GNULDBackend::emitRegNamePools(const Module& pModule,
       entry = m_pSymIndexMap->insert(*symbol, sym_exist);
       entry->setValue(symIdx);
     }
+    size_t strIdx = getStrtabIdx(*m_pStrTab, **symbol, strtab, strtabsize);
     if (config().targets().is32Bits())
-      emitSymbol32(symtab32[symIdx], **symbol, strtab, strtabsize, symIdx);
+      emitSymbol32(symtab32[symIdx], **symbol, strIdx, symIdx);
     else
-      emitSymbol64(symtab64[symIdx], **symbol, strtab, strtabsize, symIdx);
+      emitSymbol64(symtab64[symIdx], **symbol, strIdx, symIdx);
     ++symIdx;
-    if (hasEntryInStrTab(**symbol))
-      strtabsize += (*symbol)->nameSize() + 1;
   }
 }
 
@@ -1067,15 +1107,16 @@ void GNULDBackend::emitDynNamePools(Module& pModule, FileOutputBuffer& pOutput)
 
   // set up strtab_region
   char* strtab = (char*)strtab_region.begin();
+  m_pDynStrTab->emit(strtab);
 
   // emit the first ELF symbol
   if (config().targets().is32Bits())
-    emitSymbol32(symtab32[0], *LDSymbol::Null(), strtab, 0, 0);
+    emitSymbol32(symtab32[0], *LDSymbol::Null(), 0, 0);
   else
-    emitSymbol64(symtab64[0], *LDSymbol::Null(), strtab, 0, 0);
+    emitSymbol64(symtab64[0], *LDSymbol::Null(), 0, 0);
 
   size_t symIdx = 1;
-  size_t strtabsize = 1;
+  size_t strtabsize = m_pDynStrTab->size();
 
   Module::SymbolTable& symbols = pModule.getSymbolTable();
   // emit .gnu.hash
@@ -1091,61 +1132,46 @@ void GNULDBackend::emitDynNamePools(Module& pModule, FileOutputBuffer& pOutput)
   // emit .dynsym, and .dynstr (emit LocalDyn and Dynamic category)
   Module::const_sym_iterator symbol, symEnd = symbols.dynamicEnd();
   for (symbol = symbols.localDynBegin(); symbol != symEnd; ++symbol) {
+    size_t strIdx = getStrtabIdx(*m_pDynStrTab, **symbol, strtab, strtabsize);
     if (config().targets().is32Bits())
-      emitSymbol32(symtab32[symIdx], **symbol, strtab, strtabsize, symIdx);
+      emitSymbol32(symtab32[symIdx], **symbol, strIdx, symIdx);
     else
-      emitSymbol64(symtab64[symIdx], **symbol, strtab, strtabsize, symIdx);
+      emitSymbol64(symtab64[symIdx], **symbol, strIdx, symIdx);
     // maintain output's symbol and index map
     entry = m_pSymIndexMap->insert(*symbol, sym_exist);
     entry->setValue(symIdx);
     // sum up counters
     ++symIdx;
-    if (hasEntryInStrTab(**symbol))
-      strtabsize += (*symbol)->nameSize() + 1;
   }
 
   // emit DT_NEED
-  // add DT_NEED strings into .dynstr
+  // the DT_NEED strings are in .dynstr already
   ELFDynamic::iterator dt_need = dynamic().needBegin();
   Module::const_lib_iterator lib, libEnd = pModule.lib_end();
   for (lib = pModule.lib_begin(); lib != libEnd; ++lib) {
     if (!(*lib)->attribute()->isAsNeeded() || (*lib)->isNeeded()) {
-      strcpy((strtab + strtabsize), (*lib)->name().c_str());
-      (*dt_need)->setValue(llvm::ELF::DT_NEEDED, strtabsize);
-      strtabsize += (*lib)->name().size() + 1;
+      (*dt_need)->setValue(llvm::ELF::DT_NEEDED,
+                           m_pDynStrTab->getOffset((*lib)->name()));
       ++dt_need;
     }
   }
 
   if (!config().options().getRpathList().empty()) {
+    size_t rpath = m_pDynStrTab->getOffset(getRpathString(config().options()));
     if (!config().options().hasNewDTags())
-      (*dt_need)->setValue(llvm::ELF::DT_RPATH, strtabsize);
+      (*dt_need)->setValue(llvm::ELF::DT_RPATH, rpath);
     else
-      (*dt_need)->setValue(llvm::ELF::DT_RUNPATH, strtabsize);
+      (*dt_need)->setValue(llvm::ELF::DT_RUNPATH, rpath);
     ++dt_need;
-
-    GeneralOptions::const_rpath_iterator rpath,
-      rpathEnd = config().options().rpath_end();
-    for (rpath = config().options().rpath_begin(); rpath != rpathEnd; ++rpath) {
-      memcpy((strtab + strtabsize), (*rpath).data(), (*rpath).size());
-      strtabsize += (*rpath).size();
-      strtab[strtabsize++] = (rpath + 1 == rpathEnd ? '\0' : ':');
-    }
   }
 
   // initialize value of ELF .dynamic section
   if (LinkerConfig::DynObj == config().codeGenType()) {
     // set pointer to SONAME entry in dynamic string table.
-    dynamic().applySoname(strtabsize);
+    dynamic().applySoname(m_pDynStrTab->getOffset(config().options().soname()));
   }
   dynamic().applyEntries(*file_format);
   dynamic().emit(dyn_sect, dyn_region);
-
-  // emit soname
-  if (LinkerConfig::DynObj == config().codeGenType()) {
-    strcpy((strtab + strtabsize), config().options().soname().c_str());
-    strtabsize += config().options().soname().size() + 1;
-  }
 }
 
 /// emitELFHashTab - emit .hash
@@ -1241,75 +1267,47 @@ void GNULDBackend::emitGNUHashTab(Module::SymbolTable& pSymtab,
     return;
   }
 
-  uint32_t maskbitslog2 = getGNUHashMaskbitslog2(hashed_sym_cnt);
-  uint32_t maskbits = 1u << maskbitslog2;
-  uint32_t shift1 = config().targets().is32Bits() ? 5 : 6;
-  uint32_t mask = (1u << shift1) - 1;
+  GNUHashTableBuilder builder(getHashBucketCount(hashed_sym_cnt, true),
+                              getGNUHashMaskbitslog2(hashed_sym_cnt),
+                              config().targets().bitclass());
 
-  nbucket   = getHashBucketCount(hashed_sym_cnt, true);
+  nbucket   = builder.numOfBuckets();
   symidx    = 1 + unhashed_sym_cnt;
-  maskwords = 1 << (maskbitslog2 - shift1);
-  shift2    = maskbitslog2;
+  maskwords = builder.numOfMaskWords();
+  shift2    = builder.shift2();
 
   // setup bucket and chain
-  bucket = (uint32_t*)(bitmask + maskbits / 8);
+  bucket = (uint32_t*)(bitmask + maskwords * config().targets().bitclass() / 8);
   chain  = (bucket + nbucket);
 
-  // build the gnu style hash table
-  typedef std::multimap<uint32_t,
-                        std::pair<LDSymbol*, uint32_t> > SymMapType;
-  SymMapType symmap;
-  symEnd = pSymtab.dynamicEnd();
-  for (symbol = pSymtab.localDynBegin() + symidx - 1; symbol != symEnd;
-    ++symbol) {
-    hash::StringHash<hash::DJB> hasher;
-    uint32_t djbhash = hasher((*symbol)->name());
-    uint32_t hash = djbhash % nbucket;
-    symmap.insert(std::make_pair(hash, std::make_pair(*symbol, djbhash)));
-  }
+  // the DJB hash of each name is computed by NamePool when it is inserted
+  Module::sym_iterator hashed_begin = pSymtab.localDynBegin() + symidx - 1;
+  std::vector<LDSymbol*> hashed_syms(hashed_begin, pSymtab.dynamicEnd());
+  std::vector<uint32_t> hashes(hashed_syms.size());
+  for (size_t idx = 0; idx < hashed_syms.size(); ++idx)
+    hashes[idx] = hashed_syms[idx]->resolveInfo()->hash();
 
   // compute bucket, chain, and bitmask
-  std::vector<uint64_t> bitmasks(maskwords);
-  size_t hashedidx = symidx;
-  for (size_t idx = 0; idx < nbucket; ++idx) {
-    size_t count = 0;
-    std::pair<SymMapType::iterator, SymMapType::iterator> ret;
-    ret = symmap.equal_range(idx);
-    for (SymMapType::iterator it = ret.first; it != ret.second; ) {
-      // rearrange the hashed symbol ordering
-      *(pSymtab.localDynBegin() + hashedidx - 1) = it->second.first;
-      uint32_t djbhash = it->second.second;
-      uint32_t val = ((djbhash >> shift1) & ((maskbits >> shift1) - 1));
-      bitmasks[val] |= 1u << (djbhash & mask);
-      bitmasks[val] |= 1u << ((djbhash >> shift2) & mask);
-      val = djbhash & ~1u;
-      // advance the iterator and check if we're dealing w/ the last elment
-      if (++it == ret.second) {
-        // last element terminates the chain
-        val |= 1;
-      }
-      chain[hashedidx - symidx] = val;
+  builder.build(hashes, symidx);
 
-      ++hashedidx;
-      ++count;
-    }
+  // rearrange the hashed symbol ordering
+  for (size_t idx = 0; idx < hashed_syms.size(); ++idx)
+    *(hashed_begin + idx) = hashed_syms[builder.order()[idx]];
 
-    if (count == 0)
-      bucket[idx] = 0;
-    else
-      bucket[idx] = hashedidx - count;
-  }
+  std::memcpy(bucket, &builder.buckets()[0], nbucket * sizeof(uint32_t));
+  std::memcpy(chain, &builder.chains()[0], hashes.size() * sizeof(uint32_t));
 
   // write the bitmasks
+  const std::vector<uint64_t>& bitmasks = builder.bloom();
   if (config().targets().is32Bits()) {
     uint32_t* maskval = (uint32_t*)bitmask;
     for (size_t i = 0; i < maskwords; ++i)
-      std::memcpy(maskval + i, &bitmasks[i], 4);
+      maskval[i] = bitmasks[i];
   } else {
     // must be 64
     uint64_t* maskval = (uint64_t*)bitmask;
     for (size_t i = 0; i < maskwords; ++i)
-      std::memcpy(maskval + i, &bitmasks[i], 8);
+      maskval[i] = bitmasks[i];
   }
 }
 
@@ -1681,6 +1679,10 @@ bool GNULDBackend::updateSectionFlags(LDSection& pTo, const LDSection& pFrom)
   if (0 == (pFrom.flag() & llvm::ELF::SHF_STRINGS))
     flags &= ~llvm::ELF::SHF_STRINGS;
 
+  // the entries of different sizes can not be merged
+  if (pTo.entSize() != pFrom.entSize())
+    flags &= ~(llvm::ELF::SHF_MERGE | llvm::ELF::SHF_STRINGS);
+
   pTo.setFlag(flags);
   return true;
 }
@@ -2580,6 +2582,32 @@ void GNULDBackend::createAndSizeEhFrameHdr(Module& pModule)
   }
 }
 
+void GNULDBackend::createAndSizeBuildID(Module& pModule)
+{
+  if (LinkerConfig::Exec != config().codeGenType() &&
+      LinkerConfig::DynObj != config().codeGenType())
+    return;
+  if (!config().options().hasBuildID())
+    return;
+
+  // the notes of the inputs have been merged into the output section
+  LDSection& note = getOutputFormat()->getNoteGNUBuildID();
+  if (note.hasSectionData())
+    return;
+
+  m_pBuildID = new BuildID(note,
+                           config().options().getBuildIDStyle(),
+                           config().options().getBuildIDValue());
+  m_pBuildID->sizeOutput();
+}
+
+void GNULDBackend::emitBuildID(FileOutputBuffer& pOutput,
+                               ThreadPool& pThreadPool)
+{
+  if (NULL != m_pBuildID)
+    m_pBuildID->emitOutput(pOutput, pThreadPool);
+}
+
 /// preLayout - Backend can do any needed modification before layout
 void GNULDBackend::preLayout(Module& pModule, IRBuilder& pBuilder)
 {
@@ -3003,13 +3031,62 @@ void GNULDBackend::sortRelocation(LDSection& pSection)
     if (&pSection == &getOutputFormat()->getRelDyn() ||
         &pSection == &getOutputFormat()->getRelaDyn()) {
       if (pSection.hasRelocData())
-        pSection.getRelocData()->sort(RelocCompare(*this));
+        sortDynRelocs(*pSection.getRelocData());
     }
   default:
     return;
   }
 }
 
+/// sortDynRelocs - sort the dynamic relocations by their keys
+void GNULDBackend::sortDynRelocs(RelocData& pRelocData) const
+{
+  std::vector<RelocKey> keys;
+  keys.reserve(pRelocData.size());
+  RelocData::iterator it, itEnd = pRelocData.end();
+  for (it = pRelocData.begin(); it != itEnd; ++it) {
+    Relocation* reloc = &(*it);
+    RelocKey key;
+    if (NULL == reloc->symInfo())
+      key.symIdx = 0;
+    else
+      key.symIdx = getSymbolIdx(reloc->symInfo()->outSymbol()) + 1;
+    key.place = reloc->place();
+    key.type = reloc->type();
+    key.addend = reloc->addend();
+    key.reloc = reloc;
+    keys.push_back(key);
+  }
+
+  // keep the equal relocations in order, as the list sort did
+  std::stable_sort(keys.begin(), keys.end());
+
+  std::vector<Relocation*> relocs(keys.size());
+  for (size_t idx = 0; idx < keys.size(); ++idx)
+    relocs[idx] = keys[idx].reloc;
+  pRelocData.reorder(relocs);
+}
+
+/// isFilledByRelocator - the relocator fills up the GOT entries and the
+/// dynamic relocation entries
+bool GNULDBackend::isFilledByRelocator(const LDSection& pSection) const
+{
+  switch (config().codeGenType()) {
+  case LinkerConfig::DynObj:
+  case LinkerConfig::Exec:
+  case LinkerConfig::Binary: {
+    const ELFFileFormat* file_format = getOutputFormat();
+    return ((file_format->hasGOT() && &pSection == &file_format->getGOT()) ||
+            (file_format->hasRelDyn() &&
+             &pSection == &file_format->getRelDyn()) ||
+            (file_format->hasRelaDyn() &&
+             &pSection == &file_format->getRelaDyn()));
+  }
+  default:
+    return false;
+  }
+}
+
 /// initBRIslandFactory - initialize the branch island factory for relaxation
 bool GNULDBackend::initBRIslandFactory()
 {
@@ -3059,42 +3136,20 @@ bool GNULDBackend::DynsymCompare::operator()(const LDSymbol* X,
   return !needGNUHash(*X) && needGNUHash(*Y);
 }
 
-bool GNULDBackend::RelocCompare::operator()(const Relocation* X,
-                                            const Relocation* Y) const
+bool GNULDBackend::RelocKey::operator<(const RelocKey& pOther) const
 {
-  // 1. compare if relocation is relative
-  if (X->symInfo() == NULL) {
-    if (Y->symInfo() != NULL)
-      return true;
-  } else if (Y->symInfo() == NULL) {
-    return false;
-  } else {
-    // 2. compare the symbol index
-    size_t symIdxX = m_Backend.getSymbolIdx(X->symInfo()->outSymbol());
-    size_t symIdxY = m_Backend.getSymbolIdx(Y->symInfo()->outSymbol());
-    if (symIdxX < symIdxY)
-      return true;
-    if (symIdxX > symIdxY)
-      return false;
-  }
+  // 1. the relative relocations go first, and then compare the symbol index
+  if (symIdx != pOther.symIdx)
+    return symIdx < pOther.symIdx;
 
-  // 3. compare the relocation address
-  if (X->place() < Y->place())
-    return true;
-  if (X->place() > Y->place())
-    return false;
-
-  // 4. compare the relocation type
-  if (X->type() < Y->type())
-    return true;
-  if (X->type() > Y->type())
-    return false;
+  // 2. compare the relocation address
+  if (place != pOther.place)
+    return place < pOther.place;
 
-  // 5. compare the addend
-  if (X->addend() < Y->addend())
-    return true;
-  if (X->addend() > Y->addend())
-    return false;
+  // 3. compare the relocation type
+  if (type != pOther.type)
+    return type < pOther.type;
 
-  return false;
+  // 4. compare the addend
+  return addend < pOther.addend;
 }
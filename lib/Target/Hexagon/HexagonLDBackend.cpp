@@ -20,6 +20,7 @@
 #include <mcld/IRBuilder.h>
 #include <mcld/Fragment/AlignFragment.h>
 #include <mcld/Fragment/FillFragment.h>
+#include <mcld/Fragment/MergedFragment.h>
 #include <mcld/Fragment/RegionFragment.h>
 #include <mcld/Support/MemoryArea.h>
 #include <mcld/Support/MsgHandling.h>
@@ -216,6 +217,12 @@ uint64_t HexagonLDBackend::emitSectionData(const LDSection& pSection,
         } // end switch
         break;
       }
+      case Fragment::Merged: {
+        const MergedFragment& merged_frag =
+          llvm::cast<MergedFragment>(*frag_iter);
+        merged_frag.emit(out_offset);
+        break;
+      }
       case Fragment::Null: {
         assert(0x0 == size);
         break;
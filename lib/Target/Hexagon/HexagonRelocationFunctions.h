@@ -35,6 +35,7 @@ T1 ApplyMask(T2 pMask, T1 pData) {
 
 #define DECL_HEXAGON_APPLY_RELOC_FUNC(Name) \
 static HexagonRelocator::Result Name    (Relocation& pEntry, \
+                                     HexagonRelocator::DWord& pTarget, \
                                      HexagonRelocator& pParent);
 
 #define DECL_HEXAGON_APPLY_RELOC_FUNCS \
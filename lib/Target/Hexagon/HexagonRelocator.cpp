@@ -126,6 +126,7 @@ DECL_HEXAGON_APPLY_RELOC_FUNCS
 
 /// the prototype of applying function
 typedef Relocator::Result (*ApplyFunctionType)(Relocation &pReloc,
+                                               Relocator::DWord &pTarget,
                                                HexagonRelocator &pParent);
 
 // the table entry of applying functions
@@ -171,7 +172,8 @@ HexagonRelocator::HexagonRelocator(HexagonLDBackend &pParent,
 
 HexagonRelocator::~HexagonRelocator() {}
 
-Relocator::Result HexagonRelocator::applyRelocation(Relocation &pRelocation) {
+Relocator::Result HexagonRelocator::applyRelocation(Relocation &pRelocation,
+                                                    DWord &pTarget) {
   Relocation::Type type = pRelocation.type();
 
   if (type > 85) { // 86-255 relocs do not exists for Hexagon
@@ -179,7 +181,7 @@ Relocator::Result HexagonRelocator::applyRelocation(Relocation &pRelocation) {
   }
 
   // apply the relocation
-  return ApplyFunctions[type].func(pRelocation, *this);
+  return ApplyFunctions[type].func(pRelocation, pTarget, *this);
 }
 
 const char *HexagonRelocator::getName(Relocation::Type pType) const {
@@ -480,14 +482,15 @@ void HexagonRelocator::partialScanRelocation(Relocation &pReloc,
 //=========================================//
 
 // R_HEX_NONE
-Relocator::Result none(Relocation &pReloc, HexagonRelocator &pParent) {
+Relocator::Result none(Relocation &pReloc, Relocator::DWord &pTarget,
+                       HexagonRelocator &pParent) {
   return Relocator::OK;
 }
 
 //R_HEX_32 and its class of relocations use only addend and symbol value
 // S + A : result is unsigned truncate.
 // Exception: R_HEX_32_6_X : unsigned verify
-Relocator::Result applyAbs(Relocation &pReloc) {
+Relocator::Result applyAbs(Relocation &pReloc, Relocator::DWord &pTarget) {
   Relocator::Address S = pReloc.symValue();
   Relocator::DWord A = pReloc.addend();
   uint32_t result = (uint32_t)(S + A);
@@ -537,7 +540,7 @@ Relocator::Result applyAbs(Relocation &pReloc) {
   case llvm::ELF::R_HEX_8_X:
   case llvm::ELF::R_HEX_7_X:
   case llvm::ELF::R_HEX_6_X:
-    bitMask = FINDBITMASK(pReloc.target());
+    bitMask = FINDBITMASK(pTarget);
     break;
 
   default:
@@ -558,7 +561,7 @@ Relocator::Result applyAbs(Relocation &pReloc) {
       return Relocator::Overflow;
   }
 
-  pReloc.target() |= ApplyMask<uint32_t>(bitMask, result);
+  pTarget |= ApplyMask<uint32_t>(bitMask, result);
   return Relocator::OK;
 }
 
@@ -566,7 +569,8 @@ Relocator::Result applyAbs(Relocation &pReloc) {
 // S + A - P : result is signed verify.
 // Exception: R_HEX_B32_PCREL_X : signed truncate
 // Another Exception: R_HEX_6_PCREL_X is unsigned truncate
-Relocator::Result applyRel(Relocation &pReloc, int64_t pResult) {
+Relocator::Result applyRel(Relocation &pReloc, Relocator::DWord &pTarget,
+                           int64_t pResult) {
   uint32_t bitMask = 0;
   uint32_t effectiveBits = 0;
   uint32_t alignment = 1;
@@ -651,9 +655,9 @@ Relocator::Result applyRel(Relocation &pReloc, int64_t pResult) {
 
   case llvm::ELF::R_HEX_6_PCREL_X:
     // This is unique since it has a unsigned operand and its truncated
-    bitMask = FINDBITMASK(pReloc.target());
+    bitMask = FINDBITMASK(pTarget);
     result = pReloc.addend() + pReloc.symValue() - pReloc.place();
-    pReloc.target() |= ApplyMask<uint32_t>(bitMask, result);
+    pTarget |= ApplyMask<uint32_t>(bitMask, result);
     return Relocator::OK;
 
   default:
@@ -673,11 +677,12 @@ Relocator::Result applyRel(Relocation &pReloc, int64_t pResult) {
       return Relocator::Overflow;
   }
 
-  pReloc.target() |= (uint32_t) ApplyMask<int32_t>(bitMask, pResult);
+  pTarget |= (uint32_t) ApplyMask<int32_t>(bitMask, pResult);
   return Relocator::OK;
 }
 
-Relocator::Result relocAbs(Relocation &pReloc, HexagonRelocator &pParent) {
+Relocator::Result relocAbs(Relocation &pReloc, Relocator::DWord &pTarget,
+                           HexagonRelocator &pParent) {
   ResolveInfo *rsym = pReloc.symInfo();
   Relocator::Address S = pReloc.symValue();
   Relocator::DWord A = pReloc.addend();
@@ -689,7 +694,7 @@ Relocator::Result relocAbs(Relocation &pReloc, HexagonRelocator &pParent) {
   // relocation.
   if (0 == (llvm::ELF::SHF_ALLOC &
             pReloc.targetRef().frag()->getParent()->getSection().flag())) {
-    return applyAbs(pReloc);
+    return applyAbs(pReloc, pTarget);
   }
 
   // a local symbol with .rela type relocation
@@ -714,10 +719,11 @@ Relocator::Result relocAbs(Relocation &pReloc, HexagonRelocator &pParent) {
     }
   }
 
-  return applyAbs(pReloc);
+  return applyAbs(pReloc, pTarget);
 }
 
-Relocator::Result relocPCREL(Relocation &pReloc, HexagonRelocator &pParent) {
+Relocator::Result relocPCREL(Relocation &pReloc, Relocator::DWord &pTarget,
+                             HexagonRelocator &pParent) {
   ResolveInfo *rsym = pReloc.symInfo();
   int64_t result;
 
@@ -733,23 +739,24 @@ Relocator::Result relocPCREL(Relocation &pReloc, HexagonRelocator &pParent) {
 
   // for relocs inside non ALLOC, just apply
   if (0 == (llvm::ELF::SHF_ALLOC & target_sect.flag())) {
-    return applyRel(pReloc, result);
+    return applyRel(pReloc, pTarget, result);
   }
 
   if (!rsym->isLocal()) {
     if (rsym->reserved() & HexagonRelocator::ReservePLT) {
       S = helper_get_PLT_address(*rsym, pParent);
       result = (int64_t)(S + A - P);
-      applyRel(pReloc, result);
+      applyRel(pReloc, pTarget, result);
       return Relocator::OK;
     }
   }
 
-  return applyRel(pReloc, result);
+  return applyRel(pReloc, pTarget, result);
 }
 
 // R_HEX_GPREL16_0 and its class : Unsigned Verify
-Relocator::Result relocGPREL(Relocation &pReloc, HexagonRelocator &pParent) {
+Relocator::Result relocGPREL(Relocation &pReloc, Relocator::DWord &pTarget,
+                             HexagonRelocator &pParent) {
   Relocator::Address S = pReloc.symValue();
   Relocator::DWord A = pReloc.addend();
   Relocator::DWord GP = pParent.getTarget().getGP();
@@ -784,7 +791,7 @@ Relocator::Result relocGPREL(Relocation &pReloc, HexagonRelocator &pParent) {
   }
 
   uint32_t range = 1 << 16;
-  uint32_t bitMask = FINDBITMASK(pReloc.target());
+  uint32_t bitMask = FINDBITMASK(pTarget);
 
   if ((shift != 0) && (result % alignment != 0))
     return Relocator::BadReloc;
@@ -792,7 +799,7 @@ Relocator::Result relocGPREL(Relocation &pReloc, HexagonRelocator &pParent) {
   result >>= shift;
 
   if (result < range - 1) {
-    pReloc.target() |= ApplyMask<uint32_t>(bitMask, result);
+    pTarget |= ApplyMask<uint32_t>(bitMask, result);
     return Relocator::OK;
   }
   return Relocator::Overflow;
@@ -800,6 +807,7 @@ Relocator::Result relocGPREL(Relocation &pReloc, HexagonRelocator &pParent) {
 
 // R_HEX_PLT_B22_PCREL: PLT(S) + A - P
 Relocator::Result relocPLTB22PCREL(Relocation &pReloc,
+                                   Relocator::DWord &pTarget,
                                    HexagonRelocator &pParent) {
   // PLT_S depends on if there is a PLT entry.
   Relocator::Address PLT_S;
@@ -808,16 +816,17 @@ Relocator::Result relocPLTB22PCREL(Relocation &pReloc,
   else
     PLT_S = pReloc.symValue();
   Relocator::Address P = pReloc.place();
-  uint32_t bitMask = FINDBITMASK(pReloc.target());
+  uint32_t bitMask = FINDBITMASK(pTarget);
   uint32_t result = (PLT_S + pReloc.addend() - P) >> 2;
-  pReloc.target() = pReloc.target() | ApplyMask<uint32_t>(bitMask, result);
+  pTarget = pTarget | ApplyMask<uint32_t>(bitMask, result);
   return Relocator::OK;
 }
 
 //R_HEX_GOT_LO16 and its class : (G) Signed Truncate
 //Exception: R_HEX_GOT_16(_X): signed verify
 // Exception: R_HEX_GOT_11_X : unsigned truncate
-Relocator::Result relocGOT(Relocation &pReloc, HexagonRelocator &pParent) {
+Relocator::Result relocGOT(Relocation &pReloc, Relocator::DWord &pTarget,
+                           HexagonRelocator &pParent) {
   if (!(pReloc.symInfo()->reserved() & HexagonRelocator::ReserveGOT)) {
     return Relocator::BadReloc;
   }
@@ -825,8 +834,11 @@ Relocator::Result relocGOT(Relocation &pReloc, HexagonRelocator &pParent) {
   // set got entry value if needed
   HexagonGOTEntry *got_entry = pParent.getSymGOTMap().lookUp(*pReloc.symInfo());
   assert(NULL != got_entry);
-  if (HexagonRelocator::SymVal == got_entry->getValue())
-    got_entry->setValue(pReloc.symValue());
+  {
+    llvm::sys::ScopedLock lock(pParent.getEntryLock());
+    if (HexagonRelocator::SymVal == got_entry->getValue())
+      got_entry->setValue(pReloc.symValue());
+  }
 
   Relocator::Address GOT_S =
                              helper_get_GOT_address(*pReloc.symInfo(), pParent);
@@ -854,7 +866,7 @@ Relocator::Result relocGOT(Relocation &pReloc, HexagonRelocator &pParent) {
     break;
 
   case llvm::ELF::R_HEX_GOT_16:
-    bitMask = FINDBITMASK(pReloc.target());
+    bitMask = FINDBITMASK(pTarget);
     effectiveBits = 16;
     break;
 
@@ -864,14 +876,14 @@ Relocator::Result relocGOT(Relocation &pReloc, HexagonRelocator &pParent) {
     break;
 
   case llvm::ELF::R_HEX_GOT_16_X:
-    bitMask = FINDBITMASK(pReloc.target());
+    bitMask = FINDBITMASK(pTarget);
     effectiveBits = 6;
     break;
 
   case llvm::ELF::R_HEX_GOT_11_X:
-    bitMask = FINDBITMASK(pReloc.target());
+    bitMask = FINDBITMASK(pTarget);
     result_u = GOT_S - GOT;
-    pReloc.target() |= ApplyMask<uint32_t>(bitMask, result_u);
+    pTarget |= ApplyMask<uint32_t>(bitMask, result_u);
     return Relocator::OK;
 
   default:
@@ -890,13 +902,14 @@ Relocator::Result relocGOT(Relocation &pReloc, HexagonRelocator &pParent) {
     if ((result > range - 1) || (result < -range))
       return Relocator::Overflow;
   }
-  pReloc.target() |= ApplyMask<int32_t>(bitMask, result);
+  pTarget |= ApplyMask<int32_t>(bitMask, result);
   return Relocator::OK;
 }
 
 // R_HEX_GOTREL_LO16: and its class of relocs
 // (S + A - GOT) : Signed Truncate
-Relocator::Result relocGOTREL(Relocation &pReloc, HexagonRelocator &pParent) {
+Relocator::Result relocGOTREL(Relocation &pReloc, Relocator::DWord &pTarget,
+                              HexagonRelocator &pParent) {
   Relocator::Address S = pReloc.symValue();
   Relocator::DWord A = pReloc.addend();
   Relocator::Address GOT = pParent.getTarget().getGOTSymbolAddr();
@@ -929,7 +942,7 @@ Relocator::Result relocGOTREL(Relocation &pReloc, HexagonRelocator &pParent) {
 
   case llvm::ELF::R_HEX_GOTREL_16_X:
   case llvm::ELF::R_HEX_GOTREL_11_X:
-    bitMask = FINDBITMASK(pReloc.target());
+    bitMask = FINDBITMASK(pTarget);
     break;
 
   default:
@@ -943,10 +956,11 @@ Relocator::Result relocGOTREL(Relocation &pReloc, HexagonRelocator &pParent) {
 
   result >>= shift;
 
-  pReloc.target() |= ApplyMask<uint32_t>(bitMask, result);
+  pTarget |= ApplyMask<uint32_t>(bitMask, result);
   return Relocator::OK;
 }
 
-Relocator::Result unsupport(Relocation &pReloc, HexagonRelocator &pParent) {
+Relocator::Result unsupport(Relocation &pReloc, Relocator::DWord &pTarget,
+                            HexagonRelocator &pParent) {
   return Relocator::Unsupport;
 }
@@ -74,7 +74,11 @@ public:
   HexagonRelocator(HexagonLDBackend& pParent, const LinkerConfig& pConfig);
   ~HexagonRelocator();
 
-  Result applyRelocation(Relocation& pRelocation);
+  Result applyRelocation(Relocation& pRelocation, DWord& pTarget);
+
+  /// isApplyThreadSafe - relocations of different inputs can be applied
+  /// concurrently
+  bool isApplyThreadSafe() const { return true; }
 
   /// scanRelocation - determine the empty entries are needed or not and create
   /// the empty entries if needed.
@@ -269,6 +269,15 @@ uint64_t MipsGNULDBackend::emitSectionData(const LDSection& pSection,
   return 0;
 }
 
+bool MipsGNULDBackend::isFilledByRelocator(const LDSection& pSection) const
+{
+  const ELFFileFormat* file_format = getOutputFormat();
+  if (LinkerConfig::Object != config().codeGenType() &&
+      file_format->hasRelPlt() && &pSection == &file_format->getRelPlt())
+    return true;
+  return GNULDBackend::isFilledByRelocator(pSection);
+}
+
 bool MipsGNULDBackend::hasEntryInStrTab(const LDSymbol& pSym) const
 {
   return ResolveInfo::Section != pSym.type() ||
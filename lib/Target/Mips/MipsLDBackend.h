@@ -83,6 +83,10 @@ public:
   /// hasEntryInStrTab - symbol has an entry in a .strtab
   bool hasEntryInStrTab(const LDSymbol& pSym) const;
 
+  /// isFilledByRelocator - the .rel.plt entries are also filled up while
+  /// applying relocations (@see MipsRelocator::getPLTAddress)
+  bool isFilledByRelocator(const LDSection& pSection) const;
+
   /// orderSymbolTable - order symbol table before emitting
   void orderSymbolTable(Module& pModule);
 
@@ -136,8 +140,7 @@ private:
   /// emitSymbol32 - emit an ELF32 symbol, override parent's function
   void emitSymbol32(llvm::ELF::Elf32_Sym& pSym32,
                     LDSymbol& pSymbol,
-                    char* pStrtab,
-                    size_t pStrtabsize,
+                    size_t pStrtabIdx,
                     size_t pSymtabIdx);
 
   /// doCreateProgramHdrs - backend can implement this function to create the
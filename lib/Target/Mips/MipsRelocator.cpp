@@ -55,16 +55,18 @@ public:
     return false;
   }
 
-  MipsRelocationInfo(Relocation& pParent, bool pIsRel)
+  MipsRelocationInfo(Relocation& pParent, Relocation::DWord pTarget,
+                     bool pIsRel)
     : m_Parent(&pParent),
       m_Type(pParent.type()),
+      m_Target(pTarget),
       m_Addend(0),
       m_Symbol(pParent.symValue()),
-      m_Result(pParent.target())
+      m_Result(pTarget)
   {
     if (pIsRel && (type() < llvm::ELF::R_MIPS_LA25_LUI ||
                    type() > llvm::ELF::R_MIPS_LA25_ADD))
-      m_Addend = pParent.target();
+      m_Addend = pTarget;
     else
       m_Addend = pParent.addend();
   }
@@ -81,7 +83,8 @@ public:
 
   MipsRelocationInfo next() const
   {
-    return MipsRelocationInfo(*m_Parent, m_Type >> 8, result(), result(), 0);
+    return MipsRelocationInfo(*m_Parent, m_Type >> 8, m_Target,
+                              result(), result(), 0);
   }
 
   const Relocation& parent() const
@@ -99,6 +102,12 @@ public:
     return m_Type & 0xff;
   }
 
+  /// target - the data at the place of the relocation
+  Relocation::DWord target() const
+  {
+    return m_Target;
+  }
+
   Relocation::DWord A() const
   {
     return m_Addend;
@@ -127,15 +136,17 @@ public:
 private:
   Relocation* m_Parent;
   Relocation::Type m_Type;
+  Relocation::DWord m_Target;
   Relocation::DWord m_Addend;
   Relocation::DWord m_Symbol;
   Relocation::DWord m_Result;
 
   MipsRelocationInfo(Relocation& pParent, Relocation::Type pType,
-                     Relocation::DWord pResult,
+                     Relocation::DWord pTarget, Relocation::DWord pResult,
                      Relocation::DWord pAddend, Relocation::DWord pSymbol)
     : m_Parent(&pParent),
       m_Type(pType),
+      m_Target(pTarget),
       m_Addend(pAddend),
       m_Symbol(pSymbol),
       m_Result(pResult)
@@ -183,7 +194,7 @@ MipsRelocator::MipsRelocator(MipsGNULDBackend& pParent,
 }
 
 Relocator::Result
-MipsRelocator::applyRelocation(Relocation& pReloc)
+MipsRelocator::applyRelocation(Relocation& pReloc, DWord& pTarget)
 {
   // If m_CurrentLo16Reloc is not NULL we are processing
   // postponed relocation. Otherwise check relocation type
@@ -193,7 +204,7 @@ MipsRelocator::applyRelocation(Relocation& pReloc)
     return OK;
   }
 
-  for (MipsRelocationInfo info(pReloc, isRel());
+  for (MipsRelocationInfo info(pReloc, pTarget, isRel());
        !info.isNone(); info = info.next()) {
     if (info.type() >= sizeof(ApplyFunctions) / sizeof(ApplyFunctions[0]))
       return Unknown;
@@ -206,8 +217,8 @@ MipsRelocator::applyRelocation(Relocation& pReloc)
 
     if (info.isLast()) {
       uint64_t mask = 0xFFFFFFFFFFFFFFFFULL >> (64 - triple.size);
-      pReloc.target() &= ~mask;
-      pReloc.target() |= info.result() & mask;
+      pTarget &= ~mask;
+      pTarget |= info.result() & mask;
     }
   }
 
@@ -243,7 +254,7 @@ void MipsRelocator::scanRelocation(Relocation& pReloc,
   if (0 == (pSection.getLink()->flag() & llvm::ELF::SHF_ALLOC))
     return;
 
-  for (MipsRelocationInfo info(pReloc, isRel());
+  for (MipsRelocationInfo info(pReloc, readTarget(pReloc), isRel());
        !info.isNone(); info = info.next()) {
     // We test isLocal or if pInputSym is not a dynamic symbol
     // We assume -Bsymbolic to bind all symbols internaly via !rsym->isDyn()
@@ -835,7 +846,7 @@ MipsRelocator::Result rel26(MipsRelocationInfo& pReloc, MipsRelocator& pParent)
 {
   ResolveInfo* rsym = pReloc.parent().symInfo();
 
-  int32_t A = ((pReloc.parent().target() & 0x03FFFFFF) << 2);
+  int32_t A = ((pReloc.target() & 0x03FFFFFF) << 2);
   int32_t P = pReloc.P();
   int32_t S = rsym->reserved() & MipsRelocator::ReservePLT
                   ? pParent.getPLTAddress(*rsym)
@@ -62,7 +62,7 @@ public:
   /// @return - return true for finalization success
   bool finalizeApply(Input& pInput);
 
-  Result applyRelocation(Relocation& pReloc);
+  Result applyRelocation(Relocation& pReloc, DWord& pTarget);
 
   const Input& getApplyingInput() const
   { return *m_pApplyingInput; }
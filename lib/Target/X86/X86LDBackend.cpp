@@ -394,6 +394,11 @@ void X86_32GNULDBackend::initTargetSections(Module& pModule,
   }
 }
 
+bool X86_32GNULDBackend::isCallRelocation(uint32_t pType) const
+{
+  return (llvm::ELF::R_386_PLT32 == pType);
+}
+
 X86_32GOT& X86_32GNULDBackend::getGOT()
 {
   assert(NULL != m_pGOT);
@@ -564,6 +569,11 @@ bool X86_64GNULDBackend::initRelocator()
   return true;
 }
 
+bool X86_64GNULDBackend::isCallRelocation(uint32_t pType) const
+{
+  return (llvm::ELF::R_X86_64_PLT32 == pType);
+}
+
 X86_64GOT& X86_64GNULDBackend::getGOT()
 {
   assert(NULL != m_pGOT);
@@ -166,6 +166,9 @@ public:
 
   void initTargetSections(Module& pModule, ObjectBuilder& pBuilder);
 
+  /// isCallRelocation - the PLT32 relocations of calls and jumps
+  bool isCallRelocation(uint32_t pType) const;
+
   X86_32GOT& getGOT();
 
   const X86_32GOT& getGOT() const;
@@ -209,6 +212,9 @@ public:
 
   void initTargetSections(Module& pModule, ObjectBuilder& pBuilder);
 
+  /// isCallRelocation - the PLT32 relocations of calls and jumps
+  bool isCallRelocation(uint32_t pType) const;
+
   X86_64GOT& getGOT();
 
   const X86_64GOT& getGOT() const;
@@ -8,7 +8,9 @@
 //===----------------------------------------------------------------------===//
 
 #define DECL_X86_32_APPLY_RELOC_FUNC(Name) \
-static X86Relocator::Result Name(Relocation& pEntry, X86_32Relocator& pParent);
+static X86Relocator::Result Name(Relocation& pEntry, \
+                                 X86Relocator::DWord& pTarget, \
+                                 X86_32Relocator& pParent);
 
 #define DECL_X86_32_APPLY_RELOC_FUNCS \
 DECL_X86_32_APPLY_RELOC_FUNC(none)             \
@@ -24,6 +26,7 @@ DECL_X86_32_APPLY_RELOC_FUNC(tls_gotie)        \
 DECL_X86_32_APPLY_RELOC_FUNC(tls_le)           \
 DECL_X86_32_APPLY_RELOC_FUNC(tls_ldm)          \
 DECL_X86_32_APPLY_RELOC_FUNC(tls_ldo_32)       \
+DECL_X86_32_APPLY_RELOC_FUNC(tls_opt)          \
 DECL_X86_32_APPLY_RELOC_FUNC(unsupport)
 
 
@@ -72,10 +75,12 @@ DECL_X86_32_APPLY_RELOC_FUNC(unsupport)
   { &unsupport,         41, "R_386_TLS_DESC",         0  },  \
   { &unsupport,         42, "R_386_IRELATIVE",        0  },  \
   { &unsupport,         43, "R_386_NUM",              0  },  \
-  { &none,              44, "R_386_TLS_OPT",          32 }
+  { &tls_opt,           44, "R_386_TLS_OPT",          32 }
 
 #define DECL_X86_64_APPLY_RELOC_FUNC(Name) \
-static X86Relocator::Result Name(Relocation& pEntry, X86_64Relocator& pParent);
+static X86Relocator::Result Name(Relocation& pEntry, \
+                                 X86Relocator::DWord& pTarget, \
+                                 X86_64Relocator& pParent);
 
 #define DECL_X86_64_APPLY_RELOC_FUNCS \
 DECL_X86_64_APPLY_RELOC_FUNC(none)             \
@@ -150,6 +150,7 @@ DECL_X86_32_APPLY_RELOC_FUNCS
 
 /// the prototype of applying function
 typedef Relocator::Result (*X86_32ApplyFunctionType)(Relocation& pReloc,
+                                                     Relocator::DWord& pTarget,
                                                      X86_32Relocator& pParent);
 
 // the table entry of applying functions
@@ -301,7 +302,7 @@ X86_32Relocator::X86_32Relocator(X86_32GNULDBackend& pParent,
 }
 
 Relocator::Result
-X86_32Relocator::applyRelocation(Relocation& pRelocation)
+X86_32Relocator::applyRelocation(Relocation& pRelocation, DWord& pTarget)
 {
   Relocation::Type type = pRelocation.type();
 
@@ -310,7 +311,7 @@ X86_32Relocator::applyRelocation(Relocation& pRelocation)
   }
 
   // apply the relocation
-  return X86_32ApplyFunctions[type].func(pRelocation, *this);
+  return X86_32ApplyFunctions[type].func(pRelocation, pTarget, *this);
 }
 
 const char* X86_32Relocator::getName(Relocation::Type pType) const
@@ -811,33 +812,17 @@ void X86_32Relocator::convertTLSIEtoLE(Relocation& pReloc,
   // FIXME: should we create a special symbol for the tls opt instead?
   reloc->setSymInfo(pReloc.symInfo());
 
-  // 2. modify the opcodes to the appropriate ones
-  uint8_t* op =  (reinterpret_cast<uint8_t*>(&reloc->target()));
-  if (op[0] == 0xa1) {
-    op[0] = 0xb8;
-  } else {
+  // 2. find the opcodes to modify. R_386_TLS_OPT rewrites them when it is
+  // applied.
+  Relocator::DWord target = readTarget(*reloc);
+  uint8_t* op = reinterpret_cast<uint8_t*>(&target);
+  if (op[0] != 0xa1) {
     // create the new reloc (move 1 byte forward).
     reloc = Relocation::Create(X86_32Relocator::R_386_TLS_OPT,
                                *FragmentRef::Create(*pReloc.targetRef().frag(),
                                    pReloc.targetRef().offset() - 2),
                                0x0);
     reloc->setSymInfo(pReloc.symInfo());
-    op = (reinterpret_cast<uint8_t*>(&reloc->target()));
-    switch (op[0]) {
-      case 0x8b:
-        assert((op[1] & 0xc7) == 0x05);
-        op[0] = 0xc7;
-        op[1] = 0xc0 | ((op[1] >> 3) & 7);
-        break;
-      case 0x03:
-        assert((op[1] & 0xc7) == 0x05);
-        op[0] = 0x81;
-        op[1] = 0xc0 | ((op[1] >> 3) & 7);
-        break;
-      default:
-        assert(0);
-        break;
-    }
   }
 
   // 3. insert the new relocs "BEFORE" the original reloc.
@@ -854,7 +839,8 @@ void X86_32Relocator::convertTLSIEtoLE(Relocation& pReloc,
 //================================================//
 
 // R_386_NONE
-Relocator::Result none(Relocation& pReloc, X86_32Relocator& pParent)
+Relocator::Result none(Relocation& pReloc, Relocator::DWord& pTarget,
+                       X86_32Relocator& pParent)
 {
   return Relocator::OK;
 }
@@ -862,10 +848,11 @@ Relocator::Result none(Relocation& pReloc, X86_32Relocator& pParent)
 // R_386_32: S + A
 // R_386_16
 // R_386_8
-Relocator::Result abs(Relocation& pReloc, X86_32Relocator& pParent)
+Relocator::Result abs(Relocation& pReloc, Relocator::DWord& pTarget,
+                      X86_32Relocator& pParent)
 {
   ResolveInfo* rsym = pReloc.symInfo();
-  Relocator::DWord A = pReloc.target() + pReloc.addend();
+  Relocator::DWord A = pTarget + pReloc.addend();
   Relocator::DWord S = pReloc.symValue();
   bool has_dyn_rel = pParent.getTarget().symbolNeedsDynRel(
                                   *rsym,
@@ -877,7 +864,7 @@ Relocator::Result abs(Relocation& pReloc, X86_32Relocator& pParent)
   // If the flag of target section is not ALLOC, we will not scan this relocation
   // but perform static relocation. (e.g., applying .debug section)
   if (0x0 == (llvm::ELF::SHF_ALLOC & target_sect.flag())) {
-    pReloc.target() = S + A;
+    pTarget = S + A;
     return Relocator::OK;
   }
 
@@ -896,17 +883,18 @@ Relocator::Result abs(Relocation& pReloc, X86_32Relocator& pParent)
   }
 
   // perform static relocation
-  pReloc.target() = S + A;
+  pTarget = S + A;
   return Relocator::OK;
 }
 
 // R_386_PC32: S + A - P
 // R_386_PC16
 // R_386_PC8
-Relocator::Result rel(Relocation& pReloc, X86_32Relocator& pParent)
+Relocator::Result rel(Relocation& pReloc, Relocator::DWord& pTarget,
+                      X86_32Relocator& pParent)
 {
   ResolveInfo* rsym = pReloc.symInfo();
-  Relocator::DWord A = pReloc.target() + pReloc.addend();
+  Relocator::DWord A = pTarget + pReloc.addend();
   Relocator::DWord S = pReloc.symValue();
   Relocator::DWord P = pReloc.place();
   bool has_dyn_rel = pParent.getTarget().symbolNeedsDynRel(
@@ -918,7 +906,7 @@ Relocator::Result rel(Relocation& pReloc, X86_32Relocator& pParent)
   // If the flag of target section is not ALLOC, we will not scan this relocation
   // but perform static relocation. (e.g., applying .debug section)
   if (0x0 == (llvm::ELF::SHF_ALLOC & target_sect.flag())) {
-    pReloc.target() = S + A - P;
+    pTarget = S + A - P;
     return Relocator::OK;
   }
 
@@ -926,7 +914,7 @@ Relocator::Result rel(Relocation& pReloc, X86_32Relocator& pParent)
   if (!rsym->isLocal()) {
     if (rsym->reserved() & X86Relocator::ReservePLT) {
       S = helper_get_PLT_address(*rsym, pParent);
-      pReloc.target() = S + A - P;
+      pTarget = S + A - P;
     }
     if (has_dyn_rel)
       if (!helper_use_relative_reloc(*rsym, pParent))
@@ -934,33 +922,36 @@ Relocator::Result rel(Relocation& pReloc, X86_32Relocator& pParent)
   }
 
    // perform static relocation
-  pReloc.target() = S + A - P;
+  pTarget = S + A - P;
   return Relocator::OK;
 }
 
 // R_386_GOTOFF: S + A - GOT_ORG
-Relocator::Result gotoff32(Relocation& pReloc, X86_32Relocator& pParent)
+Relocator::Result gotoff32(Relocation& pReloc, Relocator::DWord& pTarget,
+                           X86_32Relocator& pParent)
 {
-  Relocator::DWord      A = pReloc.target() + pReloc.addend();
+  Relocator::DWord      A = pTarget + pReloc.addend();
   Relocator::Address GOT_ORG = helper_GOT_ORG(pParent);
   Relocator::Address S = pReloc.symValue();
 
-  pReloc.target() = S + A - GOT_ORG;
+  pTarget = S + A - GOT_ORG;
   return Relocator::OK;
 }
 
 // R_386_GOTPC: GOT_ORG + A - P
-Relocator::Result gotpc32(Relocation& pReloc, X86_32Relocator& pParent)
+Relocator::Result gotpc32(Relocation& pReloc, Relocator::DWord& pTarget,
+                          X86_32Relocator& pParent)
 {
-  Relocator::DWord      A       = pReloc.target() + pReloc.addend();
+  Relocator::DWord      A       = pTarget + pReloc.addend();
   Relocator::Address GOT_ORG = helper_GOT_ORG(pParent);
   // Apply relocation.
-  pReloc.target() = GOT_ORG + A - pReloc.place();
+  pTarget = GOT_ORG + A - pReloc.place();
   return Relocator::OK;
 }
 
 // R_386_GOT32: GOT(S) + A - GOT_ORG
-Relocator::Result got32(Relocation& pReloc, X86_32Relocator& pParent)
+Relocator::Result got32(Relocation& pReloc, Relocator::DWord& pTarget,
+                        X86_32Relocator& pParent)
 {
   ResolveInfo* rsym = pReloc.symInfo();
   if (!(rsym->reserved() & (X86Relocator::ReserveGOT)))
@@ -970,19 +961,23 @@ Relocator::Result got32(Relocation& pReloc, X86_32Relocator& pParent)
   // the dyn rel is RELATIVE
   X86_32GOTEntry* got_entry = pParent.getSymGOTMap().lookUp(*pReloc.symInfo());
   assert(NULL != got_entry);
-  if (got_entry->getValue() == X86Relocator::SymVal)
-    got_entry->setValue(pReloc.symValue());
+  {
+    llvm::sys::ScopedLock lock(pParent.getEntryLock());
+    if (got_entry->getValue() == X86Relocator::SymVal)
+      got_entry->setValue(pReloc.symValue());
+  }
 
   Relocator::Address GOT_S   = helper_get_GOT_address(pReloc, pParent);
-  Relocator::DWord      A       = pReloc.target() + pReloc.addend();
+  Relocator::DWord      A       = pTarget + pReloc.addend();
   Relocator::Address GOT_ORG = helper_GOT_ORG(pParent);
   // Apply relocation.
-  pReloc.target() = GOT_S + A - GOT_ORG;
+  pTarget = GOT_S + A - GOT_ORG;
   return Relocator::OK;
 }
 
 // R_386_PLT32: PLT(S) + A - P
-Relocator::Result plt32(Relocation& pReloc, X86_32Relocator& pParent)
+Relocator::Result plt32(Relocation& pReloc, Relocator::DWord& pTarget,
+                        X86_32Relocator& pParent)
 {
   // PLT_S depends on if there is a PLT entry.
   Relocator::Address PLT_S;
@@ -990,14 +985,15 @@ Relocator::Result plt32(Relocation& pReloc, X86_32Relocator& pParent)
     PLT_S = helper_get_PLT_address(*pReloc.symInfo(), pParent);
   else
     PLT_S = pReloc.symValue();
-  Relocator::DWord      A = pReloc.target() + pReloc.addend();
+  Relocator::DWord      A = pTarget + pReloc.addend();
   Relocator::Address P = pReloc.place();
-  pReloc.target() = PLT_S + A - P;
+  pTarget = PLT_S + A - P;
   return Relocator::OK;
 }
 
 // R_386_TLS_GD:
-Relocator::Result tls_gd(Relocation& pReloc, X86_32Relocator& pParent)
+Relocator::Result tls_gd(Relocation& pReloc, Relocator::DWord& pTarget,
+                         X86_32Relocator& pParent)
 {
   // global-dynamic
   ResolveInfo* rsym = pReloc.symInfo();
@@ -1013,23 +1009,26 @@ Relocator::Result tls_gd(Relocation& pReloc, X86_32Relocator& pParent)
   X86_32GOTEntry* got_entry1 = pParent.getSymGOTMap().lookUpFirstEntry(*rsym);
 
   // set the got_entry2 value to symbol value
-  if (rsym->isLocal())
-     pParent.getSymGOTMap().lookUpSecondEntry(*rsym)->setValue(pReloc.symValue());
+  if (rsym->isLocal()) {
+    llvm::sys::ScopedLock lock(pParent.getEntryLock());
+    pParent.getSymGOTMap().lookUpSecondEntry(*rsym)->setValue(pReloc.symValue());
+  }
 
   // perform relocation to the first got entry
-  Relocator::DWord A = pReloc.target() + pReloc.addend();
+  Relocator::DWord A = pTarget + pReloc.addend();
   // GOT_OFF - the offset between the got_entry1 and _GLOBAL_OFFSET_TABLE (the
   // .got.plt section)
   Relocator::Address GOT_OFF =
      file_format->getGOT().addr() +
      got_entry1->getOffset() -
      file_format->getGOTPLT().addr();
-  pReloc.target() = GOT_OFF + A;
+  pTarget = GOT_OFF + A;
   return Relocator::OK;
 }
 
 // R_386_TLS_LDM
-Relocator::Result tls_ldm(Relocation& pReloc, X86_32Relocator& pParent)
+Relocator::Result tls_ldm(Relocation& pReloc, Relocator::DWord& pTarget,
+                          X86_32Relocator& pParent)
 {
   // FIXME: no linker optimization for TLS relocation
   const X86_32GOTEntry& got_entry = pParent.getTLSModuleID();
@@ -1038,24 +1037,26 @@ Relocator::Result tls_ldm(Relocation& pReloc, X86_32Relocator& pParent)
   X86Relocator::SWord GOT_S = got_entry.getOffset() -
                                       (pParent.getTarget().getGOTPLT().addr() -
                                        pParent.getTarget().getGOT().addr());
-  Relocator::DWord A = pReloc.target() + pReloc.addend();
-  pReloc.target() = GOT_S + A;
+  Relocator::DWord A = pTarget + pReloc.addend();
+  pTarget = GOT_S + A;
 
   return Relocator::OK;
 }
 
 // R_386_TLS_LDO_32
-Relocator::Result tls_ldo_32(Relocation& pReloc, X86_32Relocator& pParent)
+Relocator::Result tls_ldo_32(Relocation& pReloc, Relocator::DWord& pTarget,
+                             X86_32Relocator& pParent)
 {
   // FIXME: no linker optimization for TLS relocation
-  Relocator::DWord A = pReloc.target() + pReloc.addend();
+  Relocator::DWord A = pTarget + pReloc.addend();
   Relocator::Address S = pReloc.symValue();
-  pReloc.target() = S + A;
+  pTarget = S + A;
   return Relocator::OK;
 }
 
 // R_X86_TLS_IE
-Relocator::Result tls_ie(Relocation& pReloc, X86_32Relocator& pParent)
+Relocator::Result tls_ie(Relocation& pReloc, Relocator::DWord& pTarget,
+                         X86_32Relocator& pParent)
 {
   ResolveInfo* rsym = pReloc.symInfo();
   if (!(rsym->reserved() & X86Relocator::ReserveGOT)) {
@@ -1069,14 +1070,15 @@ Relocator::Result tls_ie(Relocation& pReloc, X86_32Relocator& pParent)
   Relocator::Address GOT_S =
                    pParent.getTarget().getGOT().addr() + got_entry->getOffset();
 
-  Relocator::DWord A = pReloc.target() + pReloc.addend();
-  pReloc.target() = GOT_S + A;
+  Relocator::DWord A = pTarget + pReloc.addend();
+  pTarget = GOT_S + A;
 
   return Relocator::OK;
 }
 
 // R_386_TLS_GOTIE
-Relocator::Result tls_gotie(Relocation& pReloc, X86_32Relocator& pParent)
+Relocator::Result tls_gotie(Relocation& pReloc, Relocator::DWord& pTarget,
+                            X86_32Relocator& pParent)
 {
   ResolveInfo* rsym = pReloc.symInfo();
   if (!(rsym->reserved() & X86Relocator::ReserveGOT)) {
@@ -1090,14 +1092,15 @@ Relocator::Result tls_gotie(Relocation& pReloc, X86_32Relocator& pParent)
   // All GOT offsets are relative to the end of the GOT.
   X86Relocator::SWord GOT_S = got_entry->getOffset() -
     (pParent.getTarget().getGOTPLT().addr() - pParent.getTarget().getGOT().addr());
-  Relocator::DWord A = pReloc.target() + pReloc.addend();
-  pReloc.target() = GOT_S + A;
+  Relocator::DWord A = pTarget + pReloc.addend();
+  pTarget = GOT_S + A;
 
   return Relocator::OK;
 }
 
 // R_X86_TLS_LE
-Relocator::Result tls_le(Relocation& pReloc, X86_32Relocator& pParent)
+Relocator::Result tls_le(Relocation& pReloc, Relocator::DWord& pTarget,
+                         X86_32Relocator& pParent)
 {
   if (pReloc.symInfo()->reserved() & X86Relocator::ReserveRel)
     return Relocator::OK;
@@ -1109,13 +1112,39 @@ Relocator::Result tls_le(Relocation& pReloc, X86_32Relocator& pParent)
                                                llvm::ELF::PF_R,
                                                0x0);
   assert(tls_seg != pParent.getTarget().elfSegmentTable().end());
-  Relocator::DWord A = pReloc.target() + pReloc.addend();
+  Relocator::DWord A = pTarget + pReloc.addend();
   Relocator::Address S = pReloc.symValue();
-  pReloc.target() = S + A - (*tls_seg)->memsz();
+  pTarget = S + A - (*tls_seg)->memsz();
   return Relocator::OK;
 }
 
-Relocator::Result unsupport(Relocation& pReloc, X86_32Relocator& pParent)
+// R_386_TLS_OPT: modify the opcodes of a TLS IE access to the LE ones
+Relocator::Result tls_opt(Relocation& pReloc, Relocator::DWord& pTarget,
+                          X86_32Relocator& pParent)
+{
+  uint8_t* op = reinterpret_cast<uint8_t*>(&pTarget);
+  switch (op[0]) {
+    case 0xa1:
+      op[0] = 0xb8;
+      break;
+    case 0x8b:
+      assert((op[1] & 0xc7) == 0x05);
+      op[0] = 0xc7;
+      op[1] = 0xc0 | ((op[1] >> 3) & 7);
+      break;
+    case 0x03:
+      assert((op[1] & 0xc7) == 0x05);
+      op[0] = 0x81;
+      op[1] = 0xc0 | ((op[1] >> 3) & 7);
+      break;
+    default:
+      return Relocator::BadReloc;
+  }
+  return Relocator::OK;
+}
+
+Relocator::Result unsupport(Relocation& pReloc, Relocator::DWord& pTarget,
+                            X86_32Relocator& pParent)
 {
   return Relocator::Unsupport;
 }
@@ -1250,6 +1279,7 @@ DECL_X86_64_APPLY_RELOC_FUNCS
 
 /// the prototype of applying function
 typedef Relocator::Result (*X86_64ApplyFunctionType)(Relocation& pReloc,
+                                                     Relocator::DWord& pTarget,
                                                      X86_64Relocator& pParent);
 
 // the table entry of applying functions
@@ -1275,7 +1305,7 @@ X86_64Relocator::X86_64Relocator(X86_64GNULDBackend& pParent,
 }
 
 Relocator::Result
-X86_64Relocator::applyRelocation(Relocation& pRelocation)
+X86_64Relocator::applyRelocation(Relocation& pRelocation, DWord& pTarget)
 {
   Relocation::Type type = pRelocation.type();
 
@@ -1284,7 +1314,7 @@ X86_64Relocator::applyRelocation(Relocation& pRelocation)
   }
 
   // apply the relocation
-  return X86_64ApplyFunctions[type].func(pRelocation, *this);
+  return X86_64ApplyFunctions[type].func(pRelocation, pTarget, *this);
 }
 
 const char* X86_64Relocator::getName(Relocation::Type pType) const
@@ -1519,7 +1549,8 @@ void X86_64Relocator::scanGlobalReloc(Relocation& pReloc,
 //
 // ===
 // R_X86_64_NONE
-Relocator::Result none(Relocation& pReloc, X86_64Relocator& pParent)
+Relocator::Result none(Relocation& pReloc, Relocator::DWord& pTarget,
+                       X86_64Relocator& pParent)
 {
   return Relocator::OK;
 }
@@ -1528,10 +1559,11 @@ Relocator::Result none(Relocation& pReloc, X86_64Relocator& pParent)
 // R_X86_64_32:
 // R_X86_64_16:
 // R_X86_64_8
-Relocator::Result abs(Relocation& pReloc, X86_64Relocator& pParent)
+Relocator::Result abs(Relocation& pReloc, Relocator::DWord& pTarget,
+                      X86_64Relocator& pParent)
 {
   ResolveInfo* rsym = pReloc.symInfo();
-  Relocator::DWord A = pReloc.target() + pReloc.addend();
+  Relocator::DWord A = pTarget + pReloc.addend();
   Relocator::DWord S = pReloc.symValue();
   Relocation* dyn_rel = pParent.getRelRelMap().lookUp(pReloc);
   bool has_dyn_rel = (NULL != dyn_rel);
@@ -1540,7 +1572,7 @@ Relocator::Result abs(Relocation& pReloc, X86_64Relocator& pParent)
   // If the flag of target section is not ALLOC, we will not scan this relocation
   // but perform static relocation. (e.g., applying .debug section)
   if (0x0 == (llvm::ELF::SHF_ALLOC & target_sect.flag())) {
-    pReloc.target() = S + A;
+    pTarget = S + A;
     return Relocator::OK;
   }
 
@@ -1571,15 +1603,16 @@ Relocator::Result abs(Relocation& pReloc, X86_64Relocator& pParent)
   }
 
   // perform static relocation
-  pReloc.target() = S + A;
+  pTarget = S + A;
   return Relocator::OK;
 }
 
 // R_X86_64_32S: S + A
-Relocator::Result signed32(Relocation& pReloc, X86_64Relocator& pParent)
+Relocator::Result signed32(Relocation& pReloc, Relocator::DWord& pTarget,
+                           X86_64Relocator& pParent)
 {
   ResolveInfo* rsym = pReloc.symInfo();
-  Relocator::DWord A = pReloc.target() + pReloc.addend();
+  Relocator::DWord A = pTarget + pReloc.addend();
   Relocator::DWord S = pReloc.symValue();
 
   // There should be no dynamic relocations for R_X86_64_32S.
@@ -1602,12 +1635,13 @@ Relocator::Result signed32(Relocation& pReloc, X86_64Relocator& pParent)
 #endif
 
   // perform static relocation
-  pReloc.target() = S + A;
+  pTarget = S + A;
   return Relocator::OK;
 }
 
 // R_X86_64_GOTPCREL: GOT(S) + GOT_ORG + A - P
-Relocator::Result gotpcrel(Relocation& pReloc, X86_64Relocator& pParent)
+Relocator::Result gotpcrel(Relocation& pReloc, Relocator::DWord& pTarget,
+                           X86_64Relocator& pParent)
 {
   if (!(pReloc.symInfo()->reserved() & X86Relocator::ReserveGOT)) {
     return Relocator::BadReloc;
@@ -1615,8 +1649,11 @@ Relocator::Result gotpcrel(Relocation& pReloc, X86_64Relocator& pParent)
 
   // set symbol value of the got entry if needed
   X86_64GOTEntry* got_entry = pParent.getSymGOTMap().lookUp(*pReloc.symInfo());
-  if (X86Relocator::SymVal == got_entry->getValue())
-    got_entry->setValue(pReloc.symValue());
+  {
+    llvm::sys::ScopedLock lock(pParent.getEntryLock());
+    if (X86Relocator::SymVal == got_entry->getValue())
+      got_entry->setValue(pReloc.symValue());
+  }
 
   // setup relocation addend if needed
   Relocation* dyn_rel = pParent.getRelRelMap().lookUp(pReloc);
@@ -1625,15 +1662,16 @@ Relocator::Result gotpcrel(Relocation& pReloc, X86_64Relocator& pParent)
   }
 
   Relocator::Address GOT_S   = helper_get_GOT_address(pReloc, pParent);
-  Relocator::DWord      A    = pReloc.target() + pReloc.addend();
+  Relocator::DWord      A    = pTarget + pReloc.addend();
   Relocator::Address GOT_ORG = helper_GOT_ORG(pParent);
   // Apply relocation.
-  pReloc.target() = GOT_S + GOT_ORG + A - pReloc.place();
+  pTarget = GOT_S + GOT_ORG + A - pReloc.place();
   return Relocator::OK;
 }
 
 // R_X86_64_PLT32: PLT(S) + A - P
-Relocator::Result plt32(Relocation& pReloc, X86_64Relocator& pParent)
+Relocator::Result plt32(Relocation& pReloc, Relocator::DWord& pTarget,
+                        X86_64Relocator& pParent)
 {
   // PLT_S depends on if there is a PLT entry.
   Relocator::Address PLT_S;
@@ -1641,19 +1679,20 @@ Relocator::Result plt32(Relocation& pReloc, X86_64Relocator& pParent)
     PLT_S = helper_get_PLT_address(*pReloc.symInfo(), pParent);
   else
     PLT_S = pReloc.symValue();
-  Relocator::DWord   A = pReloc.target() + pReloc.addend();
+  Relocator::DWord   A = pTarget + pReloc.addend();
   Relocator::Address P = pReloc.place();
-  pReloc.target() = PLT_S + A - P;
+  pTarget = PLT_S + A - P;
   return Relocator::OK;
 }
 
 // R_X86_64_PC32: S + A - P
 // R_X86_64_PC16
 // R_X86_64_PC8
-Relocator::Result rel(Relocation& pReloc, X86_64Relocator& pParent)
+Relocator::Result rel(Relocation& pReloc, Relocator::DWord& pTarget,
+                      X86_64Relocator& pParent)
 {
   ResolveInfo* rsym = pReloc.symInfo();
-  Relocator::DWord A = pReloc.target() + pReloc.addend();
+  Relocator::DWord A = pTarget + pReloc.addend();
   Relocator::DWord S = pReloc.symValue();
   Relocator::DWord P = pReloc.place();
 
@@ -1661,7 +1700,7 @@ Relocator::Result rel(Relocation& pReloc, X86_64Relocator& pParent)
   // If the flag of target section is not ALLOC, we will not scan this relocation
   // but perform static relocation. (e.g., applying .debug section)
   if (0x0 == (llvm::ELF::SHF_ALLOC & target_sect.flag())) {
-    pReloc.target() = S + A - P;
+    pTarget = S + A - P;
     return Relocator::OK;
   }
 
@@ -1685,11 +1724,12 @@ Relocator::Result rel(Relocation& pReloc, X86_64Relocator& pParent)
   }
 
    // perform static relocation
-  pReloc.target() = S + A - P;
+  pTarget = S + A - P;
   return Relocator::OK;
 }
 
-Relocator::Result unsupport(Relocation& pReloc, X86_64Relocator& pParent)
+Relocator::Result unsupport(Relocation& pReloc, Relocator::DWord& pTarget,
+                            X86_64Relocator& pParent)
 {
   return Relocator::Unsupport;
 }
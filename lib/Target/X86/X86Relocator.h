@@ -71,7 +71,11 @@ public:
   X86Relocator(const LinkerConfig& pConfig);
   ~X86Relocator();
 
-  virtual Result applyRelocation(Relocation& pRelocation) = 0;
+  virtual Result applyRelocation(Relocation& pRelocation, DWord& pTarget) = 0;
+
+  /// isApplyThreadSafe - relocations of different inputs can be applied
+  /// concurrently
+  bool isApplyThreadSafe() const { return true; }
 
   virtual const char* getName(Relocation::Type pType) const = 0;
 
@@ -134,7 +138,7 @@ public:
 public:
   X86_32Relocator(X86_32GNULDBackend& pParent, const LinkerConfig& pConfig);
 
-  Result applyRelocation(Relocation& pRelocation);
+  Result applyRelocation(Relocation& pRelocation, DWord& pTarget);
 
   X86_32GNULDBackend& getTarget()
   { return m_Target; }
@@ -189,7 +193,7 @@ public:
 public:
   X86_64Relocator(X86_64GNULDBackend& pParent, const LinkerConfig& pConfig);
 
-  Result applyRelocation(Relocation& pRelocation);
+  Result applyRelocation(Relocation& pRelocation, DWord& pTarget);
 
   X86_64GNULDBackend& getTarget()
   { return m_Target; }
@@ -0,0 +1,23 @@
+; The .rel.plt entries of Mips are filled up while applying relocations, so
+; they must be written out after the relocator runs, even when the output
+; sections are written on the thread pool.
+
+; RUN: %MCLinker -mtriple=mipsel-linux-gnueabi -filetype=exe --threads=4 \
+; RUN: %p/../../libs/MIPS/Linux/32/crt1.o %p/../../libs/MIPS/Linux/32/crti.o \
+; RUN: %p/main.o %p/bar.o %p/../../libs/MIPS/Linux/32/libc_nonshared.a \
+; RUN: %p/../../libs/MIPS/Linux/32/ld.so.1 \
+; RUN: %p/../../libs/MIPS/Linux/32/crtn.o \
+; RUN: %p/../../libs/MIPS/Linux/32/libc.so.6 -o %t.out
+
+; RUN: readelf -A %t.out > %t.txt
+; RUN: readelf -r %t.out >> %t.txt
+; RUN: FileCheck %s < %t.txt
+
+; CHECK: PLT GOT:
+; CHECK:  Entries:
+; CHECK:  [[SLOT0:[0-9a-f]+]] {{[0-9a-f]+}} 00000000 FUNC UND __libc_start_main
+; CHECK:  [[SLOT1:[0-9a-f]+]] {{[0-9a-f]+}} 00000000 FUNC UND puts
+
+; CHECK: Relocation section '.rel.plt' at offset {{0x[0-9a-f]+}} contains 2 entries:
+; CHECK: [[SLOT0]] {{[0-9a-f]+}} R_MIPS_JUMP_SLOT 00000000 __libc_start_main
+; CHECK: [[SLOT1]] {{[0-9a-f]+}} R_MIPS_JUMP_SLOT 00000000 puts
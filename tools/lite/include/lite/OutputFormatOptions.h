@@ -53,6 +53,7 @@ private:
   llvm::cl::list<std::string>& m_ExcludeLIBS;
 
   llvm::cl::opt<bool>& m_NoWarnMismatch;
+  llvm::cl::opt<bool>& m_UnlinkOldOutput;
 };
 
 } // namespace of mcld
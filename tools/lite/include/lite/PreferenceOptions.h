@@ -37,6 +37,7 @@ private:
   llvm::cl::opt<int>&   m_MaxWarnNum;
   llvm::cl::opt<Color>& m_Color;
   llvm::cl::opt<bool>&  m_PrintMap;
+  llvm::cl::opt<unsigned int>& m_Threads;
   bool& m_FatalWarnings;
 };
 
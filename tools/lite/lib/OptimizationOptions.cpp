@@ -28,6 +28,14 @@ llvm::cl::opt<bool, true, llvm::cl::FalseParser> ArgNoGCSectionsFlag("no-gc-sect
   llvm::cl::desc("disable garbage collection of unused input sections."),
   llvm::cl::init(false));
 
+bool ArgTailMergeStrings;
+
+llvm::cl::opt<bool, true> ArgTailMergeStringsFlag("tail-merge-strings",
+  llvm::cl::ZeroOrMore,
+  llvm::cl::location(ArgTailMergeStrings),
+  llvm::cl::desc("Share the tails of the merged strings."),
+  llvm::cl::init(false));
+
 bool ArgGenUnwindInfo;
 
 llvm::cl::opt<bool, true, llvm::cl::FalseParser>
@@ -77,6 +85,7 @@ using namespace mcld;
 //===----------------------------------------------------------------------===//
 OptimizationOptions::OptimizationOptions()
   : m_GCSections(ArgGCSections),
+    m_TailMergeStrings(ArgTailMergeStrings),
     m_GenUnwindInfo(ArgGenUnwindInfo),
     m_ICF(ArgICF),
     m_Plugin(ArgPlugin),
@@ -89,17 +98,24 @@ bool OptimizationOptions::parse(LinkerConfig& pConfig)
   if (m_GCSections)
     pConfig.options().setGCSections();
 
+  // set --tail-merge-strings
+  if (m_TailMergeStrings)
+    pConfig.options().setTailMergeStrings();
+
   // set --ld-generated-unwind-info (or not)
   pConfig.options().setGenUnwindInfo(m_GenUnwindInfo);
 
   // set --icf [mode]
   switch (m_ICF) {
-    case ICF_None:
-      break;
     case ICF_All:
+      pConfig.options().setICFMode(GeneralOptions::ICFAll);
+      break;
     case ICF_Safe:
+      pConfig.options().setICFMode(GeneralOptions::ICFSafe);
+      break;
+    case ICF_None:
     default:
-      warning(mcld::diag::warn_unsupported_option) << m_ICF.ArgStr;
+      pConfig.options().setICFMode(GeneralOptions::ICFNone);
       break;
   }
 
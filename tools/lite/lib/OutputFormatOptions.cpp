@@ -9,6 +9,7 @@
 #include <lite/OutputFormatOptions.h>
 #include <mcld/Module.h>
 #include <mcld/Support/MsgHandling.h>
+#include <mcld/Support/raw_ostream.h>
 
 namespace {
 
@@ -152,6 +153,10 @@ llvm::cl::opt<bool> ArgNoWarnMismatch("no-warn-mismatch",
   llvm::cl::desc("Allow linking together mismatched input files."),
   llvm::cl::init(false));
 
+llvm::cl::opt<bool> ArgUnlinkOldOutput("unlink-old-output-in-background",
+  llvm::cl::desc("Unlink the previous output file in a background process"),
+  llvm::cl::init(false));
+
 // Not supported yet {
 llvm::cl::opt<bool> ArgExportDynamic("export-dynamic",
   llvm::cl::desc("Export all dynamic symbols"),
@@ -199,7 +204,8 @@ OutputFormatOptions::OutputFormatOptions()
     m_ExportDynamic(ArgExportDynamic),
     m_BuildID(ArgBuildID),
     m_ExcludeLIBS(ArgExcludeLIBS),
-    m_NoWarnMismatch(ArgNoWarnMismatch) {
+    m_NoWarnMismatch(ArgNoWarnMismatch),
+    m_UnlinkOldOutput(ArgUnlinkOldOutput) {
 }
 
 bool OutputFormatOptions::parse(mcld::Module& pModule, LinkerConfig& pConfig)
@@ -232,7 +238,17 @@ bool OutputFormatOptions::parse(mcld::Module& pModule, LinkerConfig& pConfig)
     pConfig.options().setWarnMismatch(false);
   else
     pConfig.options().setWarnMismatch(true);
+
+  pConfig.options().setUnlinkOldOutputInBackground(m_UnlinkOldOutput);
+
   // build-id
+  if (m_BuildID.getNumOccurrences() &&
+      !pConfig.options().setBuildID(m_BuildID)) {
+    mcld::errs() << "ERROR: invalid --build-id style `" << m_BuildID
+                 << "'.\n";
+    return false;
+  }
+
   // exclude-libs
 
   return true;
@@ -76,6 +76,11 @@ llvm::cl::alias ArgPrintMapAlias("print-map",
   llvm::cl::desc("alias for -M"),
   llvm::cl::aliasopt(ArgPrintMap));
 
+llvm::cl::opt<unsigned int> ArgThreads("threads",
+  llvm::cl::value_desc("N"),
+  llvm::cl::desc("Use N threads to link, 0 means the number of processors."),
+  llvm::cl::init(1));
+
 bool ArgFatalWarnings;
 
 llvm::cl::opt<bool, true, llvm::cl::FalseParser> ArgNoFatalWarnings("no-fatal-warnings",
@@ -127,6 +132,7 @@ PreferenceOptions::PreferenceOptions()
     m_MaxWarnNum(ArgMaxWarnNum),
     m_Color(ArgColor),
     m_PrintMap(ArgPrintMap),
+    m_Threads(ArgThreads),
     m_FatalWarnings(ArgFatalWarnings) {
 }
 
@@ -159,6 +165,9 @@ bool PreferenceOptions::parse(LinkerConfig& pConfig)
     break;
   }
 
+  // set --threads=N
+  pConfig.options().setNumOfThreads(m_Threads);
+
   mcld::outs().setColor(pConfig.options().color());
   mcld::errs().setColor(pConfig.options().color());
 
@@ -530,6 +530,12 @@ ArgGPSize("G",
           cl::desc("Set the maximum size of objects to be optimized using GP"),
           cl::init(8));
 
+static cl::opt<unsigned int>
+ArgThreads("threads",
+           cl::value_desc("N"),
+           cl::desc("Use N threads to link, 0 means the number of processors"),
+           cl::init(1));
+
 static bool ArgGenUnwindInfo;
 
 static cl::opt<bool, true, cl::FalseParser>
@@ -562,6 +568,12 @@ ArgNoGCSections("no-gc-sections",
                 cl::desc("disable garbage collection of unused input sections."),
                 cl::init(false));
 
+static cl::opt<bool>
+ArgTailMergeStrings("tail-merge-strings",
+                    cl::ZeroOrMore,
+                    cl::desc("Share the tails of the merged strings."),
+                    cl::init(false));
+
 namespace icf {
 enum Mode {
   None,
@@ -737,6 +749,11 @@ ArgNoWarnMismatch("no-warn-mismatch",
                   cl::desc("Allow linking together mismatched input files."),
                   cl::init(false));
 
+static cl::opt<bool>
+ArgUnlinkOldOutput("unlink-old-output-in-background",
+                   cl::desc("Unlink the previous output in a background process"),
+                   cl::init(false));
+
 static cl::opt<bool>
 ArgNoStdlib("nostdlib",
             cl::desc("Only search lib dirs explicitly specified on cmdline"),
@@ -1168,15 +1185,24 @@ static bool ProcessLinkerOptionsFromCommand(mcld::LinkerScript& pScript,
   pConfig.options().setDefineCommon(ArgDefineCommon);
   pConfig.options().setNewDTags(ArgEnableNewDTags);
   pConfig.options().setHashStyle(ArgHashStyle);
+  if (ArgBuildID.getNumOccurrences() &&
+      !pConfig.options().setBuildID(ArgBuildID)) {
+    errs() << "ERROR: invalid --build-id style `" << ArgBuildID << "'.\n";
+    return false;
+  }
   pConfig.options().setNoStdlib(ArgNoStdlib);
   pConfig.options().setPrintMap(ArgPrintMap);
   pConfig.options().setGCSections(ArgGCSections);
+  pConfig.options().setTailMergeStrings(ArgTailMergeStrings);
   pConfig.options().setGPSize(ArgGPSize);
+  pConfig.options().setNumOfThreads(ArgThreads);
   if (ArgNoWarnMismatch)
     pConfig.options().setWarnMismatch(false);
   else
     pConfig.options().setWarnMismatch(true);
 
+  pConfig.options().setUnlinkOldOutputInBackground(ArgUnlinkOldOutput);
+
   if (ArgStripAll)
     pConfig.options().setStripSymbols(mcld::GeneralOptions::StripAllSymbols);
   else if (ArgDiscardAll)
@@ -1249,12 +1275,15 @@ static bool ProcessLinkerOptionsFromCommand(mcld::LinkerScript& pScript,
 
   // set up icf mode
   switch (ArgICF) {
-    case icf::None:
-      break;
     case icf::All:
+      pConfig.options().setICFMode(mcld::GeneralOptions::ICFAll);
+      break;
     case icf::Safe:
+      pConfig.options().setICFMode(mcld::GeneralOptions::ICFSafe);
+      break;
+    case icf::None:
     default:
-      mcld::warning(mcld::diag::warn_unsupported_option) << ArgICF.ArgStr;
+      pConfig.options().setICFMode(mcld::GeneralOptions::ICFNone);
       break;
   }
 
@@ -0,0 +1,163 @@
+//===- BuildIDTest.cpp ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/LD/BuildID.h>
+#include <mcld/GeneralOptions.h>
+#include <mcld/Support/SHA1.h>
+#include <mcld/Support/ThreadPool.h>
+#include "BuildIDTest.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace mcld;
+using namespace mcld::test;
+
+namespace {
+
+/// ToHex - the lower-case hexadecimal digits of pSize bytes at pData
+std::string ToHex(const uint8_t* pData, size_t pSize)
+{
+  std::string result;
+  for (size_t i = 0; i < pSize; ++i) {
+    char buf[3];
+    snprintf(buf, sizeof(buf), "%02x", (unsigned int)pData[i]);
+    result += buf;
+  }
+  return result;
+}
+
+std::string SHA1Hex(const std::string& pMessage)
+{
+  SHA1 hasher;
+  hasher.update((const uint8_t*)pMessage.data(), pMessage.size());
+  uint8_t digest[SHA1::DigestSize];
+  hasher.final(digest);
+  return ToHex(digest, SHA1::DigestSize);
+}
+
+} // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+BuildIDTest::BuildIDTest()
+{
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+BuildIDTest::~BuildIDTest()
+{
+}
+
+// SetUp() will be called immediately before each test.
+void BuildIDTest::SetUp()
+{
+}
+
+// TearDown() will be called immediately after each test.
+void BuildIDTest::TearDown()
+{
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F( BuildIDTest, sha1) {
+  ASSERT_EQ("da39a3ee5e6b4b0d3255bfef95601890afd80709", SHA1Hex(""));
+  ASSERT_EQ("a9993e364706816aba3e25717850c26c9cd0d89d", SHA1Hex("abc"));
+  ASSERT_EQ("84983e441c3bd26ebaae4aa1f95129e5e54670f1",
+      SHA1Hex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"));
+
+  // one million 'a', in pieces of odd sizes
+  std::string piece(997, 'a');
+  SHA1 hasher;
+  size_t remain = 1000000;
+  while (remain > 0) {
+    size_t size = (remain < piece.size()) ? remain : piece.size();
+    hasher.update((const uint8_t*)piece.data(), size);
+    remain -= size;
+  }
+  uint8_t digest[SHA1::DigestSize];
+  hasher.final(digest);
+  ASSERT_EQ("34aa973cd4c4daa4f61eeb2bdbad27316534016f",
+            ToHex(digest, SHA1::DigestSize));
+}
+
+TEST_F( BuildIDTest, tree_hash) {
+  // five and a half chunks
+  std::vector<uint8_t> data(BuildID::ChunkSize * 5 + BuildID::ChunkSize / 2);
+  uint32_t seed = 12345;
+  for (size_t i = 0; i < data.size(); ++i) {
+    seed = seed * 1103515245u + 12345u;
+    data[i] = (uint8_t)(seed >> 16);
+  }
+
+  unsigned int styles[] = { GeneralOptions::FastBuildID,
+                            GeneralOptions::MD5BuildID,
+                            GeneralOptions::SHA1BuildID };
+  ThreadPool serial(1), parallel(4);
+  for (size_t s = 0; s < sizeof(styles) / sizeof(styles[0]); ++s) {
+    size_t size = BuildID::getHashSize(styles[s]);
+    ASSERT_TRUE(size > 0 && size <= BuildID::MaxDigestSize);
+
+    // the hash of the chunk digests
+    std::vector<uint8_t> digests;
+    for (size_t offset = 0; offset < data.size();
+         offset += BuildID::ChunkSize) {
+      size_t chunk = data.size() - offset;
+      if (chunk > BuildID::ChunkSize)
+        chunk = BuildID::ChunkSize;
+      uint8_t digest[BuildID::MaxDigestSize];
+      BuildID::computeHash(styles[s], &data[offset], chunk, digest);
+      digests.insert(digests.end(), digest, digest + size);
+    }
+    uint8_t expected[BuildID::MaxDigestSize];
+    BuildID::computeHash(styles[s], &digests[0], digests.size(), expected);
+
+    // the same whatever the number of threads
+    uint8_t result1[BuildID::MaxDigestSize], result2[BuildID::MaxDigestSize];
+    BuildID::computeTreeHash(styles[s], &data[0], data.size(), result1, serial);
+    BuildID::computeTreeHash(styles[s], &data[0], data.size(), result2,
+                             parallel);
+    ASSERT_EQ(0, memcmp(expected, result1, size));
+    ASSERT_EQ(0, memcmp(expected, result2, size));
+
+    // any change of the data changes the build ID
+    data[BuildID::ChunkSize * 3 + 7] ^= 0x1;
+    BuildID::computeTreeHash(styles[s], &data[0], data.size(), result2,
+                             parallel);
+    ASSERT_NE(0, memcmp(result1, result2, size));
+  }
+}
+
+TEST_F( BuildIDTest, style) {
+  GeneralOptions options;
+  ASSERT_FALSE(options.hasBuildID());
+
+  ASSERT_TRUE(options.setBuildID(""));
+  ASSERT_EQ(GeneralOptions::SHA1BuildID, options.getBuildIDStyle());
+  ASSERT_TRUE(options.setBuildID("fast"));
+  ASSERT_EQ(GeneralOptions::FastBuildID, options.getBuildIDStyle());
+  ASSERT_TRUE(options.setBuildID("md5"));
+  ASSERT_EQ(GeneralOptions::MD5BuildID, options.getBuildIDStyle());
+  ASSERT_TRUE(options.setBuildID("uuid"));
+  ASSERT_EQ(GeneralOptions::UUIDBuildID, options.getBuildIDStyle());
+
+  ASSERT_TRUE(options.setBuildID("0x01aBfF"));
+  ASSERT_EQ(GeneralOptions::HexBuildID, options.getBuildIDStyle());
+  ASSERT_EQ(std::string("\x01\xab\xff", 3), options.getBuildIDValue());
+
+  ASSERT_FALSE(options.setBuildID("0x123"));
+  ASSERT_FALSE(options.setBuildID("0xzz"));
+  ASSERT_FALSE(options.setBuildID("0x"));
+  ASSERT_FALSE(options.setBuildID("sha256"));
+
+  ASSERT_TRUE(options.setBuildID("none"));
+  ASSERT_FALSE(options.hasBuildID());
+}
@@ -7,12 +7,15 @@
 //
 //===----------------------------------------------------------------------===//
 #include <cstdio>
+#include <cstring>
 
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/ELF.h>
 #include <mcld/IRBuilder.h>
 #include <mcld/TargetOptions.h>
+#include <mcld/LD/ELFDynObjReader.h>
 #include <mcld/LD/ELFReader.h>
+#include <mcld/LD/NamePool.h>
 #include <mcld/MC/Input.h>
 #include <mcld/Support/Path.h>
 #include <mcld/Support/MemoryArea.h>
@@ -153,9 +156,92 @@ TEST_F( ELFReaderTest, read_regular_sections ) {
   ASSERT_TRUE( m_pELFObjReader->readSections(*m_pInput) );
 }
 
+TEST_F( ELFReaderTest, read_sections_and_symbols_in_advance ) {
+  m_pInput->setType(Input::Object);
+
+  // the parallel stage reads the sections and decodes the symbol table
+  ASSERT_TRUE(m_pELFObjReader->readSectionData(*m_pInput));
+  ASSERT_TRUE(m_pELFObjReader->readRawSymbols(*m_pInput));
+  LDSection* text = m_pInput->context()->getSection(".text");
+  ASSERT_TRUE(NULL != text);
+  ASSERT_TRUE(text->hasSectionData());
+  ASSERT_TRUE(NULL == m_pInput->context()->getSymbol(1));
+
+  // the serial stage keeps the read sections and creates the same symbols
+  // as reading the symbol table directly
+  SectionData* text_data = text->getSectionData();
+  ASSERT_TRUE(m_pELFObjReader->readSections(*m_pInput));
+  ASSERT_TRUE(text_data == text->getSectionData());
+  ASSERT_TRUE(m_pELFObjReader->readSymbols(*m_pInput));
+  ASSERT_EQ("hello.c", std::string(m_pInput->context()->getSymbol(1)->name()));
+  ASSERT_EQ("puts", std::string(m_pInput->context()->getSymbol(10)->name()));
+  ASSERT_TRUE(NULL==m_pInput->context()->getSymbol(11));
+}
+
 TEST_F( ELFReaderTest, is_my_format ) {
   bool doContinue;
   ASSERT_TRUE( m_pELFObjReader->isMyFormat(*m_pInput, doContinue) );
 }
 
+TEST_F( ELFReaderTest, symbol_name_as_string_ref ) {
+  m_pInput->setType(Input::Object);
+
+  // names in a string table are not terminated at the end of the StringRef
+  char strtab[] = "foo_bar_baz";
+  LDSymbol* sym = m_pIRBuilder->AddSymbol(*m_pInput,
+                                          llvm::StringRef(strtab, 7),
+                                          ResolveInfo::NoType,
+                                          ResolveInfo::Undefined,
+                                          ResolveInfo::Global,
+                                          0x0);
+  ASSERT_TRUE(NULL != sym);
+  ASSERT_EQ(7U, sym->resolveInfo()->nameSize());
+  ASSERT_TRUE(0 == std::strncmp("foo_bar", sym->resolveInfo()->name(), 7));
+
+  // the symbol keeps its own copy of the name
+  std::memset(strtab, 'x', 7);
+  ASSERT_TRUE(0 == std::strncmp("foo_bar", sym->resolveInfo()->name(), 7));
+  ASSERT_TRUE(NULL != m_pModule->getNamePool().findInfo("foo_bar"));
+  ASSERT_TRUE(NULL == m_pModule->getNamePool().findInfo("foo_bar_baz"));
+}
 
+TEST_F( ELFReaderTest, lazy_dynobj_symbols ) {
+  // test_x86_64.so defines lazy_func, other_func, lazy_data and its weak
+  // alias lazy_weak, and refers to ext_ref
+  Path path(TOPDIR);
+  path.append("unittests/test_x86_64.so");
+  Input* input = m_pIRBuilder->ReadInput("test_x86_64.so", path);
+  ASSERT_TRUE(NULL != input);
+  input->setType(Input::DynObj);
+
+  // lazy_func is referred to before the shared object is read
+  Resolver::Result result;
+  m_pModule->getNamePool().insertSymbol("lazy_func", false,
+                                        ResolveInfo::NoType,
+                                        ResolveInfo::Undefined,
+                                        ResolveInfo::Global, 0, 0,
+                                        ResolveInfo::Default, NULL, result);
+
+  ELFDynObjReader reader(*m_pLDBackend, *m_pIRBuilder, *m_pConfig);
+  ASSERT_TRUE(reader.readHeader(*input));
+  ASSERT_TRUE(reader.readSymbols(*input));
+
+  // only the referred definition and the undefined reference are read
+  const NamePool& pool = m_pModule->getNamePool();
+  ASSERT_TRUE(NULL != pool.findInfo("lazy_func"));
+  ASSERT_TRUE(pool.findInfo("lazy_func")->isDefine());
+  ASSERT_TRUE(pool.findInfo("lazy_func")->isDyn());
+  ASSERT_TRUE(NULL != pool.findInfo("ext_ref"));
+  ASSERT_TRUE(NULL == pool.findInfo("other_func"));
+  ASSERT_TRUE(NULL == pool.findInfo("lazy_data"));
+  ASSERT_TRUE(NULL == pool.findInfo("lazy_weak"));
+
+  // a lookup reads the definition, together with its weak aliases
+  ResolveInfo* weak = m_pModule->getNamePool().findInfo("lazy_weak");
+  ASSERT_TRUE(NULL != weak);
+  ASSERT_TRUE(weak->isDyn());
+  ASSERT_TRUE(NULL != pool.findInfo("lazy_data"));
+  ASSERT_TRUE(NULL != m_pModule->getAliasList(*weak));
+  ASSERT_EQ(2U, m_pModule->getAliasList(*weak)->size());
+  ASSERT_TRUE(NULL == pool.findInfo("other_func"));
+}
@@ -0,0 +1,186 @@
+//===- GNUHashTableBuilderTest.cpp ----------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/Target/GNUHashTableBuilder.h>
+#include <mcld/ADT/StringHash.h>
+#include "GNUHashTableBuilderTest.h"
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace mcld;
+using namespace mcld::test;
+
+namespace {
+
+/// MakeHashes - hash the names of a synthetic .dynsym
+std::vector<uint32_t> MakeHashes(unsigned int pNumOfSymbols)
+{
+  std::vector<uint32_t> result;
+  hash::StringHash<hash::DJB> hasher;
+  for (unsigned int i = 0; i < pNumOfSymbols; ++i) {
+    char name[64];
+    snprintf(name, sizeof(name), "_ZN4mcld%uC2ERKNS_%uE", i % 97, i);
+    result.push_back(hasher(name));
+  }
+  return result;
+}
+
+/// ReferenceTable - .gnu.hash built by bucketing the symbols in a multimap,
+/// as GNULDBackend::emitGNUHashTab() used to do
+struct ReferenceTable
+{
+  std::vector<uint32_t> order;
+  std::vector<uint32_t> buckets;
+  std::vector<uint32_t> chains;
+  std::vector<uint64_t> bloom;
+
+  ReferenceTable(const std::vector<uint32_t>& pHashes,
+                 uint32_t pNumOfBuckets,
+                 uint32_t pMaskBitsLog2,
+                 unsigned int pBitClass,
+                 uint32_t pSymIdx)
+  {
+    uint32_t shift1 = (64 == pBitClass) ? 6 : 5;
+    uint32_t mask = (1u << shift1) - 1;
+    uint32_t maskbits = 1u << pMaskBitsLog2;
+    uint32_t shift2 = pMaskBitsLog2;
+
+    typedef std::multimap<uint32_t, std::pair<uint32_t, uint32_t> > SymMapType;
+    SymMapType symmap;
+    for (uint32_t idx = 0; idx < pHashes.size(); ++idx) {
+      symmap.insert(std::make_pair(pHashes[idx] % pNumOfBuckets,
+                                   std::make_pair(idx, pHashes[idx])));
+    }
+
+    bloom.resize(1u << (pMaskBitsLog2 - shift1));
+    buckets.resize(pNumOfBuckets);
+    for (uint32_t idx = 0; idx < pNumOfBuckets; ++idx) {
+      size_t count = 0;
+      std::pair<SymMapType::iterator, SymMapType::iterator> ret;
+      ret = symmap.equal_range(idx);
+      for (SymMapType::iterator it = ret.first; it != ret.second; ) {
+        order.push_back(it->second.first);
+        uint32_t djbhash = it->second.second;
+        uint32_t val = ((djbhash >> shift1) & ((maskbits >> shift1) - 1));
+        bloom[val] |= uint64_t(1) << (djbhash & mask);
+        bloom[val] |= uint64_t(1) << ((djbhash >> shift2) & mask);
+        val = djbhash & ~1u;
+        if (++it == ret.second)
+          val |= 1;
+        chains.push_back(val);
+        ++count;
+      }
+      buckets[idx] = (0 == count) ? 0 : pSymIdx + order.size() - count;
+    }
+  }
+};
+
+/// BucketCount - a bucket count in the range used by GNULDBackend
+uint32_t BucketCount(size_t pNumOfSymbols)
+{
+  uint32_t result = 2;
+  while (result < pNumOfSymbols / 2 && result < 262147)
+    result = result * 2 + 1;
+  return result;
+}
+
+/// MaskBitsLog2 - the same as GNULDBackend::getGNUHashMaskbitslog2()
+uint32_t MaskBitsLog2(size_t pNumOfSymbols, unsigned int pBitClass)
+{
+  uint32_t maskbitslog2 = 1;
+  for (uint32_t x = pNumOfSymbols >> 1; x != 0; x >>= 1)
+    ++maskbitslog2;
+  if (maskbitslog2 < 3)
+    maskbitslog2 = 5;
+  else if (((1U << (maskbitslog2 - 2)) & pNumOfSymbols) != 0)
+    maskbitslog2 += 3;
+  else
+    maskbitslog2 += 2;
+  if (64 == pBitClass && maskbitslog2 == 5)
+    maskbitslog2 = 6;
+  return maskbitslog2;
+}
+
+void ExpectSameAsReference(size_t pNumOfSymbols, unsigned int pBitClass)
+{
+  std::vector<uint32_t> hashes = MakeHashes(pNumOfSymbols);
+  uint32_t nbucket = BucketCount(pNumOfSymbols);
+  uint32_t maskbitslog2 = MaskBitsLog2(pNumOfSymbols, pBitClass);
+
+  GNUHashTableBuilder builder(nbucket, maskbitslog2, pBitClass);
+  builder.build(hashes, 3);
+  ReferenceTable reference(hashes, nbucket, maskbitslog2, pBitClass, 3);
+
+  EXPECT_TRUE(reference.order == builder.order());
+  EXPECT_TRUE(reference.buckets == builder.buckets());
+  EXPECT_TRUE(reference.chains == builder.chains());
+  EXPECT_TRUE(reference.bloom == builder.bloom());
+}
+
+} // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+GNUHashTableBuilderTest::GNUHashTableBuilderTest()
+{
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+GNUHashTableBuilderTest::~GNUHashTableBuilderTest()
+{
+}
+
+// SetUp() will be called immediately before each test.
+void GNUHashTableBuilderTest::SetUp()
+{
+}
+
+// TearDown() will be called immediately after each test.
+void GNUHashTableBuilderTest::TearDown()
+{
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F( GNUHashTableBuilderTest, chains) {
+  // bucket 0: empty; bucket 1: 4, 7, 1; bucket 2: 2
+  std::vector<uint32_t> hashes;
+  hashes.push_back(4);
+  hashes.push_back(7);
+  hashes.push_back(2);
+  hashes.push_back(1);
+
+  GNUHashTableBuilder builder(3, 5, 32);
+  builder.build(hashes, 1);
+  ASSERT_EQ(1U, builder.numOfMaskWords());
+
+  ASSERT_EQ(0U, builder.order()[0]);
+  ASSERT_EQ(1U, builder.order()[1]);
+  ASSERT_EQ(3U, builder.order()[2]);
+  ASSERT_EQ(2U, builder.order()[3]);
+
+  ASSERT_EQ(0U, builder.buckets()[0]);
+  ASSERT_EQ(1U, builder.buckets()[1]);
+  ASSERT_EQ(4U, builder.buckets()[2]);
+
+  ASSERT_EQ(4U, builder.chains()[0]);
+  ASSERT_EQ(6U, builder.chains()[1]);
+  ASSERT_EQ(1U, builder.chains()[2]);
+  ASSERT_EQ(3U, builder.chains()[3]);
+}
+
+TEST_F( GNUHashTableBuilderTest, same_as_multimap) {
+  ExpectSameAsReference(1, 32);
+  ExpectSameAsReference(1, 64);
+  ExpectSameAsReference(100, 32);
+  ExpectSameAsReference(1000, 64);
+  ExpectSameAsReference(12345, 64);
+}
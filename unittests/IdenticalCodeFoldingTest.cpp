@@ -0,0 +1,166 @@
+//===- IdenticalCodeFoldingTest.cpp ---------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/LD/IdenticalCodeFolding.h>
+#include <mcld/LD/LDFileFormat.h>
+#include <mcld/LD/LDSection.h>
+#include <mcld/Support/ThreadPool.h>
+#include "IdenticalCodeFoldingTest.h"
+
+#include <llvm/ADT/StringRef.h>
+
+#include <vector>
+
+using namespace mcld;
+using namespace mcld::test;
+
+namespace {
+
+typedef IdenticalCodeFolding::Candidate Candidate;
+
+/// AddCandidate - add a candidate of pContent to pCandidates
+Candidate& AddCandidate(std::vector<Candidate*>& pCandidates,
+                        LDSection& pSection,
+                        llvm::StringRef pContent)
+{
+  Candidate* cand = new Candidate();
+  cand->section = &pSection;
+  cand->content = pContent;
+  cand->hash = 0;
+  cand->keep = false;
+  pCandidates.push_back(cand);
+  return *cand;
+}
+
+/// AddCall - add a relocation from pFrom to the candidate pTo
+void AddCall(Candidate& pFrom, size_t pTo, uint64_t pOffset = 1)
+{
+  IdenticalCodeFolding::Reloc reloc;
+  reloc.offset = pOffset;
+  reloc.type = 4;
+  reloc.addend = (uint64_t)-4;
+  reloc.candidate = pTo;
+  reloc.target = NULL;
+  reloc.targetOffset = 0;
+  pFrom.relocs.push_back(reloc);
+}
+
+} // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+IdenticalCodeFoldingTest::IdenticalCodeFoldingTest()
+{
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+IdenticalCodeFoldingTest::~IdenticalCodeFoldingTest()
+{
+}
+
+// SetUp() will be called immediately before each test.
+void IdenticalCodeFoldingTest::SetUp()
+{
+}
+
+// TearDown() will be called immediately after each test.
+void IdenticalCodeFoldingTest::TearDown()
+{
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F( IdenticalCodeFoldingTest, find_classes) {
+  LDSection* text = LDSection::Create(".text", LDFileFormat::Regular, 1, 6);
+  text->setAlign(16);
+
+  llvm::StringRef ret("\x31\xc0\xc3", 3);
+  llvm::StringRef call("\xe8\x00\x00\x00\x00\xc3", 6);
+  std::vector<Candidate*> cands;
+
+  // 0, 1: the same leaf functions
+  AddCandidate(cands, *text, ret);
+  AddCandidate(cands, *text, ret);
+  // 2, 3: call themselves
+  AddCall(AddCandidate(cands, *text, call), 2);
+  AddCall(AddCandidate(cands, *text, call), 3);
+  // 4, 5: call 0 and 1, which are identical
+  AddCall(AddCandidate(cands, *text, call), 0);
+  AddCall(AddCandidate(cands, *text, call), 1);
+  // 6: calls 2, so it is identical to 2
+  AddCall(AddCandidate(cands, *text, call), 2);
+  // 7: the same as 0, but kept
+  AddCandidate(cands, *text, ret).keep = true;
+  // 8, 9, 10, 11: call each other in pairs
+  AddCall(AddCandidate(cands, *text, call), 9);
+  AddCall(AddCandidate(cands, *text, call), 8);
+  AddCall(AddCandidate(cands, *text, call), 11);
+  AddCall(AddCandidate(cands, *text, call), 10);
+
+  ThreadPool threads(4);
+  std::vector<size_t> classes;
+  IdenticalCodeFolding::findClasses(cands, classes, threads);
+
+  ASSERT_EQ(cands.size(), classes.size());
+  ASSERT_EQ(0U, classes[0]);
+  ASSERT_EQ(0U, classes[1]);
+  ASSERT_EQ(2U, classes[2]);
+  ASSERT_EQ(2U, classes[3]);
+  ASSERT_EQ(4U, classes[4]);
+  ASSERT_EQ(4U, classes[5]);
+  ASSERT_EQ(2U, classes[6]);
+  ASSERT_EQ(7U, classes[7]);
+  // the recursive calls are folded optimistically
+  ASSERT_EQ(2U, classes[8]);
+  ASSERT_EQ(2U, classes[9]);
+  ASSERT_EQ(2U, classes[10]);
+  ASSERT_EQ(2U, classes[11]);
+
+  for (size_t i = 0; i < cands.size(); ++i)
+    delete cands[i];
+  LDSection::Destroy(text);
+}
+
+TEST_F( IdenticalCodeFoldingTest, constant_equal) {
+  LDSection* text = LDSection::Create(".text", LDFileFormat::Regular, 1, 6);
+  LDSection* other = LDSection::Create(".text", LDFileFormat::Regular, 1, 6);
+  other->setAlign(32);
+
+  llvm::StringRef call("\xe8\x00\x00\x00\x00\xc3", 6);
+  std::vector<Candidate*> cands;
+  AddCall(AddCandidate(cands, *text, call), 0);
+  AddCall(AddCandidate(cands, *text, call), 0);
+  ASSERT_TRUE(IdenticalCodeFolding::isConstantEqual(*cands[0], *cands[1]));
+
+  // a different addend
+  AddCall(AddCandidate(cands, *text, call), 0);
+  cands[2]->relocs[0].addend = 0;
+  ASSERT_FALSE(IdenticalCodeFolding::isConstantEqual(*cands[0], *cands[2]));
+
+  // a different alignment
+  AddCall(AddCandidate(cands, *other, call), 0);
+  ASSERT_FALSE(IdenticalCodeFolding::isConstantEqual(*cands[0], *cands[3]));
+
+  // a different symbol out of the candidates
+  int x = 0, y = 0;
+  AddCandidate(cands, *text, call).relocs = cands[0]->relocs;
+  AddCandidate(cands, *text, call).relocs = cands[0]->relocs;
+  cands[4]->relocs[0].candidate = IdenticalCodeFolding::NotCandidate;
+  cands[4]->relocs[0].target = &x;
+  cands[5]->relocs[0].candidate = IdenticalCodeFolding::NotCandidate;
+  cands[5]->relocs[0].target = &y;
+  ASSERT_FALSE(IdenticalCodeFolding::isConstantEqual(*cands[4], *cands[5]));
+  cands[5]->relocs[0].target = &x;
+  ASSERT_TRUE(IdenticalCodeFolding::isConstantEqual(*cands[4], *cands[5]));
+
+  for (size_t i = 0; i < cands.size(); ++i)
+    delete cands[i];
+  LDSection::Destroy(text);
+  LDSection::Destroy(other);
+}
+
@@ -0,0 +1,99 @@
+//===- KeyEntryMapTest.cpp ------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/Target/KeyEntryMap.h>
+#include "KeyEntryMapTest.h"
+
+#include <vector>
+
+using namespace mcld;
+using namespace mcld::test;
+
+namespace {
+
+typedef KeyEntryMap<int, int> IntMap;
+
+/// LinearLookUp - look up pKey by visiting the mappings in order
+const int* LinearLookUp(const IntMap& pMap, const int& pKey)
+{
+  IntMap::const_iterator mapping, mEnd = pMap.end();
+  for (mapping = pMap.begin(); mapping != mEnd; ++mapping) {
+    if (mapping->key == &pKey)
+      return mapping->entry.entry_ptr;
+  }
+  return NULL;
+}
+
+} // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+KeyEntryMapTest::KeyEntryMapTest()
+{
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+KeyEntryMapTest::~KeyEntryMapTest()
+{
+}
+
+// SetUp() will be called immediately before each test.
+void KeyEntryMapTest::SetUp()
+{
+}
+
+// TearDown() will be called immediately after each test.
+void KeyEntryMapTest::TearDown()
+{
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F( KeyEntryMapTest, record_and_look_up) {
+  std::vector<int> keys(1000), entries(2000);
+  IntMap map;
+  ASSERT_TRUE(map.empty());
+  ASSERT_TRUE(NULL == map.lookUp(keys[0]));
+
+  for (size_t i = 0; i < keys.size(); i += 2)
+    map.record(keys[i], entries[i]);
+  for (size_t i = 1; i < keys.size(); i += 2)
+    map.record(keys[i], entries[i], entries[i + 1000]);
+
+  // the mappings are kept in the recorded order
+  ASSERT_EQ(keys.size(), map.size());
+  IntMap::iterator mapping = map.begin();
+  for (size_t i = 0; i < keys.size(); i += 2, ++mapping)
+    ASSERT_EQ(&keys[i], mapping->key);
+
+  for (size_t i = 0; i < keys.size(); i += 2)
+    ASSERT_EQ(&entries[i], map.lookUp(keys[i]));
+  for (size_t i = 1; i < keys.size(); i += 2) {
+    ASSERT_EQ(&entries[i], map.lookUpFirstEntry(keys[i]));
+    ASSERT_EQ(&entries[i + 1000], map.lookUpSecondEntry(keys[i]));
+  }
+
+  int other = 0;
+  ASSERT_TRUE(NULL == map.lookUp(other));
+  ASSERT_TRUE(NULL == map.lookUpFirstEntry(other));
+}
+
+TEST_F( KeyEntryMapTest, first_mapping_wins) {
+  int key1 = 0, key2 = 0;
+  int entry1 = 0, entry2 = 0, entry3 = 0;
+  IntMap map;
+  map.reserve(100);
+  map.record(key1, entry1);
+  map.record(key2, entry2);
+  map.record(key1, entry3);
+
+  ASSERT_EQ(3U, map.size());
+  ASSERT_EQ(&entry1, map.lookUp(key1));
+  ASSERT_EQ(LinearLookUp(map, key1), map.lookUp(key1));
+  ASSERT_EQ(&entry2, map.lookUp(key2));
+}
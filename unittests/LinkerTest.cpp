@@ -20,6 +20,9 @@
 
 #include <llvm/Support/ELF.h>
 
+#include <cstring>
+#include <vector>
+
 using namespace mcld;
 using namespace mcld::test;
 using namespace mcld::sys::fs;
@@ -473,3 +476,55 @@ TEST_F( LinkerTest, plasma_object) {
 
   Finalize();
 }
+
+// Link libplasma.so as the plasma testcase, but emit the output into memory
+// rather than a file.
+TEST_F( LinkerTest, plasma_in_memory) {
+
+  Initialize();
+  Linker linker;
+  LinkerScript script;
+
+  ///< --mtriple="armv7-none-linux-gnueabi"
+  LinkerConfig config("armv7-none-linux-gnueabi");
+
+  /// -L=${TOPDIR}/test/libs/ARM/Android/android-14
+  Path search_dir(TOPDIR);
+  search_dir.append("test/libs/ARM/Android/android-14");
+  script.directories().insert(search_dir);
+
+  linker.emulate(script, config);
+
+  config.setCodeGenType(LinkerConfig::DynObj);  ///< --shared
+  config.options().setSOName("libplasma.so");   ///< --soname=libplasma.so
+
+  Module module("libplasma.so", script);
+  IRBuilder builder(module, config);
+
+  Path crtbegin(search_dir);
+  crtbegin.append("crtbegin_so.o");
+  builder.ReadInput("crtbegin", crtbegin);
+
+  Path plasma(TOPDIR);
+  plasma.append("test/Android/Plasma/ARM/plasma.o");
+  builder.ReadInput("plasma", plasma);
+
+  builder.ReadInput("m");
+  builder.ReadInput("log");
+  builder.ReadInput("jnigraphics");
+  builder.ReadInput("c");
+
+  Path crtend(search_dir);
+  crtend.append("crtend_so.o");
+  builder.ReadInput("crtend", crtend);
+
+  ASSERT_TRUE(linker.link(module, builder));
+
+  // the buffer is resized to the output
+  std::vector<uint8_t> image;
+  ASSERT_TRUE(linker.emit(module, image));
+  ASSERT_EQ(linker.getOutputSize(module), image.size());
+  ASSERT_TRUE(0 == memcmp(&image[0], llvm::ELF::ElfMagic, 4));
+
+  Finalize();
+}
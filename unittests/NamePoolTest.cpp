@@ -175,6 +175,39 @@ TEST_F( NamePoolTest, insert_global_reference_Symbol ) {
 }
 
 
+TEST_F( NamePoolTest, cache_symbol_hash ) {
+  const char *name = "Hello MCLinker";
+  Resolver::Result result;
+  m_pTestee->insertSymbol(name,
+                          false,
+                          ResolveInfo::NoType,
+                          ResolveInfo::Undefined,
+                          ResolveInfo::Global,
+                          0,
+                          0,
+                          ResolveInfo::Default,
+                          NULL,
+                          result);
+
+  hash::StringHash<hash::DJB> hasher;
+  uint32_t hash = hasher(name);
+  EXPECT_EQ(hash, result.info->hash());
+  EXPECT_EQ(hash, m_pTestee->hash(name));
+  EXPECT_EQ(result.info, m_pTestee->findInfo(name, hash));
+  EXPECT_TRUE(NULL == m_pTestee->findInfo("Different Symbol",
+                                          hasher("Different Symbol")));
+
+  ResolveInfo* local = m_pTestee->createSymbol("local",
+                                               false,
+                                               ResolveInfo::NoType,
+                                               ResolveInfo::Define,
+                                               ResolveInfo::Local,
+                                               0,
+                                               ResolveInfo::Default);
+  EXPECT_EQ(hasher("local"), local->hash());
+}
+
+
 TEST_F( NamePoolTest, insertSymbol_after_insert_same_string ) {
   const char *name = "Hello MCLinker";
   bool isDyn = false;
@@ -0,0 +1,122 @@
+//===- SearchDirsTest.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/MC/SearchDirs.h>
+#include <mcld/MC/MCLDDirectory.h>
+#include <mcld/Support/Path.h>
+#include "SearchDirsTest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace mcld;
+using namespace mcld::test;
+
+namespace {
+
+std::vector<std::string> g_Files;
+std::vector<std::string> g_Dirs;
+
+/// CreateDir - create a temporary directory
+std::string CreateDir()
+{
+  char name[] = "/tmp/mcld_search_dirs_XXXXXX";
+  if (NULL == mkdtemp(name))
+    return std::string();
+  g_Dirs.push_back(name);
+  return g_Dirs.back();
+}
+
+/// CreateFile - create an empty file pName in the directory pDir
+void CreateFile(const std::string& pDir, const char* pName)
+{
+  std::string path = pDir + "/" + pName;
+  FILE* file = fopen(path.c_str(), "w");
+  if (NULL != file)
+    fclose(file);
+  g_Files.push_back(path);
+}
+
+} // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+SearchDirsTest::SearchDirsTest()
+{
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+SearchDirsTest::~SearchDirsTest()
+{
+}
+
+// SetUp() will be called immediately before each test.
+void SearchDirsTest::SetUp()
+{
+}
+
+// TearDown() will be called immediately after each test.
+void SearchDirsTest::TearDown()
+{
+  for (size_t i = 0; i < g_Files.size(); ++i)
+    unlink(g_Files[i].c_str());
+  for (size_t i = 0; i < g_Dirs.size(); ++i)
+    rmdir(g_Dirs[i].c_str());
+  g_Files.clear();
+  g_Dirs.clear();
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F( SearchDirsTest, find_in_order) {
+  std::string dir1 = CreateDir();
+  std::string dir2 = CreateDir();
+  ASSERT_FALSE(dir1.empty());
+  ASSERT_FALSE(dir2.empty());
+  CreateFile(dir1, "libfoo.so");
+  CreateFile(dir1, "libfoo.a");
+  CreateFile(dir1, "libbar.a");
+  CreateFile(dir1, "libbaz.so.1");
+  CreateFile(dir2, "libbar.so");
+  CreateFile(dir2, "libqux.so");
+  CreateFile(dir2, "link.x");
+
+  SearchDirs dirs;
+  ASSERT_TRUE(dirs.insert(dir1));
+  ASSERT_TRUE(dirs.insert(dir2));
+
+  sys::fs::Path* path = dirs.find("foo", Input::DynObj);
+  ASSERT_TRUE(NULL != path);
+  ASSERT_EQ(dir1 + "/libfoo.so", path->native());
+
+  path = dirs.find("foo", Input::Archive);
+  ASSERT_TRUE(NULL != path);
+  ASSERT_EQ(dir1 + "/libfoo.a", path->native());
+
+  // a directory is searched for both kinds before the next one
+  path = dirs.find("bar", Input::DynObj);
+  ASSERT_TRUE(NULL != path);
+  ASSERT_EQ(dir1 + "/libbar.a", path->native());
+
+  path = dirs.find("qux", Input::DynObj);
+  ASSERT_TRUE(NULL != path);
+  ASSERT_EQ(dir2 + "/libqux.so", path->native());
+
+  const SearchDirs& const_dirs = dirs;
+  const sys::fs::Path* const_path = const_dirs.find("link.x", Input::Script);
+  ASSERT_TRUE(NULL != const_path);
+  ASSERT_EQ(dir2 + "/link.x", const_path->native());
+
+  ASSERT_TRUE(NULL == dirs.find("qux", Input::Archive));
+  ASSERT_TRUE(NULL == dirs.find("baz", Input::DynObj));
+  ASSERT_TRUE(NULL == dirs.find("libfoo", Input::Script));
+}
@@ -11,10 +11,32 @@
 #include <mcld/LD/SectionData.h>
 #include <mcld/LD/LDFileFormat.h>
 #include <mcld/LD/LDSection.h>
+#include <mcld/Fragment/FillFragment.h>
+#include <mcld/Fragment/FragmentRef.h>
+
 
 using namespace mcld;
 using namespace mcldtest;
 
+namespace {
+
+/// CreateFragments - append pNum fill fragments of pseudo-random sizes, some
+/// of which are empty. Return the size of the section.
+uint64_t CreateFragments(SectionData& pSD, size_t pNum)
+{
+  uint64_t size = 0;
+  uint32_t seed = 4321;
+  for (size_t i = 0; i < pNum; ++i) {
+    seed = seed * 1103515245u + 12345u;
+    uint64_t frag_size = (0 == (seed >> 28) % 8) ? 0 : ((seed >> 16) % 64);
+    new FillFragment(0x0, 1, frag_size, &pSD);
+    size += frag_size;
+  }
+  return size;
+}
+
+} // anonymous namespace
+
 
 // Constructor can do set-up work for all test here.
 SectionDataTest::SectionDataTest()
@@ -79,3 +101,71 @@ TEST_F( SectionDataTest, Fragment_list_and_iterator ) {
 
   LDSection::Destroy(test);
 }
+
+TEST_F( SectionDataTest, find_fragment ) {
+  LDSection* test = LDSection::Create("test", LDFileFormat::Regular, 0, 0);
+  SectionData* s = SectionData::Create(*test);
+  test->setSectionData(s);
+  uint64_t size = CreateFragments(*s, 1000);
+
+  // the same as walking from the front
+  for (uint64_t offset = 0; offset <= size + 1; ++offset) {
+    FragmentRef* expected = FragmentRef::Create(s->front(), offset);
+    FragmentRef* result = FragmentRef::Create(*test, offset);
+    ASSERT_EQ(expected->frag(), result->frag());
+    ASSERT_EQ(expected->offset(), result->offset());
+  }
+
+  // fragments appended and inserted after the index is built
+  new FillFragment(0x0, 1, 16, s);
+  s->getFragmentList().insert(s->begin(), new FillFragment(0x0, 1, 8));
+  SectionData::iterator middle = s->begin();
+  for (int i = 0; i < 500; ++i)
+    ++middle;
+  s->getFragmentList().insert(middle, new FillFragment(0x0, 1, 4));
+  size += 28;
+  for (uint64_t offset = 0; offset <= size + 1; ++offset) {
+    FragmentRef* expected = FragmentRef::Create(s->front(), offset);
+    FragmentRef* result = FragmentRef::Create(*test, offset);
+    ASSERT_EQ(expected->frag(), result->frag());
+    ASSERT_EQ(expected->offset(), result->offset());
+  }
+
+  LDSection::Destroy(test);
+}
+
+TEST_F( SectionDataTest, find_fragment_after_change ) {
+  LDSection* test = LDSection::Create("test", LDFileFormat::Regular, 0, 0);
+  SectionData* s = SectionData::Create(*test);
+  test->setSectionData(s);
+
+  // A..E of 10 bytes each
+  Fragment* frags[5];
+  for (int i = 0; i < 5; ++i)
+    frags[i] = new FillFragment(0x0, 1, 10, s);
+
+  uint64_t offset = 0;
+  ASSERT_TRUE(frags[4] == s->findFragment(45, offset));
+  ASSERT_EQ(5U, offset);
+
+  // insert X of 4 bytes between B and C, the first and the last fragments
+  // are kept
+  SectionData::iterator c = s->begin();
+  ++c;
+  ++c;
+  Fragment* x = new FillFragment(0x0, 1, 4);
+  s->getFragmentList().insert(c, x);
+  ASSERT_TRUE(frags[4] == s->findFragment(45, offset));
+  ASSERT_EQ(1U, offset);
+  ASSERT_TRUE(x == s->findFragment(22, offset));
+  ASSERT_EQ(2U, offset);
+
+  // remove C
+  s->getFragmentList().erase(frags[2]);
+  ASSERT_TRUE(frags[4] == s->findFragment(35, offset));
+  ASSERT_EQ(1U, offset);
+  ASSERT_TRUE(frags[3] == s->findFragment(30, offset));
+  ASSERT_EQ(6U, offset);
+
+  LDSection::Destroy(test);
+}
@@ -0,0 +1,126 @@
+//===- SectionMapTest.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/Object/SectionMap.h>
+#include <mcld/Script/StringList.h>
+#include <mcld/Script/WildcardPattern.h>
+#include "SectionMapTest.h"
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
+
+#include <fnmatch.h>
+#include <string>
+#include <vector>
+
+using namespace mcld;
+using namespace mcld::test;
+
+namespace {
+
+/// LinearFind - the first matching input section description, found by
+/// visiting all descriptions
+SectionMap::const_mapping LinearFind(const SectionMap& pMap,
+                                     const std::string& pSection)
+{
+  SectionMap::const_iterator out, outEnd = pMap.end();
+  for (out = pMap.begin(); out != outEnd; ++out) {
+    SectionMap::Output::const_iterator in, inEnd = (*out)->end();
+    for (in = (*out)->begin(); in != inEnd; ++in) {
+      const StringList& sections = (*in)->spec().sections();
+      StringList::const_iterator sect, sectEnd = sections.end();
+      for (sect = sections.begin(); sect != sectEnd; ++sect) {
+        const WildcardPattern* pattern = llvm::cast<WildcardPattern>(*sect);
+        const char* name = pSection.c_str();
+        bool matched = false;
+        if (pattern->isPrefix())
+          matched = llvm::StringRef(name).startswith(pattern->prefix());
+        else
+          matched = (0 == fnmatch(pattern->name().c_str(), name, 0));
+        if (matched)
+          return std::make_pair(*out, *in);
+      }
+    }
+  }
+  return std::make_pair((const SectionMap::Output*)NULL,
+                        (const SectionMap::Input*)NULL);
+}
+
+} // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+SectionMapTest::SectionMapTest()
+{
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+SectionMapTest::~SectionMapTest()
+{
+}
+
+// SetUp() will be called immediately before each test.
+void SectionMapTest::SetUp()
+{
+}
+
+// TearDown() will be called immediately after each test.
+void SectionMapTest::TearDown()
+{
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F( SectionMapTest, first_match) {
+  SectionMap map;
+  map.insert(".text.hot", ".text.hot");
+  map.insert(".data.rel.ro*", ".data.rel.ro");
+  map.insert(".text", ".text");
+  map.insert(".text.*", ".text");
+  map.insert(".t?xt.cold", ".cold");
+  map.insert(".rodata*", ".rodata");
+  map.insert(".data.*", ".data");
+  map.insert("*.foo", ".foo");
+  map.insert(".init_array.[0-9]*", ".init_array");
+  map.insert("", "");
+
+  const char* names[] = {
+    ".text", ".text.hot", ".text.cold", ".text.hot.a", ".txt.cold",
+    ".tExt.cold", ".data.rel.ro", ".data.rel.ro.local", ".data.x",
+    ".rodata", ".rodata.str1.1", ".bar.foo", ".foo", ".init_array.[0-9]1",
+    ".init_array.1", "", ".bss", ".tex"
+  };
+  const size_t num = sizeof(names) / sizeof(names[0]);
+
+  // twice, the second time from the cache
+  for (int pass = 0; pass < 2; ++pass) {
+    for (size_t i = 0; i < num; ++i) {
+      SectionMap::const_mapping expected = LinearFind(map, names[i]);
+      SectionMap::const_mapping result =
+        static_cast<const SectionMap&>(map).find("a.o", names[i]);
+      ASSERT_EQ(expected.first, result.first) << names[i];
+      ASSERT_EQ(expected.second, result.second) << names[i];
+    }
+  }
+
+  ASSERT_EQ(".text", map.find("a.o", ".text.cold").first->name());
+  ASSERT_EQ(".cold", map.find("a.o", ".tExt.cold").first->name());
+  ASSERT_TRUE(NULL == map.find("a.o", ".bss").first);
+}
+
+TEST_F( SectionMapTest, insert_after_find) {
+  SectionMap map;
+  map.insert(".text", ".text");
+  ASSERT_TRUE(NULL == map.find("a.o", ".bss").first);
+
+  // the cached result is dropped
+  map.insert(".bss*", ".bss");
+  ASSERT_TRUE(NULL != map.find("a.o", ".bss").first);
+  ASSERT_EQ(".bss", map.find("a.o", ".bss.x").first->name());
+  ASSERT_EQ(".text", map.find("a.o", ".text").first->name());
+}
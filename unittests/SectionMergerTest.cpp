@@ -0,0 +1,130 @@
+//===- SectionMergerTest.cpp ----------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/LD/SectionMerger.h>
+#include <mcld/Fragment/MergedFragment.h>
+#include "SectionMergerTest.h"
+
+#include <llvm/ADT/StringRef.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace mcld;
+using namespace mcld::test;
+
+namespace {
+
+/// Emit - the content of pFrag
+std::string Emit(const MergedFragment& pFrag)
+{
+  std::vector<uint8_t> buffer(pFrag.size(), 0xff);
+  pFrag.emit(&buffer[0]);
+  return std::string(buffer.begin(), buffer.end());
+}
+
+} // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+SectionMergerTest::SectionMergerTest()
+{
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+SectionMergerTest::~SectionMergerTest()
+{
+}
+
+// SetUp() will be called immediately before each test.
+void SectionMergerTest::SetUp()
+{
+}
+
+// TearDown() will be called immediately after each test.
+void SectionMergerTest::TearDown()
+{
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F( SectionMergerTest, split_strings) {
+  const char content[] = "foo\0\0bar\0foo";
+  SectionMerger::PieceList pieces;
+  ASSERT_TRUE(SectionMerger::splitPieces(llvm::StringRef(content, 13), 1,
+                                         true, pieces));
+  ASSERT_EQ(4U, pieces.size());
+  ASSERT_TRUE(llvm::StringRef("foo\0", 4) == pieces[0].data);
+  ASSERT_TRUE(llvm::StringRef("\0", 1) == pieces[1].data);
+  ASSERT_TRUE(llvm::StringRef("bar\0", 4) == pieces[2].data);
+  ASSERT_EQ(5U, pieces[2].inOffset);
+  ASSERT_EQ(9U, pieces[3].inOffset);
+
+  // an unterminated string
+  pieces.clear();
+  ASSERT_FALSE(SectionMerger::splitPieces(llvm::StringRef(content, 12), 1,
+                                          true, pieces));
+
+  // the strings of wide characters end with an entry of zeros
+  const char wide[] = "a\0b\0\0\0c\0\0\0";
+  pieces.clear();
+  ASSERT_TRUE(SectionMerger::splitPieces(llvm::StringRef(wide, 10), 2,
+                                         true, pieces));
+  ASSERT_EQ(2U, pieces.size());
+  ASSERT_EQ(6U, pieces[0].data.size());
+  ASSERT_EQ(6U, pieces[1].inOffset);
+}
+
+TEST_F( SectionMergerTest, split_constants) {
+  const char content[] = "0123456789abcdef";
+  SectionMerger::PieceList pieces;
+  ASSERT_TRUE(SectionMerger::splitPieces(llvm::StringRef(content, 16), 4,
+                                         false, pieces));
+  ASSERT_EQ(4U, pieces.size());
+  ASSERT_TRUE(llvm::StringRef("89ab") == pieces[2].data);
+  ASSERT_EQ(12U, pieces[3].inOffset);
+
+  // the size must be a multiple of the entry size
+  pieces.clear();
+  ASSERT_FALSE(SectionMerger::splitPieces(llvm::StringRef(content, 14), 4,
+                                          false, pieces));
+}
+
+TEST_F( SectionMergerTest, output_offset) {
+  const char content[] = "foo\0bar\0baz";
+  SectionMerger::PieceList pieces;
+  ASSERT_TRUE(SectionMerger::splitPieces(llvm::StringRef(content, 12), 1,
+                                         true, pieces));
+  pieces[0].outOffset = 8;
+  pieces[1].outOffset = 0;
+  pieces[2].outOffset = 4;
+
+  ASSERT_EQ(8U, SectionMerger::getOutputOffset(pieces, 0));
+  ASSERT_EQ(10U, SectionMerger::getOutputOffset(pieces, 2));
+  ASSERT_EQ(0U, SectionMerger::getOutputOffset(pieces, 4));
+  ASSERT_EQ(3U, SectionMerger::getOutputOffset(pieces, 7));
+  ASSERT_EQ(6U, SectionMerger::getOutputOffset(pieces, 10));
+  // the end of the section
+  ASSERT_EQ(8U, SectionMerger::getOutputOffset(pieces, 12));
+}
+
+TEST_F( SectionMergerTest, merged_fragment) {
+  MergedFragment frag;
+  ASSERT_EQ(0U, frag.size());
+  frag.append(llvm::StringRef("abc\0", 4), 0);
+  frag.append(llvm::StringRef("de\0", 3), 8);
+  ASSERT_EQ(2U, frag.numOfPieces());
+  ASSERT_EQ(11U, frag.size());
+  ASSERT_TRUE(Fragment::Merged == frag.getKind());
+
+  // the gap is filled with zeros
+  std::string expected("abc\0\0\0\0\0de\0", 11);
+  ASSERT_EQ(expected, Emit(frag));
+}
+
@@ -0,0 +1,130 @@
+//===- StringTableBuilderTest.cpp -----------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/LD/StringTableBuilder.h>
+#include "StringTableBuilderTest.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace mcld;
+using namespace mcld::test;
+
+namespace {
+
+/// StringAt - get the null-terminated string at pOffset of an emitted table
+llvm::StringRef StringAt(const std::vector<char>& pTable, size_t pOffset)
+{
+  return llvm::StringRef(&pTable[pOffset]);
+}
+
+} // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+StringTableBuilderTest::StringTableBuilderTest()
+{
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+StringTableBuilderTest::~StringTableBuilderTest()
+{
+}
+
+// SetUp() will be called immediately before each test.
+void StringTableBuilderTest::SetUp()
+{
+}
+
+// TearDown() will be called immediately after each test.
+void StringTableBuilderTest::TearDown()
+{
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F( StringTableBuilderTest, empty_table) {
+  StringTableBuilder builder;
+  builder.add("");
+  builder.finalize();
+  ASSERT_EQ(1U, builder.size());
+  ASSERT_EQ(0U, builder.getOffset(""));
+  ASSERT_EQ(StringTableBuilder::NotFound, builder.getOffset("foo"));
+
+  std::vector<char> table(builder.size(), 'x');
+  builder.emit(&table[0]);
+  ASSERT_EQ('\0', table[0]);
+}
+
+TEST_F( StringTableBuilderTest, deduplicate) {
+  StringTableBuilder builder;
+  std::string foo1("foo");
+  std::string foo2("foo");
+  builder.add(foo1);
+  builder.add("bar");
+  builder.add(foo2);
+  builder.finalize();
+
+  // "\0foo\0bar\0" in some order
+  ASSERT_EQ(9U, builder.size());
+  ASSERT_NE(builder.getOffset("foo"), builder.getOffset("bar"));
+
+  std::vector<char> table(builder.size());
+  builder.emit(&table[0]);
+  ASSERT_TRUE(StringAt(table, builder.getOffset("foo")) == "foo");
+  ASSERT_TRUE(StringAt(table, builder.getOffset("bar")) == "bar");
+}
+
+TEST_F( StringTableBuilderTest, tail_merge) {
+  StringTableBuilder builder;
+  builder.add("ar");
+  builder.add("_ZN4mcld3fooEv");
+  builder.add("bar");
+  builder.add("foobar");
+  builder.add("3fooEv");
+  builder.add("xbar");
+  builder.add("r");
+  builder.finalize();
+
+  // only "_ZN4mcld3fooEv", "foobar" and "xbar" are stored
+  ASSERT_EQ(1U + 15U + 7U + 5U, builder.size());
+  ASSERT_EQ(builder.getOffset("foobar") + 3, builder.getOffset("bar"));
+  ASSERT_EQ(builder.getOffset("foobar") + 4, builder.getOffset("ar"));
+  ASSERT_EQ(builder.getOffset("foobar") + 5, builder.getOffset("r"));
+  ASSERT_EQ(builder.getOffset("_ZN4mcld3fooEv") + 8,
+            builder.getOffset("3fooEv"));
+
+  std::vector<char> table(builder.size());
+  builder.emit(&table[0]);
+  const char* strings[] = { "ar", "_ZN4mcld3fooEv", "bar", "foobar", "3fooEv",
+                            "xbar", "r" };
+  for (size_t i = 0; i < sizeof(strings) / sizeof(strings[0]); ++i)
+    ASSERT_TRUE(StringAt(table, builder.getOffset(strings[i])) == strings[i]);
+}
+
+TEST_F( StringTableBuilderTest, copy_and_clear) {
+  StringTableBuilder builder;
+  {
+    std::string rpath("/lib:/usr/lib");
+    builder.addCopy(rpath);
+  }
+  builder.finalize();
+  ASSERT_EQ(15U, builder.size());
+
+  std::vector<char> table(builder.size());
+  builder.emit(&table[0]);
+  ASSERT_TRUE(StringAt(table, builder.getOffset("/lib:/usr/lib")) ==
+              "/lib:/usr/lib");
+
+  builder.clear();
+  ASSERT_FALSE(builder.isFinalized());
+  builder.add("lib");
+  builder.finalize();
+  ASSERT_EQ(5U, builder.size());
+  ASSERT_EQ(1U, builder.getOffset("lib"));
+}
@@ -9,7 +9,10 @@
 #include <mcld/MC/SymbolCategory.h>
 #include <mcld/LD/ResolveInfo.h>
 #include <mcld/LD/LDSymbol.h>
+#include <algorithm>
 #include <iostream>
+#include <set>
+#include <vector>
 #include "SymbolCategoryTest.h"
 
 using namespace std;
@@ -142,3 +145,28 @@ TEST_F(SymbolCategoryTest, change_local_to_dynamic) {
   ++sym;
   ASSERT_STREQ("e", (*sym)->name());
 }
+
+TEST_F(SymbolCategoryTest, change_many_to_dynamic) {
+  const size_t num = 2000;
+  std::vector<LDSymbol*> syms(num);
+  for (size_t i = 0; i < num; ++i) {
+    ResolveInfo* info = ResolveInfo::Create("x");
+    info->setBinding(0 == i % 3 ? ResolveInfo::Local : ResolveInfo::Global);
+    syms[i] = LDSymbol::Create(*info);
+    info->setSymPtr(syms[i]);
+    m_pTestee->add(*syms[i]);
+  }
+
+  // reorder the locals from outside, the recorded positions become stale
+  std::reverse(m_pTestee->localBegin(), m_pTestee->localEnd());
+
+  for (size_t i = 0; i < num; i += 2)
+    m_pTestee->changeToDynamic(*syms[i]);
+
+  ASSERT_TRUE(num / 2 == m_pTestee->numOfLocalDyns());
+  ASSERT_TRUE(num == m_pTestee->numOfSymbols());
+  std::set<const LDSymbol*> local_dyns(m_pTestee->localDynBegin(),
+                                       m_pTestee->localDynEnd());
+  for (size_t i = 0; i < num; ++i)
+    ASSERT_TRUE((0 == i % 2) == (0 != local_dyns.count(syms[i])));
+}
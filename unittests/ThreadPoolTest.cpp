@@ -0,0 +1,109 @@
+//===- ThreadPoolTest.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <mcld/Support/ThreadPool.h>
+#include "ThreadPoolTest.h"
+
+#include <vector>
+
+using namespace mcld;
+using namespace mcld::test;
+
+namespace {
+
+/// SumJob - sum up a range of integers into its own slot
+class SumJob : public ThreadPool::Job
+{
+public:
+  SumJob() : m_Begin(0), m_End(0), m_Sum(0) { }
+
+  SumJob(unsigned int pBegin, unsigned int pEnd)
+    : m_Begin(pBegin), m_End(pEnd), m_Sum(0) {
+  }
+
+  void run() {
+    for (unsigned int i = m_Begin; i < m_End; ++i)
+      m_Sum += i;
+  }
+
+  unsigned int sum() const { return m_Sum; }
+
+private:
+  unsigned int m_Begin;
+  unsigned int m_End;
+  unsigned int m_Sum;
+};
+
+unsigned int RunSumJobs(ThreadPool& pPool, unsigned int pNumOfJobs)
+{
+  std::vector<SumJob> jobs;
+  for (unsigned int i = 0; i < pNumOfJobs; ++i)
+    jobs.push_back(SumJob(i * 100, (i + 1) * 100));
+
+  ThreadPool::JobList job_list;
+  for (unsigned int i = 0; i < pNumOfJobs; ++i)
+    job_list.push_back(&jobs[i]);
+  pPool.run(job_list);
+
+  unsigned int sum = 0;
+  for (unsigned int i = 0; i < pNumOfJobs; ++i)
+    sum += jobs[i].sum();
+  return sum;
+}
+
+} // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+ThreadPoolTest::ThreadPoolTest()
+{
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+ThreadPoolTest::~ThreadPoolTest()
+{
+}
+
+// SetUp() will be called immediately before each test.
+void ThreadPoolTest::SetUp()
+{
+}
+
+// TearDown() will be called immediately after each test.
+void ThreadPoolTest::TearDown()
+{
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F( ThreadPoolTest, serial) {
+  ThreadPool pool(1);
+  ASSERT_EQ(1U, pool.size());
+  ASSERT_FALSE(pool.isParallel());
+  ASSERT_EQ(4950U, RunSumJobs(pool, 1));
+  ASSERT_EQ(49995000U, RunSumJobs(pool, 100));
+}
+
+TEST_F( ThreadPoolTest, number_of_processors) {
+  ThreadPool pool(0);
+  ASSERT_TRUE(pool.size() >= 1);
+  ASSERT_TRUE(pool.size() <= ThreadPool::GetNumOfProcessors());
+}
+
+TEST_F( ThreadPoolTest, parallel) {
+  ThreadPool pool(4);
+  ASSERT_TRUE(pool.size() >= 1);
+
+  // empty batch
+  ASSERT_EQ(0U, RunSumJobs(pool, 0));
+
+  // a pool can run many batches
+  for (unsigned int i = 0; i < 10; ++i)
+    ASSERT_EQ(49995000U, RunSumJobs(pool, 100));
+}
+
@@ -0,0 +1,37 @@
+//===- ThreadPoolTest.h ---------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_UNITTEST_THREAD_POOL_TEST_H
+#define MCLD_UNITTEST_THREAD_POOL_TEST_H
+
+#include <gtest.h>
+
+namespace mcld {
+namespace test {
+
+class ThreadPoolTest : public ::testing::Test
+{
+public:
+  // Constructor can do set-up work for all test here.
+  ThreadPoolTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~ThreadPoolTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+};
+
+} // namespace of test
+} // namespace of mcld
+
+#endif
+